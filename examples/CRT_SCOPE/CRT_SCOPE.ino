@@ -169,6 +169,9 @@ void setup() {
 	
 	Timer3.attachInterrupt(paintCrt_ISR);
 
+	//Timer7 and pin 3 (crtBlankingPin) are also taken by XYscope.begin( ): Timer7 times the CRT
+	//blanking edges on pin 3.  Do not use Timer7 or write pin 3 anywhere else in the sketch.
+
 	//Here is just some stuff to paint onto CRT at startup
 	//v----------BEGIN SETUP SPLASH SCREEN ---------------v
 	ArduinoSplash();				//Paint an Arduino logo
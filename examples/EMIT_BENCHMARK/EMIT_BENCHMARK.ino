@@ -0,0 +1,136 @@
+char startMsg[] = "EMIT_BENCHMARK (Ver_1.00) ";	//Program Revision Text
+
+/*
+ EMIT_BENCHMARK.ino
+
+ Points-per-second benchmark of the XYscope plot routines (plotLine, plotCircle, plotEllipse, print)
+ against the compile-time specialized emitters of XYscopeEmit.h drawing the same scene.
+
+ Results are sent to the Serial monitor (115200 baud) once at startup; the emitted scene is then left
+ on the CRT.  Send any character to run the benchmark again.
+
+ 20261017 Ver  1.00					First cut
+ */
+
+#include <Arduino.h>	//Provided as part of the Arduino IDE
+
+#include <DueTimer.h>	//Timer library for DUE; download this library from the Arduino.org site
+						//Timer library is also available from author at https://github.com/ivanseidel/DueTimer
+
+#include <XYscope.h>
+#include <XYscopeEmit.h>
+
+XYscopeSized<8000> XYscope;		//Leave RAM for the trace sink buffer below
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();	//Link the AVR DAC ISR/IRQ to the XYscope.
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();	//Start the DMA transfer to paint the CRT screen
+}
+
+const int Frames = 10;		//Scenes drawn per measurement
+
+void sceneWithPlotRoutines(void) {
+	//	Test scene: 8 lines, 4 circles, 3 ellipses and a line of text, using the run-time plot routines
+	for (int i = 0; i < 8; i++)
+		XYscope.plotLine(100 + i * 450, 100, 4000 - i * 450, 3900);
+	for (int r = 100; r < 2000; r += 600)
+		XYscope.plotCircle(2047, 2047, r);
+	for (int r = 100; r < 1500; r += 500)
+		XYscope.plotEllipse(2047, 2047, r + 400, r, 0xff);
+	XYscope.printSetup(100, 3700, 150, 100);
+	XYscope.print((char *) "HELLO WORLD 0123456789", false);
+}
+
+template<class Emitter>
+void sceneWithEmitter(Emitter &draw) {
+	//	Same scene, using an emitter
+	for (int i = 0; i < 8; i++)
+		draw.line(100 + i * 450, 100, 4000 - i * 450, 3900);
+	for (int r = 100; r < 2000; r += 600)
+		draw.circle(2047, 2047, r);
+	for (int r = 100; r < 1500; r += 500)
+		draw.ellipse(2047, 2047, r + 400, r, 0xff);
+	int x = 100, y = 3700, ht = 150;
+	draw.text(XYscope, "HELLO WORLD 0123456789", x, y, ht);
+}
+
+void report(const char *name, uint32_t points, uint32_t us) {
+	Serial.print(name);
+	Serial.print(points / Frames);
+	Serial.print(" points/scene, ");
+	Serial.print(us / Frames);
+	Serial.print(" us/scene, ");
+	Serial.print(uint32_t(uint64_t(points) * 1000000 / (us ? us : 1)));
+	Serial.println(" points/s");
+}
+
+XYscope::pointList trace[8000];		//Output of the trace sink
+
+void runBenchmark(void) {
+	uint32_t points = 0, t;
+
+	//1) Run-time plot routines
+	XYscope.setGraphicsIntensity(100);
+	t = micros();
+	for (int f = 0; f < Frames; f++) {
+		XYscope.plotStart();
+		sceneWithPlotRoutines();
+		points += XYscope.XYlistEnd;
+	}
+	report("plot routines:                      ", points, micros() - t);
+
+	//2) Emitter: display list sink, no clipping, no transform, density fixed at compile time
+	points = 0;
+	t = micros();
+	for (int f = 0; f < Frames; f++) {
+		XYscope.plotStart();
+		XYemit::listSink out(XYscope);
+		XYemit::emitter<XYemit::listSink, XYemit::noClip, XYemit::identity, XYemit::fixedDensity<10> > draw(out);
+		sceneWithEmitter(draw);
+		out.flush();
+		points += XYscope.XYlistEnd;
+	}
+	report("emitter (list, fixed density):      ", points, micros() - t);
+
+	//3) Emitter: trace sink, clipping and translation on, run-time density
+	points = 0;
+	t = micros();
+	for (int f = 0; f < Frames; f++) {
+		XYemit::traceSink out(trace, 8000);
+		XYemit::emitter<XYemit::traceSink, XYemit::clipScreen, XYemit::translate> draw(out,
+				XYemit::translate(0, 0), XYemit::runtimeDensity(10));
+		sceneWithEmitter(draw);
+		points += out.points;
+	}
+	report("emitter (trace, clip+translate):    ", points, micros() - t);
+
+	//Leave the emitted scene on screen
+	XYscope.plotStart();
+	XYemit::listSink out(XYscope);
+	XYemit::emitter<XYemit::listSink, XYemit::noClip, XYemit::identity, XYemit::fixedDensity<10> > draw(out);
+	sceneWithEmitter(draw);
+	out.flush();
+	XYscope.autoSetRefreshTime();
+}
+
+void setup() {
+	Serial.begin(115200);
+	Serial.println("");
+	Serial.println(startMsg);
+
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+
+	runBenchmark();
+}
+
+void loop() {
+	if (Serial.available() > 0) {
+		while (Serial.available() > 0)
+			Serial.read();
+		runBenchmark();
+	}
+}
@@ -1,15 +1,102 @@
 #include "XYscope.h"
 
-#include <DueTimer.h>
+#include "XYscopeHal.h"
 
 uint8_t TimerBlinkState = 0;
 
 //#include "XYscopeVectorFont.cpp"
 
-XYscope::XYscope() {
+//Library default XY list.  Only referenced by the default constructor, so it is dropped by the linker when
+//the sketch supplies its own buffer (XYscopeSized<N> or XYscope(list, listSize)).
+static XYscope::pointList defaultXY_List[XYscope::MaxArraySize];
+
+//Staging buffers for points generated at refresh time (display program, packed list, interlaced field); also
+//the filler block while streaming.  Only referenced by setDisplayProgram(), setPackedList(), setInterlace() and
+//streamBegin(), so sketches that use none of them do not pay for them.
+static XYscope::pointList stageBuffers[2 * XYscope::StagePoints];
+
+XYscope::XYscope() : XY_List(defaultXY_List), XY_ListCapacity(MaxArraySize) {
+	init();
+}
+
+XYscope::XYscope(pointList *list, uint32_t listSize) : XY_List(list), XY_ListCapacity(listSize) {
+	//	Constructor for a caller supplied XY list buffer
+	//
+	//	Calling parameters:
+	//		list		Buffer that will hold the XY_List
+	//		listSize	Number of points in 'list'.  MaxBuffSize is set to this value.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	MaxBuffSize = listSize;
+	init();
+}
+
+void XYscope::init(void) {
 	//Initialize variables used in these routines
 
 	XYlistEnd = 0;
+	_plotList = _dmaList = XY_List;
+	_plotListSize = XY_ListCapacity;
+	_bgList = NULL;
+	_bgPoints = 0;
+	_dynList = XY_List;
+	_dynCapacity = XY_ListCapacity;
+	_dmaBlockCount = 0;
+	_dmaBlockNext = 0;
+	_dmaUnitsPerPoint = 2;
+	for (int i = 0; i < MaxStaticLists; i++)
+		_staticList[i].points = 0;
+	_staticPoints = 0;
+	_chunkCount = 0;
+	_chunkPoints = 0;
+	_program = NULL;
+	_stage = NULL;
+	_stageNext = 0;
+	_streamSource = streamNone;
+	_genLastPoints = 0;
+	_packStore = NULL;
+	packReset();
+	_ringList = NULL;
+	_streamCallback = NULL;
+	_ringLowMark = 0;
+	_ringHighMark = 32767;
+	_ringUnderruns = 0;
+	_cmdQueue = NULL;
+	_cmdCount = 0;
+	_cmdDone = 0;
+	_cmdSuspend = 0;
+	setPlotLimit();
+	_dmaListEnd = 0;
+	_swapPending = false;
+	_doubleBuffer = false;
+	_frameCount = 0;
+	_frameCallback = NULL;
+	_eventRefresh = false;
+	_refreshPending = false;
+	_ringDrain_us = 0;
+	_interlace = 1;
+	_fields = 1;
+	_fldCount = 1;
+	_field = 0;
+	_lodEnable = false;
+	_lodTarget_us = CrtMinRefresh_ms * 1000;
+	_lodLevel = 100;
+	_listFull = false;
+	_backToBack = false;
+	_editSeq = 0;
+	_editDepth = 0;
+	_deferredRefreshes = 0;
+	_segmentCount = 0;
+	_activeSegment = -1;
+	_sceneCount = 0;
+	_pool = NULL;
+	_poolSize = 0;
+	_poolHead = -1;
+	for (int i = 0; i < MaxObjects; i++)
+		_object[i] = -1;
+	_poolPoints = 0;
+	_activeObject = -1;
 	pinMode(crtBlankingPin, OUTPUT);
 
 }
@@ -32,7 +119,7 @@ float XYscope::getLibRev(void){
 
 	// Here's where we define Major and Minor Rev Levels; Reset these values whenver a lib rev is completed.
 	_libMajorRev=1.;			//Bump MAJOR value wherever incompatible API changes are made
-	_libMinorRev=.0;			//Bump MINOR value whenever functionality is added (in a backwards compatible fashion occurs)
+	_libMinorRev=.25;			//Bump MINOR value whenever functionality is added (in a backwards compatible fashion occurs)
 	_libPatchRev=0;			//NOT USED (LibPatchRev not used in this application)
 	_libRev = _libMajorRev + _libMinorRev +.005;	//Bias up by .005 to improve float to text conversion
 	return _libRev;		//Combine and return the composite value.
@@ -57,6 +144,7 @@ void XYscope::setGraphicsIntensity(short GraphBright) {
 	//				Nothing.
 	//
 	//	20170811 Ver 0.0	E.Andrews	First cut
+	//	20261017 Ver 0.1				Density follows the level of detail (see setLodControl)
 
 	long InputMin, InputMax, OutputMin, OutputMax;
 	//Use linear mapping functions for brightness conversion
@@ -83,8 +171,8 @@ void XYscope::setGraphicsIntensity(short GraphBright) {
 		//Save updated GraphBright to class variable
 		_graphBrightness = GraphBright;
 		//Calculate new graphDensity based on 'GraphBright' value
-		_graphDensity = (GraphBright - InputMin) * (OutputMax - OutputMin)
-				/ (InputMax - InputMin) + OutputMin;
+		_graphDensity = lodDensity((GraphBright - InputMin) * (OutputMax - OutputMin)
+				/ (InputMax - InputMin) + OutputMin);
 
 	}//If user passes us a NEGATIVE or OVER_RANGE value, just go to the graphics density setting
 
@@ -125,6 +213,7 @@ void XYscope::setTextIntensity(short TextBright) {
 	//				Nothing.
 	//
 	//	20170811 Ver 0.0	E.Andrews	First cut
+	//	20261017 Ver 0.1				Density follows the level of detail (see setLodControl)
 
 	long InputMin, InputMax, OutputMin, OutputMax;
 	//Use linear mapping functions for brightness conversion
@@ -151,8 +240,8 @@ void XYscope::setTextIntensity(short TextBright) {
 		//Save updated TextBright to class variable
 		_textBrightness = TextBright;
 		//Calculate new density based on 'GraphBright' value
-		_textDensity = (TextBright - InputMin) * (OutputMax - OutputMin)
-				/ (InputMax - InputMin) + OutputMin;
+		_textDensity = lodDensity((TextBright - InputMin) * (OutputMax - OutputMin)
+				/ (InputMax - InputMin) + OutputMin);
 	}
 
 }
@@ -180,11 +269,12 @@ void XYscope::plotClear(void) {
 	//
 	//	20170705 Ver 2.0	E.Andrews	Simplified call by eliminating all passed parameters
 
-	//	Just reset the array pointers and display goes blank
+	//	Just reset the array pointers and display goes blank.  (With a background layer, only the overlay is cleared.)
 	XYlistEnd = 0;
 	//Now initialize the first entry into the XYlist array using the plotStart() function
 	plotStart();
 	plotEnd();
+	present();		//In double buffer mode, the empty list must be presented to reach the screen
 	//AutoSetRefreshTime();
 	return;
 }
@@ -198,21 +288,33 @@ void XYscope::plotEnd() {
 	//	Returns: NOTHING
 	//
 	//	20170705 Ver 0.1	E.Andrews	First cut of simplified routine (no passed parameters)
+	//	20261017 Ver 0.2				Access list through listPoint() (list may continue into extra chunks)
 
 
 	if (XYlistEnd > 0) {
 
-		XY_List[XYlistEnd].X = XY_List[XYlistEnd - 1].X;
-		XY_List[XYlistEnd].Y = XY_List[XYlistEnd - 1].X;
+		listPoint(XYlistEnd).X = listPoint(XYlistEnd - 1).X;
+		listPoint(XYlistEnd).Y = listPoint(XYlistEnd - 1).X;
 	} else {
-		XY_List[XYlistEnd].X = X_flag;
-		XY_List[XYlistEnd].Y = Y_flag;
+		listPoint(XYlistEnd).X = X_flag;
+		listPoint(XYlistEnd).Y = Y_flag;
 	}
 
 	//AutoSetRefreshTime();
 	return;
 }
 
+bool XYscope::getListFull() {
+	//	Routine to find out if the list overflowed.  Once the list (XY_List, its chunks and MaxBuffSize) or the
+	//	packed store is full, plotPoint() drops every further point until the next plotStart().
+	//
+	//	Returns: true = points were dropped since plotStart(), false = every point was stored
+	//
+	//	20261018 Ver 0.0				First cut
+
+	return _listFull;
+}
+
 void XYscope::plotStart() {
 	//	Routine Loads the following three(X,Y) points into the start of the XYlist() buffer.
 	//		(0,0), (4095,0),(0,0) - This creates a full-scale pulse on the X-channel, occuring during BLANKING period,
@@ -226,2164 +328,5018 @@ void XYscope::plotStart() {
 	//	20170320 Ver 0.0	E.Andrews	First cut
 	//  20170526 ver 0.1	E.Andrews	Fine tune number of start up pixels..
 	//	20170617 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
-	//
-	//
+	//	20261017 Ver 0.3				Double buffer mode: start the new list in the BACK buffer
+	//	20261017 Ver 0.4				List capacity comes from the constructor; compute plotPoint limit once per list
+	//	20261017 Ver 0.5				Reset segment table and scene
+	//	20261017 Ver 0.6				Background layer: start an overlay list (the background holds the sync pulse)
+	//	20261017 Ver 0.7				Empty the packed store
+	//	20261017 Ver 0.8				Drop plot calls still queued for the old list
+	//	20261017 Ver 0.9				Level of detail controller: measure the old list before it is dropped
+	//	20261017 Ver 1.0				Clear the dropped points flag (_listFull)
+	//
+	//
+	if (_lodEnable)
+		lodUpdate();
 	plotErr = 0;
+	_listFull = false;
 
 	XYlistEnd = 0;
+	_cmdCount = _cmdDone = 0;
+	if (_packStore != NULL)
+		packReset();
+	if (_doubleBuffer) {
+		waitForSwap();	//A presented list must reach the screen before its partner bank can be reused
+		_plotList = (_dmaList == _dynList) ? _dynList + _dynCapacity / 2 : _dynList;
+	} else {
+		_plotList = _dmaList = _dynList;
+		_plotListSize = _dynCapacity;
+	}
+	setPlotLimit();
+	_segmentCount = 0;
+	_activeSegment = -1;
+	_sceneCount = 0;
+
+	if (_bgPoints > 0) {
+		//Overlay list: the DMA paints it right after the background, which already starts with the sync pulse.
+		//Start with a copy of the last background point so the beam does not jump before the first overlay point.
+		_plotList[XYlistEnd] = _bgList[_bgPoints - 1];
+		XYlistEnd++;
+		return;
+	}
+
 	//  We need to load a full scale pulse into the XYlist array for sync-up pouposes
-	XY_List[XYlistEnd].X = 0 | X_flag;				//Load X Value
-	XY_List[XYlistEnd].Y = 0 | Y_flag;
+	_plotList[XYlistEnd].X = 0 | X_flag;				//Load X Value
+	_plotList[XYlistEnd].Y = 0 | Y_flag;
 	XYlistEnd++;	//Load Y value and increment pointer
 
 	//Write the SYNC PULSE into the front of the buffer...
 
-	XY_List[XYlistEnd].X = 0xfff | X_flag;//Load full scale value into X to create a pulse
-	XY_List[XYlistEnd].Y = 0 | Y_flag;
+	_plotList[XYlistEnd].X = 0xfff | X_flag;//Load full scale value into X to create a pulse
+	_plotList[XYlistEnd].Y = 0 | Y_flag;
 	XYlistEnd++;	//Load Y value
 
-	XY_List[XYlistEnd].X = 0xfff | X_flag;//Load full scale value into X to create a pulse
-	XY_List[XYlistEnd].Y = 0 | Y_flag;
+	_plotList[XYlistEnd].X = 0xfff | X_flag;//Load full scale value into X to create a pulse
+	_plotList[XYlistEnd].Y = 0 | Y_flag;
 	XYlistEnd++;	//Load Y value and increment pointer
 
-	XY_List[XYlistEnd].X = 0 | X_flag;				//Load X Value
-	XY_List[XYlistEnd].Y = 0 | Y_flag;
+	_plotList[XYlistEnd].X = 0 | X_flag;				//Load X Value
+	_plotList[XYlistEnd].Y = 0 | Y_flag;
 	XYlistEnd++;	//Load Y value and increment pointer
 
 	//  Now add  a few more dummy points to give us time to come out of blanking...
 
-	XY_List[XYlistEnd].X = 0 | X_flag;			    //Load X Value
-	XY_List[XYlistEnd].Y = 0 | Y_flag;
+	_plotList[XYlistEnd].X = 0 | X_flag;			    //Load X Value
+	_plotList[XYlistEnd].Y = 0 | Y_flag;
 	XYlistEnd++;	//Load Y value
 	//AutoSetRefreshTime();
 	return;
 }
 
-void XYscope::plotPoint(int x0, int y0) {
-	//	Routine for POINT plotting
+void XYscope::setDoubleBuffer(bool enable) {
+	//	Routine to turn FRONT/BACK (double) buffer mode ON or OFF.
+	//
+	//	In double buffer mode, XY_List[] is split into two banks of XY_ListCapacity/2 points.  The DMA
+	//	always paints the FRONT bank while all plot routines write into the BACK bank.  Nothing that is
+	//	plotted becomes visible until present() is called.  The swap itself is done inside the ISRs,
+	//	in between DMA transfers, so the screen never shows a torn or half-drawn frame.
+	//
+	//	Typical loop() usage:
+	//		XYscope.plotStart();	//Start new frame in BACK buffer (waits for a previously presented frame to go live)
+	//		...plot...
+	//		XYscope.plotEnd();
+	//		XYscope.present();		//Swap at the next end-of-transfer
+	//
 	//	Calling parameters:
+	//		enable	true = Double buffer mode ON, false = OFF (normal single buffer mode, startup default)
 	//
-	//		x0, y0	Coordinate of point to be plotted.  
-	//				Valid Range:  0<= x0 <= 4095, 0<= y0 <= 4095
 	//	Returns: NOTHING
 	//
-	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//	Notes:
+	//	1)	Each bank holds half as many points as the single buffer.  When turned ON, the current
+	//		display list is kept on screen (truncated to fit the first bank) and a new BACK buffer is started.
+	//	2)	When turned OFF, the most recently presented frame is kept and becomes the (single) display list.
+	//	3)	With a background layer (see setBackgroundLayer), only the overlay is double buffered.
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Banks are taken from the RAM left over by a background layer
+
+	if (enable == _doubleBuffer)
+		return;
+	int bankSize = _dynCapacity / 2;
+	if (enable) {
+		_swapPending = false;
+		_dmaList = _dynList;
+		_dmaListEnd = XYlistEnd < bankSize ? XYlistEnd : bankSize;	//Front count must be valid before the ISRs see the mode change
+		_plotListSize = bankSize;
+		_doubleBuffer = true;
+		plotStart();	//Start a fresh BACK buffer
+	} else {
+		swapBuffers();	//Make sure the latest presented frame is the one that stays on screen
+		XYlistEnd = _dmaListEnd;
+		_plotList = _dmaList;
+		_plotListSize = _dynCapacity - (_dmaList - _dynList);
+		_doubleBuffer = false;
+		setPlotLimit();
+	}
+}
+
+bool XYscope::getDoubleBuffer() {
+	//	Routine to retrieve double buffer mode.
 	//
-	//	20170320 Ver 0.0	E.Andrews	First cut
-	//	20170427 Ver 0.1	E.Andrews	Add plotErr & near end-of-buffer limit logic and check
-	//	20170627 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+	//	Returns: true = Double buffer mode is ON, false = OFF
 	//
-	if (_screenOnTime_ms != 0)
-		_crtOffTOD_ms = millis() + _screenOnTime_ms;//Update ScreenOff time of day (ms)
-	if (XYlistEnd > MaxBuffSize - 3) {
-		plotErr = 0;//Set plotErr and skip writing point into buffer if we are about to hit the end-of-buffer.
-	} else {
+	//	20261017 Ver 0.0				First cut
 
-		XY_List[XYlistEnd].X = (x0 & 0xfff) | X_flag;//Load X Value into EVEN array term
-		XY_List[XYlistEnd].Y = (y0 & 0xfff) | Y_flag;//Load Y value into ODD array term
+	return _doubleBuffer;
+}
 
-		XYlistEnd++;							//Increment List Pointer  value 
+void XYscope::present() {
+	//	Routine to queue the BACK buffer for display.  The swap takes effect between DMA transfers
+	//	(at the next ENDTX interrupt or refresh interrupt, whichever comes first).  present() does
+	//	NOT wait; the next plotStart() will wait (if needed) until the swap has happened.
+	//
+	//	Do not plot into the buffer again after present().  Start the next frame with plotStart().
+	//
+	//	Has no effect in single buffer mode.
+	//
+	//	Calling parameters: NONE
+	//	Returns: NOTHING
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Memory barrier before the flag (as commitEdit)
 
-	}
-	return;
+	if (!_doubleBuffer)
+		return;
+	_swapList = _plotList;
+	_swapListEnd = XYlistEnd;
+	xyHalMemoryBarrier();		//All list writes complete BEFORE the ISR may swap to this buffer
+	_swapPending = true;		//Set LAST; the ISR only looks at _swapList/_swapListEnd once this is true
 }
 
-void XYscope::plotLine(int x0, int y0, int x1, int y1) {
-	//	BRESSHAM Algorithm for LINE drawing
-	//		Algorithm implementation/starting code base from: http://members.chello.at/~easyfilter/bresenham.html
+void XYscope::setFrameCallback(void (*frameCallback)(uint32_t frameCount)) {
+	//	Routine to set a user routine that is called each time a frame has been painted onto the CRT.
+	//
 	//	Calling parameters:
+	//		frameCallback	Address of a routine of the form: void myFrameDone(uint32_t frameCount)
+	//						frameCount is the new value returned by getFrameCount().  NULL = no callback (startup default)
 	//
-	//		x0, y0	Coordinate of starting point
-	//		x1, y1	Coordinate of ending point
+	//	CAUTION: The callback runs inside the DACC interrupt (after the beam has been blanked).  Keep it SHORT;
+	//	set a flag or bump a counter.  Do NOT call plot routines or Serial.print from it.
 	//
-	//		  		Density is a COMMON variable that the using sets with setDensity() routine.
-	//				Higher values of Density increases the distance between ajacent plotted points of graphics figures.
-	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
-	//				Valid numbers are 0 to 100.  Note: depending upon size & focus of CRT, values more ~50 shows
-	//				cause lines of circles and vectors to begin to appear as dotted lines.
 	//	Returns: NOTHING
 	//
-	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//	20261017 Ver 0.0				First cut
+
+	_frameCallback = frameCallback;
+}
+
+uint32_t XYscope::getFrameCount() {
+	//	Routine to retrieve the frame counter.  The counter is bumped each time a DMA transfer of the
+	//	display list has completed, ie: once per screen refresh.  It starts at zero and rolls over after 2^32 frames.
 	//
-	//	20170321 Ver 0.1	E.Andrews	First cut
-	//	20170617 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+	//	Returns: Number of frames painted.
 	//
-	plotErr = 0;
-	int lastPointX, lastPointY;
-	int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
-	int dy = abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
-	int err = (dx > dy ? dx : -dy) / 2, e2;
-	int SkipCount = 0;
-	for (;;) {
-		if (SkipCount <= 0)	//|| (x0 == x1 && y0 == y1) )	//should we skip actualling putting point to the screen?
-				{
-			plotPoint(x0, y0);
-			lastPointX = x0;		//Save and hold the last point plotted
-			lastPointY = y0;
-			SkipCount = _graphDensity;
-		} else {
-			SkipCount--;//The point is to be skipped so we don't need to actually send the point to the screen buffer
-			//Just decrement Skip Point Counter till it gets to Zero, then plot the point
-		}
+	//	20261017 Ver 0.0				First cut
 
-		if (x0 == x1 && y0 == y1) {
-			//Force a plot at the endpoint to 'finish the line' if the end point was not previously plotted
-			if (lastPointX != x1 && lastPointY != y1)
-				plotPoint(x1, y1);
-			break;
-		}
-		e2 = err;
-		if (e2 > -dx) {
-			err -= dy;
-			x0 += sx;
-		}
-		if (e2 < dy) {
-			err += dx;
-			y0 += sy;
-		}
-	}
+	return _frameCount;
+}
 
-	return;
+uint32_t XYscope::framesSince(uint32_t frameCount) {
+	//	Routine to find out how many frames have been painted since an earlier call to getFrameCount().
+	//	Unsigned subtraction makes the result correct across counter roll over.
+	//
+	//	Typical usage, move the ball one step per displayed frame:
+	//		uint32_t lastFrame = XYscope.getFrameCount();
+	//		...
+	//		ballX += ballSpeed * XYscope.framesSince(lastFrame);
+	//		lastFrame += XYscope.framesSince(lastFrame);
+	//
+	//	Calling parameters:
+	//		frameCount	A value previously returned by getFrameCount() or waitForFrame()
+	//
+	//	Returns: Number of frames painted since then.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	return _frameCount - frameCount;
 }
 
-void XYscope::plotRectangle(int x0, int y0, int x1, int y1) {
-	//	Plots a RECTANGLE LINE drawing
-	//	
+uint32_t XYscope::waitForFrame(uint32_t frames) {
+	//	Routine to wait (idle) until 'frames' more frames have been painted.  Use this in loop() to run
+	//	an animation in lockstep with the screen refresh instead of rebuilding the list as fast as the CPU allows.
+	//
 	//	Calling parameters:
+	//		frames	Number of frames to wait for (default=1, ie: wait for the end of the current frame)
 	//
-	//		x0, y0	Coordinate of starting point
-	//		x1, y1	Coordinate of ending point
+	//	Returns: Frame count at the end of the wait.
 	//
-	//		  		Density is a COMMON variable that the using sets with setDensity() routine.
-	//				Higher values of Density increases the distance between ajacent plotted points of graphics figures.
-	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
-	//				Valid numbers are 0 to 100.  Note: depending upon size & focus of CRT, values more ~50 shows
-	//				cause lines of circles and vectors to begin to appear as dotted lines.
+	//	CAUTION: Frames are only painted after begin() has been called and the refresh timer interrupt is attached.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	uint32_t startFrame = _frameCount;
+	while (_frameCount - startFrame < frames)
+		xyHalIdle();
+	return _frameCount;
+}
+
+void XYscope::beginEdit() {
+	//	Routine to open an EDIT WINDOW so that part (or all) of a live XY_List can be rewritten without
+	//	the DMA ever painting a half-edited list.  No interrupts are disabled and nothing is copied.
+	//
+	//	Typical usage (clock demo: redraw only the second hand, which starts at Gbl_SEC_ListPtr):
+	//		XYscope.beginEdit();
+	//		XYscope.XYlistEnd = Gbl_SEC_ListPtr;	//Rewind to start of the region being replaced
+	//		XYscope.plotLine(...);					//Re-plot the region
+	//		XYscope.plotEnd();
+	//		XYscope.commitEdit();
+	//
+	//	The protocol is a sequence counter (_editSeq) shared by loop() code and the refresh ISRs:
+	//
+	//	  loop() (writer) side:
+	//		1)	beginEdit() makes _editSeq ODD, then issues a memory barrier.
+	//		2)	It then waits until the PDC reports TXBUFE (both transfer counters = 0).  At this point the DMA has
+	//			finished reading the list, and because _editSeq is ODD no new transfer can be started.
+	//		3)	Any XY_List entries and XYlistEnd may now be changed.
+	//		4)	commitEdit() issues a memory barrier (all list writes are complete and visible to the PDC)
+	//			and THEN makes _editSeq EVEN again.
+	//
+	//	  ISR (reader) side:
+	//		initiateDacDma() reads _editSeq ONCE on entry.  If it is ODD, the refresh is skipped (the beam
+	//		stays blanked) and counted in getDeferredRefreshCount().  If it is EVEN, the transfer is started
+	//		using the XYlistEnd value read after that check.  dacHandler() only hands blocks of that same
+	//		transfer to the PDC and never touches list memory.
+	//
+	//	Since the ISRs cannot be interrupted by loop() code, a refresh is either started completely before
+	//	step 1 (and waited out by step 2) or sees the ODD sequence number and is skipped.
 	//
+	//	TIP: Keep edit windows short.  The edit is invisible on screen when it completes before the next
+	//	refresh interrupt.  Call waitForFrame() just before beginEdit() to get the longest possible window.
+	//	Calls may be nested; only the outermost beginEdit()/commitEdit() pair opens and closes the window.
+	//
+	//	Calling parameters: NONE
 	//	Returns: NOTHING
 	//
-	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Wait for TXBUFE so a multi-block (layered) transfer is waited out completely
+	//	20261017 Ver 0.2				No wait while streaming (the DMA never reads the list then)
+
+	if (_editDepth++ != 0)
+		return;
+	_editSeq = _editSeq + 1;		//ODD: hold off new transfers
+	xyHalMemoryBarrier();
+	while (_ringList == NULL && (xyHalDmaStatus() & XYHAL_TXBUFE) == 0)
+		xyHalIdle();				//Wait out a transfer (all blocks of the chain) that was already underway
+	xyHalMemoryBarrier();
+}
+
+void XYscope::commitEdit() {
+	//	Routine to close an EDIT WINDOW opened by beginEdit().  Edits become visible at the next refresh.
 	//
-	//	20170424 Ver 0.0	E.Andrews	First cut
-	//	20170617 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
-	//	
+	//	Calling parameters: NONE
+	//	Returns: NOTHING
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261018 Ver 0.1				Start an event driven refresh that was held off by the window
 
-	plotErr = 0;
-	plotLine(x0, y0, x1, y0);	//Top horizontal line
-	plotLine(x1, y0, x1, y1);	//Right verticle line
-	plotLine(x1, y1, x0, y1);	//Bottom horizontal line
-	plotLine(x0, y1, x0, y0);	//Left verticle line
+	if (_editDepth == 0 || --_editDepth != 0)
+		return;
+	xyHalMemoryBarrier();			//All list writes complete BEFORE the ISR may start a transfer
+	_editSeq = _editSeq + 1;		//EVEN: transfers allowed again
+	if (_eventRefresh && _refreshPending) {	//Event driven refresh held off by this window: start it now
+		_refreshPending = false;
+		xyHalRefreshTimerOnce(0);
+	}
+}
 
-	return;
+uint32_t XYscope::getEditSequence() {
+	//	Routine to retrieve the edit sequence number.  It is ODD while an edit window is open and is
+	//	bumped by two for every completed edit, so a changed (even) value means the list was edited.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	return _editSeq;
 }
 
-void XYscope::plotCircle(int xc, int yc, int r) {
-	//	Routine for CIRCLE plotting.  Basic algorithm implementation/starting code base from: 
-	//	https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
+uint32_t XYscope::getDeferredRefreshCount() {
+	//	Routine to retrieve the number of refreshes that were skipped because an edit window was open.
+	//	A count that keeps growing means edits take longer than the time between refreshes (visible as flicker).
+	//
+	//	20261017 Ver 0.0				First cut
+
+	return _deferredRefreshes;
+}
+
+int XYscope::segmentOpen(int capacity) {
+	//	Routine to reserve room for an object that will be redrawn often (a moving needle, a ball, a number...).
+	//	The room is reserved at the current end of the list and can later be re-rendered IN PLACE, without
+	//	touching (or re-plotting) anything else in the list.
+	//
+	//	Typical usage:
+	//		XYscope.plotStart();
+	//		...plot static scene...
+	//		int needle = XYscope.segmentOpen(200);	//Room for 200 points
+	//		...plot more static scene (optional)...
+	//
+	//		//Later, each time the needle moves:
+	//		XYscope.segmentBegin(needle);
+	//		XYscope.plotLine(2047, 2047, xTip, yTip);
+	//		XYscope.segmentEnd();
 	//
 	//	Calling parameters:
-	//		ix		Array pointer into aaAudio.dacBuffer16() where X & Y point will be put.
+	//		capacity	Number of points to reserve.  Points plotted beyond capacity are dropped.
 	//
-	//		xc, yc	Coordinate of point center of circle to be plotted.  
-	//				Valid Range:  0<= xc <= 4095, 0<= yc <= 4095
+	//	Returns:	Segment handle (0 to MaxSegments-1), or -1 (and plotErr set) when the list or segment table is full.
 	//
-	//		r		Radius of circle   
+	//	Notes:
+	//	1)	Unused slots are padded so the DMA transfer length never changes.  Padding retraces the segment's
+	//		own points from its start; an empty segment is padded with copies of the point just before it.
+	//		A segment that is much larger than its content therefore looks a little brighter.
+	//	2)	Segments belong to the current list; plotStart() (and plotClear()) forgets all of them.
+	//	3)	In double buffer mode, a segment lives in the BACK buffer it was opened in.
 	//
-	//	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
-	//				Caller should take care so that center - radius values do not exceed 4095.
-	//				Negative or coordinate values >4095 will be masked to 12 bits and will
-	//				fold-over the edges of the valid plot area (x,y) = (0 to 4095, 0 to 4095).
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Flush queued plot calls first, so they end up before the segment
+
+	flush();
+	return segmentOpen(capacity, 0);
+}
+
+int XYscope::segmentOpen(int capacity, int used) {
+	//	segmentOpen() for a segment whose first 'used' points have already been plotted at XYlistEnd.
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Refused while a pool object is being drawn
+	//	20261017 Ver 0.2				New segments are painted once per refresh
+
+	if (_activeSegment >= 0 || _activeObject >= 0 || capacity <= 0 || _segmentCount >= MaxSegments
+			|| XYlistEnd + capacity - 1 > _plotLimit) {
+		plotErr = 1;
+		return -1;
+	}
+	int handle = _segmentCount++;
+	_segment[handle].start = XYlistEnd;
+	_segment[handle].capacity = capacity;
+	_segment[handle].used = used;
+	_segment[handle].repeat = 1;
+	segmentPad(handle);
+	XYlistEnd += capacity;
+	return handle;
+}
+
+void XYscope::segmentBegin(int handle) {
+	//	Routine to start re-rendering a segment opened with segmentOpen().  Until segmentEnd() is called,
+	//	all plot routines write into the segment (starting at its first point) instead of the end of the list.
+	//
+	//	An edit window (see beginEdit) is held open until segmentEnd(), so the DMA never paints a half-drawn
+	//	segment.  Keep the work between segmentBegin() and segmentEnd() short: ONLY plot the segment's content.
+	//	Do not call plotStart(), plotEnd() or segmentOpen() in between.
+	//
+	//	Calling parameters:
+	//		handle	Value returned by segmentOpen()
 	//
-	//				NOTE: Routine will set plotErr >0 & skip plotting if passed parameter errors are detected.
 	//	Returns: NOTHING
 	//
-	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Refused while a pool object is being drawn
+
+	if (handle < 0 || handle >= _segmentCount || _activeSegment >= 0 || _activeObject >= 0)
+		return;
+	flush();				//Queued plot calls belong to the end of the list, not to the segment
+	beginEdit();
+	_cmdSuspend++;			//Segment content is rasterized right away
+	_activeSegment = handle;
+	_segSavedListEnd = XYlistEnd;
+	_segSavedLimit = _plotLimit;
+	XYlistEnd = _segment[handle].start;
+	_plotLimit = _segment[handle].start + _segment[handle].capacity - 1;
+}
+
+void XYscope::segmentEnd() {
+	//	Routine to finish re-rendering a segment.  Unused slots are padded, the list end is restored and the
+	//	new content becomes visible at the next refresh.
 	//
-	//	20170322 Ver 0.0	E.Andrews	First cut
-	//	20170427 Ver 1.0	E.Andrews	Rework to improve shape
-	//	20170617 Ver 2.0	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
-	//	20170619 Ver 2.1	E.Andrews	Make this routine run in four passes to improve plot quality at high DMA clock speeds
+	//	Calling parameters: NONE
+	//	Returns: NOTHING
 	//
+	//	20261017 Ver 0.0				First cut
+
+	if (_activeSegment < 0)
+		return;
+	int handle = _activeSegment;
+	_segment[handle].used = XYlistEnd - _segment[handle].start;
+	segmentPad(handle);
+	XYlistEnd = _segSavedListEnd;
+	_plotLimit = _segSavedLimit;
+	_activeSegment = -1;
+	_cmdSuspend--;
+	commitEdit();
+}
 
-	//plotCircle(xc, yc, r,255);
-	int arcSegment = 255;
+int XYscope::getSegmentPoints(int handle) {
+	//	Routine to retrieve the number of points drawn in a segment (not counting padding).
+	//
+	//	Calling parameters:
+	//		handle	Value returned by segmentOpen()
+	//
+	//	Returns: Points drawn, or -1 if handle is not valid
+	//
+	//	20261017 Ver 0.0				First cut
 
-	plotErr = 0;
-	int SkipCount = 0;
-	uint8_t pass = 0;
+	if (handle < 0 || handle >= _segmentCount)
+		return -1;
+	return _segment[handle].used;
+}
 
-	//==========Check to be sure that the figure is fully on-screen
-	if ((xc + r > 4095) || (xc - r < 0))
-		plotErr = 1;
-	if ((yc + r > 4095) || (yc - r < 0))
-		plotErr = 1;
-	//==========Skip drawing if figure is faulted
-	if (plotErr == 0) {
+bool XYscope::segmentSetRepeat(int handle, uint8_t count) {
+	//	Routine to make a segment brighter without plotting it again.  The segment's points are stored once;
+	//	at every refresh the DMA chain sends them 'count' times in a row (the whole segment, padding included).
+	//	So a highlighted object costs no extra list RAM and no extra plot time, only DMA time.
+	//
+	//	Typical usage:
+	//		int ball = XYscope.segmentOpen(200);
+	//		XYscope.segmentSetRepeat(ball, 2);		//Twice as bright as the rest of the scene
+	//		...
+	//		XYscope.segmentBegin(ball);
+	//		XYscope.plotCircle(ballX, ballY, ballR);
+	//		XYscope.segmentEnd();
+	//
+	//	Calling parameters:
+	//		handle	Value returned by segmentOpen()
+	//		count	1 = painted once (default), 2 = twice, ...
+	//
+	//	Returns:	true = done, false = bad handle, or the repeats of all segments together would need more than
+	//				MaxRepeatBlocks DMA chain blocks (the repeat count is left as it was)
+	//
+	//	Notes:
+	//	1)	Each repeated segment takes up to 2 * count blocks of the DMA chain; MaxRepeatBlocks are available per
+	//		refresh, e.g. 8 segments at count 1+1, or one segment at count 8.
+	//	2)	Repeats apply in single buffer mode only, and not while the list is interlaced (see setInterlace).
+	//	3)	autoSetRefreshTime() counts the repeated points.
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261018 Ver 0.1				Refuse counts that do not fit in MaxRepeatBlocks instead of painting once
+
+	if (handle < 0 || handle >= _segmentCount)
+		return false;
+	int blocks = count > 1 ? 2 * count : 0;
+	for (int s = 0; s < _segmentCount; s++)
+		if (s != handle && _segment[s].repeat > 1)
+			blocks += 2 * _segment[s].repeat;
+	if (blocks > MaxRepeatBlocks)
+		return false;
+	_segment[handle].repeat = count > 1 ? count : 1;	//One byte; takes effect at the next refresh
+	return true;
+}
 
-		int x, y, delta, error;
-		for (uint8_t loopCnt = 0; loopCnt < 4; loopCnt++) {	//Although this is 4X slower, it orders the points in a way that will improve plot quality
+int XYscope::getSegmentRepeat(int handle) {
+	//	Routine to retrieve the repeat count of a segment (see segmentSetRepeat).
+	//
+	//	Returns: Repeat count, or -1 if handle is not valid
+	//
+	//	20261017 Ver 0.0				First cut
 
-			x = 0;
-			y = r;	//radius
-			delta = 2 - 2 * r;
-			error = 0;
-			int xHalfWayLimit = int(float(r) * .707106);//xHalfWayLimit = xr * sin(45Deg)
-			int yHalfWayLimit = int(float(r) * .707106);//yHalfWayLimit = xr * cos(45Deg)
+	if (handle < 0 || handle >= _segmentCount)
+		return -1;
+	return _segment[handle].repeat;
+}
 
-			while (y >= 0) {
-				if (SkipCount == 0 || y <= 0) {	//Actually plot a point whenever (SkipCount=0) OR (we're at the last point to be plotted)
-					int xp, yp;
-					switch (loopCnt) {
+void XYscope::setObjectPool(pointList *pool, int points) {
+	//	Routine to give the library RAM for OBJECTS: figures that are added, deleted, re-drawn and resized one
+	//	at a time, in any order, without re-plotting (or moving) anything else.
+	//
+	//	The pool is a table of blocks.  Each object owns one block of pool RAM; deleting an object just returns
+	//	its block to the free space.  No list is rebuilt: at every refresh the objects are chained to the DMA
+	//	straight from the pool, after the display list (objects that touch each other go out as one block).
+	//
+	//	Typical usage:
+	//		XYscope::pointList pool[3000];			//Global RAM
+	//		...
+	//		XYscope.setObjectPool(pool, 3000);
+	//		int ship = XYscope.objectNew(400);		//Room for 400 points
+	//		XYscope.objectBegin(ship);
+	//		XYscope.plotCircle(x, y, 100);			//Any plot routines
+	//		XYscope.objectEnd();					//Ship is on screen from the next refresh on
+	//		...
+	//		XYscope.objectDelete(ship);				//Gone at the next refresh
+	//		...
+	//		XYscope.objectCompact();				//From loop() when there is time to spare (see objectCompact)
+	//
+	//	Calling parameters:
+	//		pool	RAM for the objects (NULL = no pool; all objects are dropped)
+	//		points	Size of pool
+	//
+	//	Returns: NOTHING
+	//
+	//	Notes:
+	//	1)	Objects are not part of the display list: plotStart()/plotClear() do not erase them, and they are
+	//		shown the same way in single and double buffer mode.  Each change shows up at the next refresh.
+	//	2)	Changes are made inside an edit window (see beginEdit), so the DMA never paints a half-made change.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	if (_activeObject >= 0)
+		return;
+	beginEdit();
+	_pool = pool;
+	_poolSize = pool != NULL && points > 0 ? points : 0;
+	for (int i = 0; i < MaxPoolBlocks; i++)
+		_poolBlock[i].state = blockUnused;
+	for (int i = 0; i < MaxObjects; i++)
+		_object[i] = -1;
+	_poolPoints = 0;
+	_poolHead = -1;
+	if (_poolSize > 0) {
+		_poolBlock[0].start = 0;			//All of the pool is one free block
+		_poolBlock[0].capacity = _poolSize;
+		_poolBlock[0].used = 0;
+		_poolBlock[0].prev = _poolBlock[0].next = -1;
+		_poolBlock[0].state = blockFree;
+		_poolHead = 0;
+	}
+	commitEdit();
+}
 
-					case 0: {
-						xp = xc - x;
-						yp = yc + y;	//Segment 0, 1
-						//Serial.print("S01 (");Serial.print(xp);Serial.print(",");Serial.print(yp);Serial.println(")");						
-						//plotPoint(xc - x, yc + y);		//Segment 0, 1
-						if (arcSegment & arc0 && x >= xHalfWayLimit)
-							plotPoint(xp, yp);		//Segment 0
-						if (arcSegment & arc1 && x < xHalfWayLimit)
-							plotPoint(xp, yp);		//Segment 1
+int XYscope::objectNew(int capacity) {
+	//	Routine to allocate a pool object (see setObjectPool).  The object is empty (shows nothing) until it
+	//	is drawn with objectBegin()/objectEnd().
+	//
+	//	Calling parameters:
+	//		capacity	Points to reserve.  Points plotted beyond capacity are dropped.
+	//
+	//	Returns:	Object handle (0 to MaxObjects-1), or -1 (and plotErr set) when there is no room.
+	//				There may be room after objectCompact(); getPoolFree() tells.
+	//
+	//	20261017 Ver 0.0				First cut
 
-						break;
+	int handle = 0;
+	while (handle < MaxObjects && _object[handle] >= 0)
+		handle++;
+	int block = -1;
+	if (handle < MaxObjects && capacity > 0 && _activeObject < 0) {
+		beginEdit();
+		block = poolAlloc(capacity);
+		commitEdit();
+	}
+	if (block < 0) {
+		plotErr = 1;
+		return -1;
+	}
+	_object[handle] = block;
+	return handle;
+}
 
-					}
-					case 1: {
-						xp = xc + x;
-						yp = yc + y;	//Segment 2, 3
-						//Serial.print("S23 (");Serial.print(xp);Serial.print(",");Serial.print(yp);Serial.println(")");					
-						//plotPoint(xc + x, yc + y);		//Segment 2, 3
-						if (arcSegment & arc2 && x < xHalfWayLimit)
-							plotPoint(xp, yp);		//Segment 2
-						if (arcSegment & arc3 && y <= yHalfWayLimit)
-							plotPoint(xp, yp);		//Segment 3
-						break;
-					}
-					case 2: {
-						xp = xc + x;
-						yp = yc - y;
-						//plotPoint(xc + x, yc - y);		//Segment 4, 5
-						if (arcSegment & arc4 && x < xHalfWayLimit)
-							plotPoint(xp, yp);		//Segment 4
-						if (arcSegment & arc5 && y <= yHalfWayLimit)
-							plotPoint(xp, yp);		//Segment 5
-						break;
-					}
-					case 3: {
-						xp = xc - x;
-						yp = yc - y;
-						//plotPoint(xc - x, yc - y);		//Segment 6. 7
-						if (arcSegment & arc6 && x < xHalfWayLimit)
-							plotPoint(xp, yp);		//Segment 6
-						if (arcSegment & arc7 && y <= yHalfWayLimit)
-							plotPoint(xp, yp);		//Segment 7
-						break;
-					}
-
-					}
-					//if (arcSegment & arc0 && x >= xHalfWayLimit) plotPoint(xc - x, yc + y);	//Segment 0
-					//if (arcSegment & arc1 && x < xHalfWayLimit) plotPoint(xc - x, yc + y);	//Segment 1
-					//if (arcSegment & arc2 && x < xHalfWayLimit) plotPoint(xc + x, yc + y);	//Segment 2
-					//if (arcSegment & arc3 && y <= yHalfWayLimit ) plotPoint(xc + x, yc + y);	//Segment 3
-					//if (arcSegment & arc4 && y < yHalfWayLimit) plotPoint(xc + x, yc - y);		//Segment 4
-					//if (arcSegment & arc5 && x <= xHalfWayLimit) plotPoint(xc + x, yc - y);		//Segment 5
-					//if (arcSegment & arc6 && x <= xHalfWayLimit) plotPoint(xc - x, yc - y);		//Segment 6
-					//if (arcSegment & arc7 && x > xHalfWayLimit) plotPoint(xc - x, yc - y);		//Segment 7
-					SkipCount = _graphDensity;
-				} else
-					SkipCount--;
+void XYscope::objectBegin(int handle) {
+	//	Routine to start drawing a pool object.  Until objectEnd() is called, all plot routines write into the
+	//	object (starting at its first point; the old content is replaced) instead of the end of the list.
+	//
+	//	As with segmentBegin(), an edit window is held open until objectEnd(): ONLY plot the object's content in
+	//	between.  Do not call plotStart(), plotEnd(), segment or other object routines.
+	//
+	//	Calling parameters:
+	//		handle	Value returned by objectNew()
+	//
+	//	Returns: NOTHING
+	//
+	//	20261017 Ver 0.0				First cut
+
+	if (handle < 0 || handle >= MaxObjects || _object[handle] < 0 || _activeObject >= 0 || _activeSegment >= 0)
+		return;
+	flush();				//Queued plot calls belong to the list, not to the object
+	beginEdit();
+	_cmdSuspend++;			//Object content is rasterized right away
+	poolBlock &block = _poolBlock[_object[handle]];
+	_poolPoints -= block.used;
+	_activeObject = handle;
+	_objSavedList = _plotList;			//Point the plot routines at the object's block
+	_objSavedListSize = _plotListSize;
+	_objSavedListEnd = XYlistEnd;
+	_objSavedLimit = _plotLimit;
+	_objSavedPackStore = _packStore;
+	_plotList = _pool + block.start;
+	_plotListSize = block.capacity;
+	XYlistEnd = 0;
+	_plotLimit = block.capacity - 1;
+	_packStore = NULL;					//Objects are always plain points
+}
 
-				error = 2 * (delta + y) - 1;
+void XYscope::objectEnd() {
+	//	Routine to finish drawing a pool object.  The new content becomes visible at the next refresh.
+	//
+	//	Calling parameters: NONE
+	//	Returns: NOTHING
+	//
+	//	20261017 Ver 0.0				First cut
+
+	if (_activeObject < 0)
+		return;
+	poolBlock &block = _poolBlock[_object[_activeObject]];
+	block.used = XYlistEnd;
+	_poolPoints += block.used;
+	_plotList = _objSavedList;
+	_plotListSize = _objSavedListSize;
+	XYlistEnd = _objSavedListEnd;
+	_plotLimit = _objSavedLimit;
+	_packStore = _objSavedPackStore;
+	_activeObject = -1;
+	_cmdSuspend--;
+	commitEdit();
+}
 
-				if ((delta < 0) && (error <= 0)) {
-					++x;
-					delta += 2 * x + 1;
-					continue;
-				}
+void XYscope::objectDelete(int handle) {
+	//	Routine to remove a pool object.  Its room goes back to the pool; no other object is moved.
+	//
+	//	Calling parameters:
+	//		handle	Value returned by objectNew()
+	//
+	//	Returns: NOTHING
+	//
+	//	20261017 Ver 0.0				First cut
 
-				error = 2 * (delta - x) - 1;
+	if (handle < 0 || handle >= MaxObjects || _object[handle] < 0 || _activeObject >= 0)
+		return;
+	beginEdit();
+	_poolPoints -= _poolBlock[_object[handle]].used;
+	poolFree(_object[handle]);
+	_object[handle] = -1;
+	commitEdit();
+}
 
-				if (delta > 0 && error > 0) {
-					--y;
-					delta += 1 - 2 * y;
-					continue;
-				}
-				++x;
-				delta += 2 * (x - y);
-				--y;
+bool XYscope::objectResize(int handle, int capacity) {
+	//	Routine to change the capacity of a pool object, keeping its content (cut to 'capacity' points when
+	//	shrinking).  The object grows in place when free room follows it, otherwise it is copied to a free
+	//	block that is large enough (only this object's points move).
+	//
+	//	Calling parameters:
+	//		handle		Value returned by objectNew()
+	//		capacity	New capacity (points)
+	//
+	//	Returns:	true if done, false if handle is not valid or there is no room
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				A moved object keeps its dimming divisor
+
+	if (handle < 0 || handle >= MaxObjects || _object[handle] < 0 || _activeObject >= 0 || capacity <= 0)
+		return false;
+	int b = _object[handle];
+	poolBlock &block = _poolBlock[b];
+	int next = block.next;
+	bool nextFree = next >= 0 && _poolBlock[next].state == blockFree;
+	bool done = true;
+	beginEdit();
+	if (capacity <= block.capacity) {
+		int spare = block.capacity - capacity;
+		if (spare > 0 && nextFree) {			//Give the spare room to the free block that follows
+			_poolBlock[next].start -= spare;
+			_poolBlock[next].capacity += spare;
+			block.capacity = capacity;
+		} else if (spare > 0) {
+			int e = poolEntry();				//New free block after the object
+			if (e >= 0) {
+				poolBlock &gap = _poolBlock[e];
+				gap.start = block.start + capacity;
+				gap.capacity = spare;
+				gap.used = 0;
+				gap.state = blockFree;
+				gap.prev = b;
+				gap.next = next;
+				if (next >= 0)
+					_poolBlock[next].prev = e;
+				block.next = e;
+				block.capacity = capacity;
 			}
 		}
+		if (block.used > capacity) {
+			_poolPoints -= block.used - capacity;
+			block.used = capacity;
+		}
+	} else if (nextFree && block.capacity + _poolBlock[next].capacity >= capacity) {	//Grow in place
+		int grow = capacity - block.capacity;
+		_poolBlock[next].start += grow;
+		_poolBlock[next].capacity -= grow;
+		block.capacity = capacity;
+		if (_poolBlock[next].capacity == 0) {
+			poolUnlink(next);
+			_poolBlock[next].state = blockUnused;
+		}
+	} else {
+		int moved = poolAlloc(capacity);		//Copy into a new block
+		if (moved < 0)
+			done = false;
+		else {
+			memcpy(_pool + _poolBlock[moved].start, _pool + block.start, block.used * sizeof(pointList));
+			_poolBlock[moved].used = block.used;
+			_poolBlock[moved].dim = block.dim;
+			_object[handle] = moved;
+			poolFree(b);
+		}
 	}
-	return;
+	commitEdit();
+	return done;
 }
-/*
-
- void XYscope::plotCircle(int xc, int yc, int r){
- //	Routine for CIRCLE plotting.  Basic algorithm implementation/starting code base from:
- //	https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
- //
- //	Calling parameters:
- //
- //		xc, yc	Coordinate of point center of circle to be plotted.
- //				Valid Range:  0<= xc <= 4095, 0<= yc <= 4095
- //
- //		r		Radius of circle
- //
- //		arcSegment	8-bit code corresponding to the arc segments that are to be drawn.
- //					Bit = 1 means Draw arc segment, Bit = 0 means do NOT draw arc segment (Skip it!)
- //
 
- 1  |	 2
- \	  |   /
- 0  \  |  /  3
- -------+-------
- 7  /  |  \   4
- /   |   \
-						   6  |  5
-
- //
- //	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
- //				Caller should take care so that center - radius values do not exceed 4095.
- //				Negative or coordinate values >4095 will be masked to 12 bits and will
- //				fold-over the edges of the valid plot area (x,y) = (0 to 4095, 0 to 4095).
- //
- //				NOTE: Routine will set plotErr >0 & skip plotting if passed parameter errors are detected.
- //
- //	Returns: NOTHING
- //
- //	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
- //
- //	20170322 Ver 0.0	E.Andrews	First cut
- //	20170427 Ver 1.0	E.Andrews	Rework to improve shape
- //	20170617 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
- //	20170714 Ver 0.3	E.Andrews	Overlay function when user wants a full circle
- //
- plotCircle(xc, yc, r,255);
- }
+int XYscope::objectCompact() {
+	//	Routine to reduce pool fragmentation.  The first object that has free room just before it is moved
+	//	down into that room, so the free room moves up (and merges with any free room after the object).
+	//	One object is moved per call, so the time taken is bounded by the size of one object (a memmove).
+	//	Call it from loop() when there is time to spare; once it returns 0, all free room is in one
+	//	block at the end of the pool and getPoolFree() is as large as it can be.
+	//
+	//	Calling parameters: NONE
+	//
+	//	Returns:	Gaps (free blocks with an object after them) left
+	//
+	//	20261017 Ver 0.0				First cut
+
+	if (_activeObject >= 0)
+		return -1;
+	int f = _poolHead;
+	while (f >= 0 && !(_poolBlock[f].state == blockFree && _poolBlock[f].next >= 0))
+		f = _poolBlock[f].next;
+	if (f >= 0) {
+		int o = _poolBlock[f].next;		//Free blocks never touch, so this is an object
+		poolBlock &gap = _poolBlock[f];
+		poolBlock &obj = _poolBlock[o];
+		beginEdit();
+		memmove(_pool + gap.start, _pool + obj.start, obj.used * sizeof(pointList));
+		obj.start = gap.start;			//Swap the two blocks
+		gap.start = obj.start + obj.capacity;
+		int prev = gap.prev, next = obj.next;
+		obj.prev = prev;
+		obj.next = f;
+		gap.prev = o;
+		gap.next = next;
+		if (prev >= 0)
+			_poolBlock[prev].next = o;
+		else
+			_poolHead = o;
+		if (next >= 0) {
+			_poolBlock[next].prev = f;
+			if (_poolBlock[next].state == blockFree) {	//Merge with the free block that follows
+				gap.capacity += _poolBlock[next].capacity;
+				poolUnlink(next);
+				_poolBlock[next].state = blockUnused;
+			}
+		}
+		commitEdit();
+	}
+	int gaps = 0;
+	for (int b = _poolHead; b >= 0; b = _poolBlock[b].next)
+		if (_poolBlock[b].state == blockFree && _poolBlock[b].next >= 0)
+			gaps++;
+	return gaps;
+}
 
+int XYscope::getObjectPoints(int handle) {
+	//	Routine to retrieve the number of points drawn in a pool object.
+	//
+	//	Calling parameters:
+	//		handle	Value returned by objectNew()
+	//
+	//	Returns: Points drawn, or -1 if handle is not valid
+	//
+	//	20261017 Ver 0.0				First cut
 
- */
+	if (handle < 0 || handle >= MaxObjects || _object[handle] < 0)
+		return -1;
+	return _poolBlock[_object[handle]].used;
+}
 
-void XYscope::plotCircle(int xc, int yc, int r, uint8_t arcSegment) {
-	//	Routine for CIRCLE plotting.  Basic algorithm implementation/starting code base from: 
-	//	https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
+void XYscope::objectSetDim(int handle, uint8_t divisor) {
+	//	Routine to dim a pool object in TIME rather than in space.  setGraphicsIntensity() dims by spacing the
+	//	dots further apart, which looks dotted below about 50%.  A dimmed object keeps its full dot density but
+	//	is only painted on every 'divisor'th refresh, so it costs 1/divisor of its points per refresh on
+	//	average.  Meant for background content such as grids, scales and labels.
 	//
 	//	Calling parameters:
+	//		handle		Value returned by objectNew()
+	//		divisor		1 = painted every refresh (default), 2 = every other refresh (about half as bright), ...
 	//
-	//		xc, yc	Coordinate of point center of circle to be plotted.  
-	//				Valid Range:  0<= xc <= 4095, 0<= yc <= 4095
+	//	Returns: NOTHING
 	//
-	//		r		Radius of circle   
+	//	Notes:
+	//	1)	Objects with the same divisor take turns (the refresh an object is painted on depends on where it is
+	//		in the pool), so several dimmed objects do not all land on the same refresh.
+	//	2)	The object refresh rate is the refresh rate / divisor: keep it above the flicker rate of the CRT,
+	//		e.g. with a short refresh period or event driven refresh (see setEventRefresh).
+	//	3)	autoSetRefreshTime() still counts all of the object's points, since a refresh may paint it.
+	//	4)	Only pool objects can be dimmed.  The background layer (setBackgroundLayer), static lists
+	//		(addStaticList) and the dynamic list are painted on every refresh; to dim a grid or a scale, plot
+	//		it into an object (objectNew/objectBegin) instead.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	if (handle < 0 || handle >= MaxObjects || _object[handle] < 0)
+		return;
+	_poolBlock[_object[handle]].dim = divisor > 1 ? divisor : 1;	//One byte; takes effect at the next refresh
+}
+
+int XYscope::getObjectDim(int handle) {
+	//	Routine to retrieve the temporal dimming divisor of a pool object (see objectSetDim).
 	//
-	//		arcSegment	8-bit code corresponding to the arc segments that are to be drawn.
-	//					Bit = 1 means Draw arc segment, Bit = 0 means do NOT draw arc segment (Skip it!)
+	//	Returns: Divisor, or -1 if handle is not valid
 	//
-	/*
-	 1  |	 2
-	 \	  |   /
-	 0  \  |  /  3
-	 -------+-------
-	 7  /  |  \   4
-	 /   |   \
-						   6  |  5
-	 */
+	//	20261017 Ver 0.0				First cut
+
+	if (handle < 0 || handle >= MaxObjects || _object[handle] < 0)
+		return -1;
+	return _poolBlock[_object[handle]].dim;
+}
+
+int XYscope::getPoolFree() {
+	//	Routine to retrieve the size of the largest free block in the pool, i.e. the largest capacity
+	//	objectNew() can allocate right now.
 	//
-	//	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
-	//				Caller should take care so that center - radius values do not exceed 4095.
-	//				Negative or coordinate values >4095 will be masked to 12 bits and will
-	//				fold-over the edges of the valid plot area (x,y) = (0 to 4095, 0 to 4095).
+	//	Calling parameters: NONE
+	//	Returns: Points
 	//
-	//				NOTE: Routine will set plotErr >0 & skip plotting if passed parameter errors are detected.
+	//	20261017 Ver 0.0				First cut
+
+	int largest = 0;
+	for (int b = _poolHead; b >= 0; b = _poolBlock[b].next)
+		if (_poolBlock[b].state == blockFree && _poolBlock[b].capacity > largest)
+			largest = _poolBlock[b].capacity;
+	return largest;
+}
+
+int XYscope::sceneAddLine(int x0, int y0, int x1, int y1, int capacity) {
+	//	Retained scene routines.  Instead of re-plotting a whole scene every time something changes, objects
+	//	are added ONCE as scene nodes.  Each node remembers its shape and owns a segment (see segmentOpen) in the
+	//	list.  Changing a node (sceneSet...) only marks it dirty; sceneUpdate() then re-plots just the dirty
+	//	nodes, in place.  Everything else in the list (including ordinary plot... output) is left alone.
+	//
+	//	Typical usage (instrument panel with one moving needle and one changing reading):
+	//		XYscope.plotStart();
+	//		...plot static panel with the ordinary plot routines...
+	//		int needle = XYscope.sceneAddLine(2047, 1000, 2047, 3000, 300);
+	//		int volts = XYscope.sceneAddText(1500, 500, 200, "0.00V", 400);
+	//
+	//		//In loop():
+	//		XYscope.sceneSetLine(needle, 2047, 1000, xTip, yTip);
+	//		XYscope.sceneSetText(volts, newReadingText);
+	//		XYscope.sceneUpdate();		//Only nodes that changed are re-plotted
+	//
+	//	Calling parameters (all sceneAdd... routines):
+	//		shape		Same as the matching plot routine (plotLine, plotCircle, plotEllipse, printSetup+print)
+	//		capacity	Points to reserve for the node.  Use enough for the LARGEST the node will ever get;
+	//					points beyond capacity are dropped.  0 = exactly what the node needs right now.
+	//
+	//	Returns:	Node handle, or -1 (and plotErr set) when there is no room left.
+	//
+	//	Notes:
+	//	1)	Nodes are plotted with the graphics/text intensity in effect when they are (re)plotted.
+	//	2)	Like segments, nodes belong to the current list; plotStart() (and plotClear()) forgets all of them.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	sceneNode node;
+	node.type = sceneLine;
+	node.p[0] = x0;
+	node.p[1] = y0;
+	node.p[2] = x1;
+	node.p[3] = y1;
+	return sceneAdd(node, capacity);
+}
+
+int XYscope::sceneAddCircle(int xc, int yc, int r, int capacity) {
+	//	Add a circle node. See sceneAddLine() for details.
 	//
-	//	Returns: NOTHING
+	//	20261017 Ver 0.0				First cut
+
+	sceneNode node;
+	node.type = sceneCircle;
+	node.p[0] = xc;
+	node.p[1] = yc;
+	node.p[2] = r;
+	node.p[3] = 0;
+	return sceneAdd(node, capacity);
+}
+
+int XYscope::sceneAddEllipse(int xc, int yc, int xr, int yr, int capacity) {
+	//	Add an ellipse node. See sceneAddLine() for details.
 	//
-	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//	20261017 Ver 0.0				First cut
+
+	sceneNode node;
+	node.type = sceneEllipse;
+	node.p[0] = xc;
+	node.p[1] = yc;
+	node.p[2] = xr;
+	node.p[3] = yr;
+	return sceneAdd(node, capacity);
+}
+
+int XYscope::sceneAddText(int textX, int textY, int textSize, const char *text, int capacity) {
+	//	Add a text node. See sceneAddLine() for details.
+	//	The text is COPIED into the node (at most MaxSceneText characters).  It is printed with
+	//	the font spacing/justification in effect when it is (re)plotted.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	sceneNode node;
+	node.type = sceneText;
+	node.p[0] = textX;
+	node.p[1] = textY;
+	node.p[2] = textSize;
+	node.p[3] = 0;
+	strncpy(node.text, text, MaxSceneText);
+	node.text[MaxSceneText] = 0;
+	return sceneAdd(node, capacity);
+}
+
+void XYscope::sceneSetLine(int node, int x0, int y0, int x1, int y1) {
+	//	Routines to change a scene node.  The node is only marked dirty (and re-plotted by the next
+	//	sceneUpdate) when a value actually changed, so it is fine to call these on every pass of loop().
 	//
-	//	20170322 Ver 0.0	E.Andrews	First cut
-	//	20170427 Ver 1.0	E.Andrews	Rework to improve shape
-	//	20170617 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
-	//	20170907 Ver 2.0 	E.Andrews	Abandon Bresenham algorithm for slower floating point approach
-	//									because new approach plots adjacent points and does not take advantage
-	//									of figure symetry.This Allows AGI to run at a higher DMA_CLK freq.
+	//	Calling parameters:
+	//		node		Handle returned by the matching sceneAdd... routine
+	//		shape		New shape values
 	//
-	const float pi = atan(1) * 4;
-	const float arcAng0 = 0;
-	const float arcAng1 = pi * .25;		// .25 * pi
-	const float arcAng2 = pi * .5;		// .50 * pi
-	const float arcAng3 = pi * .75;		// .75 * pi
-	const float arcAng4 = pi;			//1.00 * pi
-	const float arcAng5 = pi * 1.25;	//1.25 * pi
-	const float arcAng6 = pi * 1.50;	//1.50 * pi
-	const float arcAng7 = pi * 1.75;	//1.75 * pi
-	const float FullCircle = 2 * pi;	//2.00 * pi
-	float circumf;
-	short xr, yr;
-	xr = yr = r;
+	//	20261017 Ver 0.0				First cut
 
-	//calculate circle circumference
-	circumf = FullCircle * r;
+	sceneSet(node, sceneLine, x0, y0, x1, y1);
+}
 
-	//Figure out how many points we will actually be plotting
-	//based on the current graphicsIntensity (_graphicsDensity) setting
-	float numOfPoints = circumf / _graphDensity;
-	//Calc the deltaAng between points
-	float deltaAng = FullCircle / (numOfPoints);
+void XYscope::sceneSetCircle(int node, int xc, int yc, int r) {
+	sceneSet(node, sceneCircle, xc, yc, r, 0);
+}
 
-	float angle;
-	short X, Y;
+void XYscope::sceneSetEllipse(int node, int xc, int yc, int xr, int yr) {
+	sceneSet(node, sceneEllipse, xc, yc, xr, yr);
+}
 
-	for (angle = 0; angle < FullCircle; angle = angle + deltaAng) {
-		X = int(xc - cos(angle) * xr);
-		Y = int(yc + sin(angle) * yr);
+void XYscope::sceneSetTextXY(int node, int textX, int textY) {
+	if (node >= 0 && node < _sceneCount)
+		sceneSet(node, sceneText, textX, textY, _sceneNode[node].p[2], 0);
+}
 
-		//Only plot those segments that are enabled by passed "arcSegment" variable
-		if (arcSegment & arc0 && angle <= arcAng1)
-			plotPoint(X, Y);					//Segment 0
-		if (arcSegment & arc1 && angle > arcAng1 && angle <= arcAng2)
-			plotPoint(X, Y);	//Segment 1
-		if (arcSegment & arc2 && angle > arcAng2 && angle <= arcAng3)
-			plotPoint(X, Y);	//Segment 2
-		if (arcSegment & arc3 && angle > arcAng3 && angle <= arcAng4)
-			plotPoint(X, Y);	//Segment 3
-		if (arcSegment & arc4 && angle > arcAng4 && angle <= arcAng5)
-			plotPoint(X, Y);	//Segment 4
-		if (arcSegment & arc5 && angle > arcAng5 && angle <= arcAng6)
-			plotPoint(X, Y);	//Segment 5
-		if (arcSegment & arc6 && angle > arcAng6 && angle <= arcAng7)
-			plotPoint(X, Y);	//Segment 6
-		if (arcSegment & arc7 && angle > arcAng7)
-			plotPoint(X, Y);						//Segment 7
+void XYscope::sceneSetText(int node, const char *text) {
+	if (node < 0 || node >= _sceneCount || _sceneNode[node].type != sceneText)
+		return;
+	if (strncmp(_sceneNode[node].text, text, MaxSceneText) != 0) {
+		strncpy(_sceneNode[node].text, text, MaxSceneText);
+		_sceneNode[node].dirty = true;
 	}
-
-	return;
 }
 
-void XYscope::plotCircleBres(int xc, int yc, int r, uint8_t arcSegment) {
-	/*
-	//	Routine for CIRCLE plotting.  Basic algorithm implementation/starting code base from:
-	//	https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
+int XYscope::sceneUpdate() {
+	//	Routine to re-plot all dirty scene nodes, in place.  The whole update is done in ONE edit window
+	//	(see beginEdit), so the screen shows either all of the old nodes or all of the new ones.
 	//
-	//	Calling parameters:
+	//	Calling parameters: NONE
 	//
-	//		xc, yc	Coordinate of point center of circle to be plotted.
-	//				Valid Range:  0<= xc <= 4095, 0<= yc <= 4095
+	//	Returns: Number of nodes re-plotted (0 = nothing changed, nothing done)
 	//
-	//		r		Radius of circle
+	//	20261017 Ver 0.0				First cut
+
+	int count = 0;
+	for (int n = 0; n < _sceneCount; n++) {
+		if (!_sceneNode[n].dirty)
+			continue;
+		if (count++ == 0)
+			beginEdit();
+		segmentBegin(_sceneNode[n].segment);
+		scenePlot(_sceneNode[n]);
+		segmentEnd();
+		_sceneNode[n].dirty = false;
+	}
+	if (count > 0)
+		commitEdit();
+	return count;
+}
+
+void XYscope::setBackgroundLayer() {
+	//	Routine to freeze the current list as a STATIC BACKGROUND layer (graticule, court lines, labels...).
+	//	From then on, plotStart() starts a separate DYNAMIC OVERLAY list in the RAM left over after the
+	//	background.  Every refresh, the DMA paints the background and then the overlay, chained through the
+	//	PDC "next pointer" registers.  The background is never copied or re-plotted, so rebuilding a frame
+	//	only costs the overlay's points.
 	//
-	//		arcSegment	8-bit code corresponding to the arc segments that are to be drawn.
-	//					Bit = 1 means Draw arc segment, Bit = 0 means do NOT draw arc segment (Skip it!)
+	//	Typical usage:
+	//		XYscope.plotStart();
+	//		...plot the static scene...
+	//		XYscope.setBackgroundLayer();
 	//
+	//		//In loop():
+	//		XYscope.plotStart();		//Starts a new (empty) overlay
+	//		...plot moving objects...
+	//		XYscope.plotEnd();
 	//
-	//					   1  |	 2
-	//					  \	  |   /
-	//					0  \  |  /  3
-	//				   -------+-------
-	//					7  /  |  \   4
-	//					  /   |   \
-	//					   6  |  5
-	//
-	//
-	//	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
-	//				Caller should take care so that center - radius values do not exceed 4095.
-	//				Negative or coordinate values >4095 will be masked to 12 bits and will
-	//				fold-over the edges of the valid plot area (x,y) = (0 to 4095, 0 to 4095).
-	//
-	//				NOTE: Routine will set plotErr >0 & skip plotting if passed parameter errors are detected.
-	//
+	//	Calling parameters: NONE
 	//	Returns: NOTHING
 	//
-	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//	Notes:
+	//	1)	Double buffer mode may be on or off; when on, only the overlay is double buffered.
+	//	2)	Segments and scene nodes in the background are frozen with it (plotStart() forgets them).
+	//		Add nodes that must keep changing to the overlay instead.
+	//	3)	To change the background, call clearBackgroundLayer(), re-plot and call setBackgroundLayer() again.
+	//	4)	The list being frozen must fit in XY_List; a list that continues into extra chunks (see
+	//		addListChunk) can not be made the background.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	bool doubleBuffer = _doubleBuffer;
+	beginEdit();				//Keep the DMA off the lists while they are rearranged
+	if (_bgPoints > 0 || XYlistEnd <= 0 || (!doubleBuffer && XYlistEnd > _plotListSize)) {
+		commitEdit();
+		return;
+	}
+	if (doubleBuffer)
+		setDoubleBuffer(false);	//Background = the list that is on the screen now
+	_bgList = _plotList;
+	_bgPoints = XYlistEnd;
+	_dynList = _plotList + XYlistEnd + 1;	//+1: room for plotEnd()'s extra point
+	_dynCapacity = (XY_List + XY_ListCapacity) - _dynList;
+	plotStart();
+	if (doubleBuffer)
+		setDoubleBuffer(true);
+	commitEdit();
+}
+
+void XYscope::clearBackgroundLayer() {
+	//	Routine to drop the background layer and go back to a single list using all of XY_List.
+	//	The screen is cleared (an empty list is started, as by plotClear()).
 	//
-	//	20170322 Ver 0.0	E.Andrews	First cut
-	//	20170427 Ver 1.0	E.Andrews	Rework to improve shape
-	//	20170617 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+	//	Calling parameters: NONE
+	//	Returns: NOTHING
 	//
-	*/
-	plotErr = 0;
-	int SkipCount = 0;
-	//==========Check to be sure that the figure is fully on-screen
-	if ((xc + r > 4095) || (xc - r < 0))
-		plotErr = 1;
-	if ((yc + r > 4095) || (yc - r < 0))
-		plotErr = 1;
-	//==========Skip drawing if figure is faulted
-	if (plotErr == 0) {
+	//	20261017 Ver 0.0				First cut
 
-		int x = 0;
-		int y = r;	//radius
-		int delta = 2 - 2 * r;
-		int error = 0;
+	bool doubleBuffer = _doubleBuffer;
+	beginEdit();
+	if (doubleBuffer)
+		setDoubleBuffer(false);
+	_bgList = NULL;
+	_bgPoints = 0;
+	_dynList = XY_List;
+	_dynCapacity = XY_ListCapacity;
+	plotStart();
+	plotEnd();
+	if (doubleBuffer)
+		setDoubleBuffer(true);
+	commitEdit();
+}
 
-		int xHalfWayLimit = int(float(r) * .707106);//xHalfWayLimit = xr * sin(45Deg)
-		int yHalfWayLimit = int(float(r) * .707106);//yHalfWayLimit = xr * cos(45Deg)
-		while (y >= 0) {
-			//if (SkipCount<=0 || y <= 0){
-			if (SkipCount <= 0 || y <= 0) {
-				if (arcSegment & arc0 && x >= xHalfWayLimit)
-					plotPoint(xc - x, yc + y);		//Segment 0
-				if (arcSegment & arc1 && x < xHalfWayLimit)
-					plotPoint(xc - x, yc + y);		//Segment 1
-				if (arcSegment & arc2 && x < xHalfWayLimit)
-					plotPoint(xc + x, yc + y);		//Segment 2 
-				if (arcSegment & arc3 && y <= yHalfWayLimit)
-					plotPoint(xc + x, yc + y);	//Segment 3
-				if (arcSegment & arc4 && y < yHalfWayLimit)
-					plotPoint(xc + x, yc - y);		//Segment 4
-				if (arcSegment & arc5 && x <= xHalfWayLimit)
-					plotPoint(xc + x, yc - y);		//Segment 5
-				if (arcSegment & arc6 && x <= xHalfWayLimit)
-					plotPoint(xc - x, yc - y);		//Segment 6
-				if (arcSegment & arc7 && x > xHalfWayLimit)
-					plotPoint(xc - x, yc - y);		//Segment 7
+int XYscope::getBackgroundPoints() {
+	//	Routine to retrieve the size of the background layer.
+	//
+	//	Returns: Number of points in the background (0 = no background layer)
+	//
+	//	20261017 Ver 0.0				First cut
 
-				SkipCount = _graphDensity;
-			} else
-				SkipCount--;
+	return _bgPoints;
+}
 
-			error = 2 * (delta + y) - 1;
-			if ((delta < 0) && (error <= 0)) {
-				++x;
-				delta += 2 * x + 1;
-				continue;
-			}
-			error = 2 * (delta - x) - 1;
+int XYscope::addStaticList(const pointList *list, int points) {
+	//	Routine to add a precomputed, constant point list (logo, graticule, fixed artwork...) to the display.
+	//	Every refresh, the DMA sends the list straight from where it lives to the DACs, chained after the
+	//	dynamic list.  Declared 'const', the list stays in FLASH: it uses no SRAM and no CPU time to plot.
+	//
+	//	Typical usage (use XY_POINT so the X/Y routing flags are applied):
+	//		const XYscope::pointList triangle[] = {
+	//			XY_POINT(1000, 1000), XY_POINT(1500, 2000), XY_POINT(2000, 1000), XY_POINT(1000, 1000)
+	//		};
+	//		...
+	//		int tri = XYscope.addStaticList(triangle, sizeof(triangle) / sizeof(triangle[0]));
+	//
+	//	Calling parameters:
+	//		list		Points to be painted.  MUST stay valid (and unchanged) until removeStaticList().
+	//		points		Number of points in list (max 32767)
+	//
+	//	Returns:	Handle for removeStaticList(), or -1 (and plotErr set) when all MaxStaticLists slots are in use.
+	//
+	//	Notes:
+	//	1)	Static lists are painted in the order they were added, after the dynamic list (and background layer).
+	//		The beam moves straight (unblanked) from the end of one list to the start of the next.
+	//	2)	Static lists stay on screen across plotStart()/plotClear().
+	//
+	//	20261017 Ver 0.0				First cut
 
-			if (delta > 0 && error > 0) {
-				--y;
-				delta += 1 - 2 * y;
-				continue;
-			}
-			++x;
-			delta += 2 * (x - y);
-			--y;
+	if (list == NULL || points <= 0 || points > 32767) {
+		plotErr = 1;
+		return -1;
+	}
+	for (int i = 0; i < MaxStaticLists; i++) {
+		if (_staticList[i].points == 0) {
+			beginEdit();		//The ISR reads the slot table when it builds the chain
+			_staticList[i].list = list;
+			_staticList[i].points = points;
+			_staticPoints += points;
+			commitEdit();
+			return i;
 		}
 	}
-	return;
+	plotErr = 1;
+	return -1;
 }
 
-void XYscope::plotEllipse(int xc, int yc, int xr, int yr) {
-	//	Routine for horizontal ELLIPSE plotting.
-	//		Algorithm implementation/starting code base from: 
-	//			https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
-	//			Also see: http://members.chello.at/~easyfilter/bresenham.html 
-	//	Calling parameters:
-	//		xc, yc	Coordinate of point center of ellipse to be plotted.  
-	//				Valid Range:  0<= x0 <= 4095, 0<= y0 <= 4095
+void XYscope::removeStaticList(int handle) {
+	//	Routine to stop painting a static list.  Once it returns, the list is no longer read by the DMA.
 	//
-	//		xr, yr	X-Radius of ellipse, Y-radius of ellipse   
-	//				Valid Range:  0<= xr <= 4095, 0<= yr <= 4095	//
+	//	Calling parameters:
+	//		handle	Value returned by addStaticList()
 	//
 	//	Returns: NOTHING
 	//
-	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
-	//
-	//	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
-	//				Negative coordinates or coordinate values >4095 will be masked to 12 bits and will
-	//				be folded-over the edges of the valid plot area which is (x,y) = (0 to 4095, 0 to 4095).	
+	//	20261017 Ver 0.0				First cut
+
+	if (handle < 0 || handle >= MaxStaticLists || _staticList[handle].points == 0)
+		return;
+	beginEdit();
+	_staticPoints -= _staticList[handle].points;
+	_staticList[handle].points = 0;
+	commitEdit();
+}
+
+bool XYscope::addListChunk(pointList *chunk, int points) {
+	//	Routine to give the list more RAM without one big contiguous reservation.  Once XY_List (or the
+	//	overlay area after a background layer) is full, plotting continues into the chunks, in the order
+	//	they were added.  Every refresh, the DMA sends the list as a chain of blocks (scatter-gather), so
+	//	the chunks can be anywhere in RAM: left over global arrays, malloc() blocks, etc.
 	//
-	//				NOTE: Routine will set plotErr to non-zero value and skip plotting if error in passed parameters are detected.
+	//	Typical usage:
+	//		XYscopeSized<6000> XYscope;
+	//		XYscope::pointList moreRam[4000];
+	//		...
+	//		XYscope.addListChunk(moreRam, 4000);	//List can now hold 10000 points
 	//
-	//	20170424	Ver 0.0	E.Andrews	First cut, irratic operation
-	//	20170427	Ver 1.0	E.Andrews	This version uses some DOUBLE variables to correct ocasional mishapen ellipses!)
-	//	20170617 	Ver 1.1	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+	//	Calling parameters:
+	//		chunk	RAM for the extra points.  MUST stay valid until clearListChunks().
+	//		points	Number of points in chunk (1 to 32767)
+	//
+	//	Returns:	true = chunk added, false = chunk table (MaxListChunks) full or bad parameters
+	//
+	//	Notes:
+	//	1)	MaxBuffSize is raised by 'points', so the extra room can actually be used.
+	//	2)	Chunks are only used in single buffer mode; the double buffer banks stay inside XY_List.
+	//	3)	Add chunks before plotting; the new room is available from the next plotStart().
+	//
+	//	20261017 Ver 0.0				First cut
+
+	if (chunk == NULL || points <= 0 || points > 32767 || _chunkCount >= MaxListChunks)
+		return false;
+	beginEdit();			//The ISR reads the chunk table when it builds the chain
+	_chunk[_chunkCount].list = chunk;
+	_chunk[_chunkCount].points = points;
+	_chunkCount++;
+	_chunkPoints += points;
+	MaxBuffSize += points;
+	commitEdit();
+	return true;
+}
 
-	//Adjust passed coordinates to algorithm needs 
+void XYscope::clearListChunks() {
+	//	Routine to stop using all extra chunks added by addListChunk().  If the list currently continues
+	//	into a chunk, it is cut back to what fits in XY_List.  Once this returns, the chunks are no longer
+	//	read by the DMA and may be reused.
+	//
+	//	Calling parameters: NONE
+	//	Returns: NOTHING
+	//
+	//	20261017 Ver 0.0				First cut
 
-	plotEllipse(xc, yc, xr, yr, 255);//Call standard plotEllipse function with all segments=ON (255)
-	return;
+	beginEdit();
+	MaxBuffSize -= _chunkPoints;
+	_chunkCount = 0;
+	_chunkPoints = 0;
+	setPlotLimit();
+	if (!_doubleBuffer && XYlistEnd > _plotLimit + 1)
+		XYlistEnd = _plotLimit + 1;
+	commitEdit();
 }
 
-void XYscope::plotEllipseBres(int xc, int yc, int xr, int yr,
-		uint8_t arcSegment)
-//TODO REMOVE routine
-		{
-	//	Routine for horizontal ELLIPSE plotting.
-	//		Breseham Algorithm implementation/starting code base from:
-	//			https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
-	//			Also see: http://members.chello.at/~easyfilter/bresenham.html
+void XYscope::setDisplayProgram(const uint16_t *program) {
+	//	Routine to paint a "display program" every refresh.  A display program is a compact list of figure
+	//	opcodes (line, circle, ellipse, point) plus jump/call/return, much like the stroke opcodes of the
+	//	vector font ROM.  It is NOT turned into points ahead of time: while the DMA sends one small staging
+	//	buffer to the DACs, the DACC interrupt generates the next points of the program into the other
+	//	one.  A scene can therefore have many times more points than fit in SRAM.  The program is painted
+	//	after the dynamic list (and background layer, static lists).
+	//
+	//	Typical usage (see the XYP_... macros in XYscope.h):
+	//		const uint16_t star[] = {			//Subroutine at word 0: a small cross, relative to the origin
+	//			XYP_LINE(-50, 0, 50, 0), XYP_LINE(0, -50, 0, 50), XYP_RET };
+	//		const uint16_t sky[] = {
+	//			XYP_CIRCLE(2047, 2047, 1800),
+	//			XYP_ARC(2047, 2047, 1600, 0x0f),	//Upper half only
+	//			XYP_ORIGIN(500, 700), XYP_CALL(0), ...	//Addresses are word indexes into THIS array
+	//			XYP_HALT };
+	//		...
+	//		XYscope.setDisplayProgram(sky);
+	//
 	//	Calling parameters:
-	//		xc, yc	Coordinate of point center of ellipse to be plotted.
-	//				Valid Range:  0<= x0 <= 4095, 0<= y0 <= 4095
+	//		program		Opcodes, ending with XYP_HALT.  MUST stay valid (and unchanged) until replaced or
+	//					setDisplayProgram(NULL).  Declared 'const' it lives in FLASH.
 	//
-	//		xr, yr	X-Radius of ellipse, Y-radius of ellipse
-	//				Valid Range:  0<= xr <= 4095, 0<= yr <= 4095
+	//	Returns: NOTHING
 	//
-	//		arcSegment	8-bit code corresponding to the arc segments that are to be drawn.
-	//					Bit = 1 means Draw arc segment, Bit = 0 means do NOT draw arc segment (Skip it!)
-	//					Any combination from 1 to 8 segments may be spec'd.
-	/*
-	 1  |	 2
-	 \	  |   /
-	 0  \  |  /  3
-	 -------+-------
-	 7  /  |  \   4
-	 /   |   \
-						   6  |  5
-	 */
+	//	Notes:
+	//	1)	Coordinates are 16 bit signed, relative to the origin set by XYP_ORIGIN (0,0 at the start of every
+	//		refresh).  XYP_CALL saves the origin and XYP_RET restores it, so a subroutine can be drawn at
+	//		several places.  Calls nest ProgramStackDepth deep.
+	//	2)	Dot spacing follows setGraphicsIntensity() unless the program sets it with XYP_DENSITY.
+	//	3)	Everything after the last complete XYP_HALT, an unknown opcode, a call too deep or more than
+	//		MaxProgramOps opcodes in one refresh ends the program for that refresh.
+	//	4)	Point generation runs inside the DACC interrupt, roughly every StagePoints points.  The ISR must
+	//		keep up with the DMA clock; at very high DMA clock rates, gaps (a static beam) can show up
+	//		between staging buffers.
+	//	5)	Use getProgramPoints() (or autoSetRefreshTime()) to check that the program fits in the refresh period.
+	//	6)	XYP_ARC/XYP_ELLIPSE_ARC draw the arc segments picked by a mask, as the CIR/ELP strokes of the vector
+	//		font and plotCircle(xc, yc, r, arcSegment) do (same start point, direction and segment numbering).
+	//		The generator still steps through the skipped segments, so they cost ISR time but no DMA time.
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Arc segment mask on circles and ellipses
+
+	beginEdit();			//The ISR reads the program while it is generating points
+	_stage = stageBuffers;
+	_program = program;
+	if (program == NULL)
+		_genLastPoints = 0;
+	commitEdit();
+}
+
+uint32_t XYscope::getProgramPoints() {
+	//	Routine to get the number of points the display program generated during the last refresh.
 	//
-	//	Returns: NOTHING
+	//	Calling parameters: NONE
+	//	Returns:	Points (0 = no display program)
 	//
-	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//	20261017 Ver 0.0				First cut
+
+	return _genLastPoints;
+}
+
+void XYscope::setPackedList(uint8_t *store, int bytes) {
+	//	Routine to turn the packed list ON or OFF.  While it is ON, the plot routines do not write 4 byte
+	//	points into the list: they encode each point as a small step from the last one into 'store'.
+	//	Points along lines, circles, ellipses and text strokes take one byte or less (a straight line with a
+	//	constant step takes one byte per 64 points), so a store holds about 3 to 4 times the points of a list
+	//	of the same size.  At refresh time, the DACC ISR expands the store into the staging buffers while the
+	//	DMA sends them (see setDisplayProgram), after the list itself.
+	//
+	//	Typical usage:
+	//		uint8_t packed[20000];
+	//		...
+	//		XYscope.setPackedList(packed, sizeof(packed));
+	//		XYscope.plotStart();			//Sync pulse goes into the list, everything else into 'packed'
+	//		XYscope.plotCircle(2047, 2047, 1500);
+	//		...
 	//
-	//	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
-	//				Negative coordinates or coordinate values >4095 will be masked to 12 bits and will
-	//				be folded-over the edges of the valid plot area which is (x,y) = (0 to 4095, 0 to 4095).
+	//	Calling parameters:
+	//		store	Byte buffer for the packed points.  MUST stay valid until setPackedList(NULL).
+	//		bytes	Size of store
 	//
-	//				NOTE: Routine will set plotErr to non-zero value and skip plotting if error in passed parameters are detected.
+	//	Returns: NOTHING.  The store is empty; it fills from the next plot call on.
 	//
-	//	20170424	Ver 0.0	E.Andrews	First cut, Works but had erratic operation
-	//	20170427	Ver 1.0	E.Andrews	This version uses some DOUBLE variables to correct occasional mis-shaoed ellipses!
-	//	20170617 	Ver 1.1	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
-	plotErr = 0;		//Initialize plotErr to FALSE (No errors)...
-	//Check to see if passed coordinates fully fit into the display range
-	int x0 = xc - xr;//x0,y0 = lower left hand corner of a rectangle bounding the totality of the Ellipse
-	int y0 = yc - yr;
-	int x1 = xc + xr;//x1,y1 = upper right hand corner of a rectangle bounding the totality of the Ellipse
-	int y1 = yc + yr;
-	short px, py;
-	//==========Check to be sure that the figure is fully on-screen; Set PlotErr flag if NO
-	if ((x0 > 4095) || (x0 < 0) || (x1 > 4095) || (x1 < 0))
-		plotErr = 1;
-	if ((y0 > 4095) || (y0 < 0) || (y1 > 4095) || (y1 < 0))
-		plotErr = 1;
+	//	Notes:
+	//	1)	plotStart()/plotClear() empty the store.
+	//	2)	Segments, scene nodes, plotEnd() and double buffering work on the list only; they do not see packed
+	//		points.  Use beginEdit()/commitEdit() around a redraw to keep the ISR from painting a half-drawn store.
+	//	3)	Decoding runs inside the DACC interrupt, a few instructions per point.
+	//
+	//	20261017 Ver 0.0				First cut
 
-	//==========Skip drawing if passed parameters are faulted
-	if (plotErr == 0) {
-		int SkipCount = 0;	//Initialize the point-skip counter...
-		double width = 1 * xr;
-		int height = 1 * yr;
-		//  The following variables must be DOUBLE or ellipse shape can
-		//	be plotted badly deformed due to value over-flows
-		//  Note: On Arduino DUE, sizeof(double)=8 bytes
-		double a2 = width * width;
-		double b2 = height * height;
-		double fa2 = 4 * a2, fb2 = 4 * b2;
-		double x, y, sigma;
-		//Calculate segment 'HalfWayLimits'
-		int xHalfWayLimit = xr * .707106;	//xHalfWayLimit = xr * sin(45Deg)
-		int yHalfWayLimit = yr * .707106;	//yHalfWayLimit = xr * cos(45Deg)
-		/* first half */
-		for (x = 0, y = height, sigma = 2 * b2 + a2 * (1 - 2 * height);
-				b2 * x <= a2 * y; x++) {
-			if (SkipCount <= 0) {//Only plot the point if the arcsegment flag bit=1, otherwise, skip the point
+	beginEdit();			//The ISR reads the store while it is painting
+	_stage = stageBuffers;
+	_packStore = (bytes > 0) ? store : NULL;
+	_packCapacity = (_packStore != NULL) ? bytes : 0;
+	packReset();
+	commitEdit();
+}
 
-				if (arcSegment & arc0 && x > xHalfWayLimit) {
-					//plotPoint(xc - x, yc + y);		//Segment 0
-					px = xc - x;
-					py = yc + y;
-					plotPoint(px, py);
-					//Serial.print ("0, 0, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+int XYscope::getPackedBytes() {
+	//	Routine to get the number of bytes used in the packed store.
+	//
+	//	Calling parameters: NONE
+	//	Returns:	Bytes (0 = packed list off or empty)
+	//
+	//	20261017 Ver 0.0				First cut
 
-				if (arcSegment & arc1 && x <= xHalfWayLimit) {
-					//plotPoint(xc - x, yc + y);		//Segment 1
-					px = xc - x;
-					py = yc + y;
-					plotPoint(px, py);
-					//Serial.print ("0, 1, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+	return _packBytes;
+}
 
-				if (arcSegment & arc2 && x < xHalfWayLimit) {
-					//plotPoint(xc + x, yc + y);		//Segment 2
-					px = xc + x;
-					py = yc + y;
-					plotPoint(px, py);
-					//Serial.print ("0, 2, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+int XYscope::getPackedPoints() {
+	//	Routine to get the number of points in the packed store.
+	//
+	//	Calling parameters: NONE
+	//	Returns:	Points (0 = packed list off or empty)
+	//
+	//	20261017 Ver 0.0				First cut
 
-				if (arcSegment & arc3 && y <= yHalfWayLimit) {
-					//plotPoint(xc + x, yc + y);		//Segment 3					px=xc+x; py=yc+y;
-					px = xc + x;
-					py = yc + y;
-					plotPoint(px, py);
-					//Serial.print ("0, 3, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+	return _packPoints;
+}
 
-				if (arcSegment & arc4 && y < yHalfWayLimit) {
-					//plotPoint(xc + x, yc - y);		//Segment 4
-					px = xc + x;
-					py = yc - y;
-					plotPoint(px, py);
-					//Serial.print ("0, 4, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+void XYscope::streamBegin(pointList *ring, int points) {
+	//	Routine to switch from refreshing the list to STREAMING: points queued with streamPoint() are sent to
+	//	the DACs once, in order, at the DMA clock rate, for as long as the sketch keeps them coming.  The DMA
+	//	drains the ring in blocks of up to StreamBlockPoints, chained through the PDC next registers, so there
+	//	is no gap between blocks.  Use it for continuous waveforms, "pen plotter" style output or data
+	//	streams far longer than any buffer.
+	//
+	//	Typical usage:
+	//		XYscope::pointList ring[2048];
+	//		...
+	//		XYscope.streamBegin(ring, 2048);
+	//		...
+	//		while (!XYscope.streamPoint(x, y))	//In loop(): ring full, wait for room
+	//			;
+	//
+	//	Calling parameters:
+	//		ring	Ring buffer RAM.  MUST stay valid until streamEnd().
+	//		points	Size of ring (2 to 32767).  One slot is always kept free.
+	//
+	//	Returns: NOTHING (does nothing if the parameters are bad)
+	//
+	//	Notes:
+	//	1)	UNDERRUN: when the ring runs empty, the DMA sends a filler block (StreamFillerPoints copies of the
+	//		last point) with the beam blanked, and output resumes unblanked as soon as points are queued
+	//		again.  The blanking pin follows the blocks, so it can be up to one ISR latency off.
+	//	2)	The refresh timer keeps running but its interrupts are ignored; frame counting, frame callbacks and
+	//		the screen saver do not apply while streaming.
+	//	3)	See setStreamCallback() for low/high watermark and underrun events.
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				PDC count per point follows the transfer mode (see setFullWordMode)
+	//	20261017 Ver 0.2				Blanking pin driven through the blank timer (xyHalBlankNow)
+	//	20261017 Ver 0.3				Apply a pending present() (no refresh will do it while streaming)
+
+	if (ring == NULL || points < 2 || points > 32767)
+		return;
+	beginEdit();			//Let a refresh that is underway finish; no new one can start
+	swapBuffers();			//The DMA is idle: a presented BACK buffer becomes the FRONT buffer now
+	xyHalDmaIrqDisable(XYHAL_ENDTX | XYHAL_TXBUFE);
+	_stage = stageBuffers;	//Filler block
+	_ringSize = points;
+	_ringHead = _ringTail = _ringSend = 0;
+	_ringLast.X = 0 | X_flag;
+	_ringLast.Y = 0 | Y_flag;
+	_ringInFlight[0] = _ringInFlight[1] = 0;
+	_ringLowArmed = _ringHighArmed = true;
+	_ringUnderruns = 0;
+	for (int i = 0; i < StreamFillerPoints; i++)
+		_stage[i] = _ringLast;
+	_ringBlanked = true;
+	xyHalBlankNow(true);
+	_ringList = ring;
+	xyHalDmaStart(_stage, StreamFillerPoints * _dmaUnitsPerPoint);	//Start with the filler; data follows as soon as it is queued
+	const pointList *list;
+	_ringInFlight[1] = streamTake(list);
+	xyHalDmaQueueNext(list, (_ringInFlight[1] ? _ringInFlight[1] : StreamFillerPoints) * _dmaUnitsPerPoint);
+	xyHalDmaIrqEnable(XYHAL_ENDTX);
+	commitEdit();
+}
 
-				if (arcSegment & arc5 && x <= xHalfWayLimit) {
-					//plotPoint(xc + x, yc - y);		//Segment 5
-					px = xc + x;
-					py = yc - y;
-					plotPoint(px, py);
-					//Serial.print ("0, 5, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+void XYscope::streamEnd() {
+	//	Routine to stop streaming.  Points still in the ring are dropped; the list is painted again from the
+	//	next refresh interrupt on.
+	//
+	//	Calling parameters: NONE
+	//	Returns: NOTHING
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Blanking pin driven through the blank timer (xyHalBlankNow)
+	//	20261017 Ver 0.2				Restart the event driven refresh scheduler
+	//	20261018 Ver 0.3				First frame once the blocks still in the PDC are out
+
+	if (_ringList == NULL)
+		return;
+	xyHalDmaIrqDisable(XYHAL_ENDTX | XYHAL_TXBUFE);
+	_ringList = NULL;
+	xyHalBlankNow(true);
+	if (_eventRefresh) {		//Start over once the DMA is idle, nothing left waiting on dacHandler()
+		int points = (_ringInFlight[0] ? _ringInFlight[0] : StreamFillerPoints)
+				+ (_ringInFlight[1] ? _ringInFlight[1] : StreamFillerPoints);
+		_ringDrain_us = uint32_t(points * 2 * DmaClkPeriod_us) + 1;
+		_refreshPending = false;
+		xyHalRefreshTimerOnce(_ringDrain_us > ActiveRefreshPeriod_us ? _ringDrain_us : ActiveRefreshPeriod_us);
+	}
+}
 
-				if (arcSegment & arc6 && x < xHalfWayLimit) {
-					//plotPoint(xc - x, yc - y);		//Segment 6
-					px = xc - x;
-					py = yc - y;
-					plotPoint(px, py);
-					//Serial.print ("0, 6, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
-
-				if (arcSegment & arc7 && x >= xHalfWayLimit) {
-					//plotPoint(xc - x, yc - y);		//Segment 7
-					px = xc - x;
-					py = yc - y;
-					plotPoint(px, py);
-					//Serial.print ("0, 7, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
-
-				SkipCount = _graphDensity;
-				;
-			} else
-				SkipCount--;
-			if (sigma >= 0) {
-				sigma += fa2 * (1 - y);
-				y--;
-			}
-			sigma += b2 * ((4 * x) + 6);
-		}
+bool XYscope::streamPoint(int x0, int y0) {
+	//	Routine to queue one point for streaming (see streamBegin).
+	//
+	//	Calling parameters:
+	//		x0, y0	Coordinate of point.  Valid Range:  0<= x0 <= 4095, 0<= y0 <= 4095
+	//
+	//	Returns:	true = queued, false = ring full (or not streaming); try again later
+	//
+	//	20261017 Ver 0.0				First cut
+
+	pointList *ring = _ringList;
+	if (ring == NULL)
+		return false;
+	int head = _ringHead;
+	int next = (head + 1 < _ringSize) ? head + 1 : 0;
+	if (next == _ringTail)
+		return false;
+	ring[head].X = (x0 & 0xfff) | X_flag;
+	ring[head].Y = (y0 & 0xfff) | Y_flag;
+	xyHalMemoryBarrier();	//Point is in RAM before the ISR can see it
+	_ringHead = next;
+
+	int level = getStreamLevel();
+	if (level > _ringLowMark)
+		_ringLowArmed = true;
+	void (*streamCallback)(uint8_t, int) = _streamCallback;
+	if (level >= _ringHighMark && _ringHighArmed) {
+		_ringHighArmed = false;
+		if (streamCallback != NULL)
+			streamCallback(streamHighWater, level);
+	}
+	return true;
+}
 
-		/* second half */
-		//SkipCount=0;
-		//int X, Y;
-		for (x = width, y = 0, sigma = 2 * a2 + b2 * (1 - 2 * width);
-				a2 * y <= b2 * x; y++) {
-			if (SkipCount <= 0) {
+int XYscope::getStreamLevel() {
+	//	Routine to get the number of points queued for streaming and not yet sent to the DACs.
+	//
+	//	Calling parameters: NONE
+	//	Returns:	Points (0 when not streaming)
+	//
+	//	20261017 Ver 0.0				First cut
 
-				if (arcSegment & arc0 && x > xHalfWayLimit) {
-					//plotPoint(xc - x, yc + y);		//Segment 0
-					px = xc - x;
-					py = yc + y;
-					plotPoint(px, py);
-					//Serial.print ("1, 0, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+	if (_ringList == NULL)
+		return 0;
+	int level = _ringHead - _ringTail;
+	return level < 0 ? level + _ringSize : level;
+}
 
-				if (arcSegment & arc1 && x <= xHalfWayLimit) {
-					//plotPoint(xc - x, yc + y);		//Segment 1
-					px = xc - x;
-					py = yc + y;
-					plotPoint(px, py);
-					//Serial.print ("1, 1, ");Serial.print(px); Serial.print(", "); Serial.println(py);
-				}
+int XYscope::getStreamSpace() {
+	//	Routine to get the number of points that streamPoint() can queue right now.
+	//
+	//	Calling parameters: NONE
+	//	Returns:	Points (0 when not streaming)
+	//
+	//	20261017 Ver 0.0				First cut
 
-				if (arcSegment & arc2 && x < xHalfWayLimit) {
-					//plotPoint(xc + x, yc + y);		//Segment 2
-					px = xc + x;
-					py = yc + y;
-					plotPoint(px, py);
-					//Serial.print ("1, 2, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+	if (_ringList == NULL)
+		return 0;
+	return _ringSize - 1 - getStreamLevel();
+}
 
-				if (arcSegment & arc3 && y <= yHalfWayLimit) {
-					//plotPoint(xc + x, yc + y);		//Segment 3
-					px = xc + x;
-					py = yc + y;
-					plotPoint(px, py);
-					//Serial.print ("1, 3, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+uint32_t XYscope::getStreamUnderruns() {
+	//	Routine to get the number of times the ring ran empty while streaming (output was blanked until
+	//	more points were queued).  Reset by streamBegin().
+	//
+	//	Calling parameters: NONE
+	//	Returns:	Underrun count
+	//
+	//	20261017 Ver 0.0				First cut
 
-				if (arcSegment & arc4 && y < yHalfWayLimit) {
-					//plotPoint(xc + x, yc - y);		//Segment 4
-					px = xc + x;
-					py = yc - y;
-					plotPoint(px, py);
-					//Serial.print ("1, 4, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+	return _ringUnderruns;
+}
 
-				if (arcSegment & arc5 && x <= xHalfWayLimit) {
-					//plotPoint(xc + x, yc - y);		//Segment 5
-					px = xc + x;
-					py = yc - y;
-					plotPoint(px, py);
-					//Serial.print ("1, 5, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+void XYscope::setStreamCallback(void (*streamCallback)(uint8_t event, int level), int lowMark, int highMark) {
+	//	Routine to get told how full the stream ring is, so a producer can throttle itself.
+	//
+	//	Calling parameters:
+	//		streamCallback	Routine called with an event and the ring level (points).  NULL = none.
+	//			streamLowWater	Level dropped to lowMark or below (called from the DACC ISR!)
+	//			streamHighWater	Level reached highMark or above (called from streamPoint())
+	//			streamUnderrun	Ring ran empty; beam is blanked (called from the DACC ISR!)
+	//		lowMark, highMark	Watermarks (points).  Each event fires once, then again only after the
+	//							level has gone back across the mark.
+	//
+	//	Returns: NOTHING
+	//
+	//	20261017 Ver 0.0				First cut
 
-				if (arcSegment & arc6 && x < xHalfWayLimit) {
-					//plotPoint(xc - x, yc - y);		//Segment 6
-					px = xc - x;
-					py = yc - y;
-					plotPoint(px, py);
-					//Serial.print ("1, 6, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+	_ringLowMark = lowMark;
+	_ringHighMark = highMark;
+	_ringLowArmed = _ringHighArmed = true;
+	_streamCallback = streamCallback;
+}
 
-				if (arcSegment & arc7 && x >= xHalfWayLimit) {
-					//plotPoint(xc - x, yc - y);		//Segment 7
-					px = xc - x;
-					py = yc - y;
-					plotPoint(px, py);
-					//Serial.print ("1, 7, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
-				}
+void XYscope::setCommandQueue(plotCommand *queue, int size, uint8_t options) {
+	//	Routine to turn DEFERRED plotting ON or OFF.  While it is ON, plotLine(), plotCircle(), plotEllipse()
+	//	(and so plotRectangle() and text, which are made of them) do not rasterize anything: each call just
+	//	stores a 12 byte command in 'queue'.  flush() then rasterizes the whole batch in one go, at a time of
+	//	the sketch's choosing (idle time, from a frame callback...), and can first optimize the batch:
+	//		cmdCull		Figures that are entirely off screen are dropped (no points, no folded-over garbage)
+	//		cmdReorder	Figures are painted nearest-first (lines may be reversed) to cut beam travel between them
+	//
+	//	Typical usage:
+	//		XYscope::plotCommand queue[200];
+	//		...
+	//		XYscope.setCommandQueue(queue, 200);
+	//		XYscope.plotStart();
+	//		...plot calls (queued)...
+	//		XYscope.flush();				//Rasterize the frame
+	//		XYscope.plotEnd();
+	//
+	//	Calling parameters:
+	//		queue	Command RAM.  MUST stay valid until setCommandQueue(NULL, 0).  NULL = plot immediately again.
+	//		size	Number of commands in queue.  A full queue is flushed automatically.
+	//		options	cmdCull and/or cmdReorder (default: both)
+	//
+	//	Returns: NOTHING (commands still queued are flushed first)
+	//
+	//	Notes:
+	//	1)	Each command keeps the dot spacing (graphics or text intensity) in effect when it was queued.
+	//	2)	plotPoint() and plotPoints() are never queued: their points go into the list right away, so points
+	//		plotted between queued calls always end up BEFORE the figures that flush()/renderStep() add later.
+	//	3)	plotErr reflects the batch when flush() returns, not the individual calls.
+	//	4)	plotStart() drops queued commands.  segmentOpen()/segmentBegin() and scene nodes flush the queue
+	//		first, and segment/scene content is always rasterized right away.
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Note 2 corrected (point order does not depend on cmdReorder)
+
+	flush();
+	_cmdQueue = (size > 0) ? queue : NULL;
+	_cmdSize = (_cmdQueue != NULL) ? size : 0;
+	_cmdOptions = options;
+}
 
-				SkipCount = _graphDensity;
-				;
-			} else
-				SkipCount--;
+int XYscope::flush() {
+	//	Routine to rasterize all queued plot calls (see setCommandQueue) into the list.
+	//
+	//	Calling parameters: NONE
+	//	Returns:	Points added to the list (or packed store)
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				One command at a time through cmdRenderNext() (shared with renderStep)
 
-			if (sigma >= 0) {
-				sigma += fb2 * (1 - x);
-				x--;
-			}
-			sigma += a2 * ((4 * y) + 6);
-		}
-	}
-	return;
+	int startPoints = XYlistEnd + _packPoints;
+	_cmdSuspend++;			//The plot routines called below must rasterize, not queue
+	while (cmdRenderNext())
+		;
+	_cmdSuspend--;
+	return XYlistEnd + _packPoints - startPoints;
 }
 
-void XYscope::plotEllipse(int xc, int yc, int xr, int yr, uint8_t arcSegment) {
-	//	Routine for non-rotated ELLIPSE plotting.
-	//		Algorithm implementation uses standard geometry (not speed optized)
+int XYscope::renderStep(uint32_t budget_us) {
+	//	Routine to rasterize queued plot calls (see setCommandQueue) for about budget_us microseconds, then
+	//	return so loop() can get on with other work (serial commands, sampling...).  Call it again and again
+	//	until it returns 0; the frame is then complete.  Use double buffering so the half-composed frame is
+	//	never on screen:
+	//
+	//		XYscope.setDoubleBuffer(true);
+	//		XYscope.setCommandQueue(queue, 400);
+	//		...
+	//		XYscope.plotStart();
+	//		...queue the whole scene (fast: no rasterizing)...
+	//		//then, in loop():
+	//		if (XYscope.renderStep(500) == 0) {		//Never more than ~0.5ms of plotting per pass of loop()
+	//			XYscope.plotEnd();
+	//			XYscope.present();
+	//		}
 	//
 	//	Calling parameters:
-	//		xc, yc	Coordinate of point center of ellipse to be plotted.
-	//				Valid Range:  0<= x0 <= 4095, 0<= y0 <= 4095
+	//		budget_us	Time slice (microseconds).  At least one command is rasterized per call.
 	//
-	//		xr, yr	X-Radius of ellipse, Y-radius of ellipse
-	//				Valid Range:  0<= xr <= 4095, 0<= yr <= 4095
+	//	Returns:	Commands still queued (0 = done)
 	//
-	//		arcSegment	8-bit code corresponding to the arc segments that are to be drawn.
-	//					Bit = 1 means Draw arc segment, Bit = 0 means do NOT draw arc segment (Skip it!)
-	//					Any combination from 1 to 8 segments may be spec'd.
-	/*
-	 1  |	 2
-	 \	  |   /
-	 0  \  |  /  3
-	 -------+-------
-	 7  /  |  \   4
-	 /   |   \
-						   6  |  5
-	 */
+	//	Notes:
+	//	1)	The renderer stops between commands, so one slice can overrun budget_us by the time of one figure
+	//		(a line or character stroke takes a few microseconds; a full screen circle or ellipse is the worst case).
+	//	2)	cmdCull/cmdReorder work as in flush().  With cmdReorder each step picks the figure nearest to the
+	//		last point plotted, so no up-front sorting pass is needed.
+	//	3)	Commands may still be queued while a frame is being rendered; they are appended to the batch.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	uint32_t start = micros();
+	_cmdSuspend++;
+	while (cmdRenderNext() && micros() - start < budget_us)
+		;
+	_cmdSuspend--;
+	return _cmdCount - _cmdDone;
+}
+
+int XYscope::getQueuedCommands() {
+	//	Routine to get the number of plot calls waiting for flush().
+	//
+	//	Calling parameters: NONE
+	//	Returns:	Queued commands
+	//
+	//	20261017 Ver 0.0				First cut
+
+	return _cmdCount - _cmdDone;
+}
+
+void XYscope::plotPoint(int x0, int y0) {
+	//	Routine for POINT plotting
+	//	Calling parameters:
 	//
+	//		x0, y0	Coordinate of point to be plotted.  
+	//				Valid Range:  0<= x0 <= 4095, 0<= y0 <= 4095
 	//	Returns: NOTHING
 	//
 	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
 	//
-	//	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
-	//				Negative coordinates or coordinate values >4095 will be masked to 12 bits and will
-	//				be folded-over the edges of the valid plot area which is (x,y) = (0 to 4095, 0 to 4095).
-	//
-	//				NOTE: Routine will set plotErr to non-zero value and skip plotting if error in passed parameters are detected.
+	//	20170320 Ver 0.0	E.Andrews	First cut
+	//	20170427 Ver 0.1	E.Andrews	Add plotErr & near end-of-buffer limit logic and check
+	//	20170627 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+	//	20261017 Ver 0.3				Single end-of-buffer compare (limit is computed by plotStart)
+	//	20261017 Ver 0.4				Access list through listPoint() (list may continue into extra chunks)
+	//	20261017 Ver 0.5				Packed list: encode the point into the packed store instead
+	//	20261017 Ver 0.6				Record dropped points in _listFull (level of detail controller)
 	//
-	//	20170424	Ver 0.0	E.Andrews	First cut, Works but had erratic operation
-	//	20170427	Ver 1.0	E.Andrews	This version uses some DOUBLE variables to correct occasional mis-shaoed ellipses!
-	//	20170617 	Ver 1.1	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
-	//	20170907	Ver 2.0 E.Andrews	Abandon Bresenham algorithm for slower floating point approach
-	//									because new approach plots adjacent points and does not take advantage
-	//									of figure symetry.This Allows AGI to run at a higher DMA_CLK freq.
-	const float pi = atan(1) * 4;
-	const float arcAng0 = 0;
-	const float arcAng1 = pi * .25;		// .25 * pi
-	const float arcAng2 = pi * .5;		// .50 * pi
-	const float arcAng3 = pi * .75;		// .75 * pi
-	const float arcAng4 = pi;			//1.00 * pi
-	const float arcAng5 = pi * 1.25;	//1.25 * pi
-	const float arcAng6 = pi * 1.50;	//1.50 * pi
-	const float arcAng7 = pi * 1.75;	//1.75 * pi
-	const float FullCircle = 2 * pi;	//2.00 * pi
-	float circumf;
-	//calculate ellipse circumference
-
-	circumf = FullCircle * sqrt((pow(xr, 2) + pow(yr, 2)) / 2.);
-	//Figure out how many points we will actually be plotting
-	//based on the current graphicsIntensity (_graphicsDensity) setting
-	float numOfPoints = circumf / _graphDensity;
-	//Calc the deltaAng between points
-	float deltaAng = FullCircle / (numOfPoints);
+	if (_screenOnTime_ms != 0)
+		_crtOffTOD_ms = millis() + _screenOnTime_ms;//Update ScreenOff time of day (ms)
+	if (_packStore != NULL) {
+		packPoint(x0, y0);
+		return;
+	}
+	if (XYlistEnd > _plotLimit) {
+		plotErr = 0;//Set plotErr and skip writing point into buffer if we are about to hit the end-of-buffer.
+		_listFull = true;
+	} else {
 
-	float angle;
-	short X, Y;
+		pointList &point = listPoint(XYlistEnd);
+		point.X = (x0 & 0xfff) | X_flag;//Load X Value into EVEN array term
+		point.Y = (y0 & 0xfff) | Y_flag;//Load Y value into ODD array term
 
-	for (angle = 0; angle < FullCircle; angle = angle + deltaAng) {
-		X = int(xc - cos(angle) * xr);
-		Y = int(yc + sin(angle) * yr);
+		XYlistEnd++;							//Increment List Pointer  value 
 
-		//Only plot those segments that are enabled by passed "arcSegment" variable
-		if (arcSegment & arc0 && angle <= arcAng1)
-			plotPoint(X, Y);					//Segment 0
-		if (arcSegment & arc1 && angle > arcAng1 && angle <= arcAng2)
-			plotPoint(X, Y);	//Segment 1
-		if (arcSegment & arc2 && angle > arcAng2 && angle <= arcAng3)
-			plotPoint(X, Y);	//Segment 2
-		if (arcSegment & arc3 && angle > arcAng3 && angle <= arcAng4)
-			plotPoint(X, Y);	//Segment 3
-		if (arcSegment & arc4 && angle > arcAng4 && angle <= arcAng5)
-			plotPoint(X, Y);	//Segment 4
-		if (arcSegment & arc5 && angle > arcAng5 && angle <= arcAng6)
-			plotPoint(X, Y);	//Segment 5
-		if (arcSegment & arc6 && angle > arcAng6 && angle <= arcAng7)
-			plotPoint(X, Y);	//Segment 6
-		if (arcSegment & arc7 && angle > arcAng7)
-			plotPoint(X, Y);						//Segment 7
 	}
+	return;
 }
-/*
 
- void XYscope::plotEllipse_BAK(int xc, int yc, int xr, int yr,uint8_t arcSegment=255)
- //TODO Rework this routine
- {
- //	Routine for horizontal ELLIPSE plotting.
- //		Algorithm implementation/starting code base from: 
- //			https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
- //			Also see: http://members.chello.at/~easyfilter/bresenham.html 
- //	Calling parameters:
- //		xc, yc	Coordinate of point center of ellipse to be plotted.  
- //				Valid Range:  0<= x0 <= 4095, 0<= y0 <= 4095
- //
- //		xr, yr	X-Radius of ellipse, Y-radius of ellipse   
- //				Valid Range:  0<= xr <= 4095, 0<= yr <= 4095
- //	
- //		arcSegment	8-bit code corresponding to the arc segments that are to be drawn.
- //					Bit = 1 means Draw arc segment, Bit = 0 means do NOT draw arc segment (Skip it!)
- //					Any combination from 1 to 8 segments may be spec'd.
+void XYscope::plotPoints(const pointList *list, int points) {
+	//	Routine to copy a table of precomputed points (see XY_POINT and XYscopeConst.h) into the list.
+	//	Points are copied as they are; the table must already carry the X_flag/Y_flag routing bits.
+	//
+	//	Calling parameters:
+	//		list	Table of points
+	//		points	Number of points in table
+	//
+	//	Returns: NOTHING (points that do not fit are dropped, as by plotPoint)
+	//
+	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Packed list: encode the points into the packed store instead
+	//	20261017 Ver 0.2				Record dropped points in _listFull (level of detail controller)
 
- //   \ 1 | 2 /
- //    \  |  /
- //   0 \ | / 3
- //  -----+-------
- //   7  /|\  4
- //     / | \
- //    /6 | 5\
- //
- //
- //	Returns: NOTHING
- //
- //	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
- //
- //	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
- //				Negative coordinates or coordinate values >4095 will be masked to 12 bits and will
- //				be folded-over the edges of the valid plot area which is (x,y) = (0 to 4095, 0 to 4095).	
- //
- //				NOTE: Routine will set plotErr to non-zero value and skip plotting if error in passed parameters are detected.
- //
- //	20170424	Ver 0.0	E.Andrews	First cut, Works but had erratic operation
- //	20170427	Ver 1.0	E.Andrews	This version uses some DOUBLE variables to correct occasional mis-shaoed ellipses!
- //	20170617 	Ver 1.1	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
- 
- plotErr=0;		//Initialize plotErr to FALSE (No errors)...
- //Check to see if passed coordinates fully fit into the display range
- int x0 = xc - xr;	//x0,y0 = lower left hand corner of a rectangle bounding the totality of the Ellipse
- int y0 = yc - yr;
- int x1 = xc + xr;	//x1,y1 = upper right hand corner of a rectangle bounding the totality of the Ellipse
- int y1 = yc + yr;
- //==========Check to be sure that the figure is fully on-screen; Set PlotErr flag if NO
- if ((x0>4095 )||(x0<0)||(x1>4095 )||(x1<0)) plotErr=1;
- if ((y0>4095 )||(y0<0)||(y1>4095 )||(y1<0)) plotErr=1;
-
- //==========Skip drawing if passed parameters are faulted
- if (plotErr==0){
- int SkipCount = 0;	//Initialize the point-skip counter...
- double width=1*xr;
- int height=1*yr;		
- //  The following variables must be DOUBLE or ellipse shape can
- //	be plotted badly deformed due to value over-flows
- //  Note: On Arduino DUE, sizeof(double)=8 bytes
- double a2 = width * width;			
- double b2 = height * height;
- double fa2 = 4 * a2, fb2 = 4 * b2;
- double x, y, sigma;
- //Calculate segment 'HalfWayLimits'
- int xHalfWayLimit=xr*.707106;	//xHalfWayLimit = xr * sin(45Deg)
- int yHalfWayLimit=yr*.707106;	//yHalfWayLimit = xr * cos(45Deg)
- first half
- for (x = 0, y = height, sigma = 2*b2+a2*(1-2*height); b2*x <= a2*y; x++)
- {
- if(SkipCount<=0){	//Only plot the point if the arcsegment flag bit=1, otherwise, skip the point
+	if (_screenOnTime_ms != 0)
+		_crtOffTOD_ms = millis() + _screenOnTime_ms;//Update ScreenOff time of day (ms)
+	if (_packStore != NULL) {
+		for (int i = 0; i < points; i++)
+			packPoint(list[i].X, list[i].Y);	//packPoint drops the routing flags (bits 12-13)
+		return;
+	}
+	int room = _plotLimit + 1 - XYlistEnd;
+	if (points > room) {
+		points = room;
+		_listFull = true;
+	}
+	if (points <= 0)
+		return;
+	int inList = _plotListSize - XYlistEnd;	//Points that still fit in _plotList itself (the rest go into chunks)
+	if (inList > points)
+		inList = points;
+	if (inList > 0) {
+		memcpy(&_plotList[XYlistEnd], list, inList * sizeof(pointList));
+		XYlistEnd += inList;
+	}
+	for (int i = inList > 0 ? inList : 0; i < points; i++)
+		listPoint(XYlistEnd++) = list[i];
+}
 
- if (arcSegment & arc0 && x >  xHalfWayLimit) plotPoint(xc - x, yc + y);		//Segment 0
+void XYscope::plotLine(int x0, int y0, int x1, int y1) {
+	//	BRESSHAM Algorithm for LINE drawing
+	//		Algorithm implementation/starting code base from: http://members.chello.at/~easyfilter/bresenham.html
+	//	Calling parameters:
+	//
+	//		x0, y0	Coordinate of starting point
+	//		x1, y1	Coordinate of ending point
+	//
+	//		  		Density is a COMMON variable that the using sets with setDensity() routine.
+	//				Higher values of Density increases the distance between ajacent plotted points of graphics figures.
+	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
+	//				Valid numbers are 0 to 100.  Note: depending upon size & focus of CRT, values more ~50 shows
+	//				cause lines of circles and vectors to begin to appear as dotted lines.
+	//	Returns: NOTHING
+	//
+	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//
+	//	20170321 Ver 0.1	E.Andrews	First cut
+	//	20170617 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+	//	20261017 Ver 0.3				Queue the call when a command queue is set (see setCommandQueue)
+	//
+	if (cmdQueue(cmdLine, x0, y0, x1, y1, 0))
+		return;
+	plotErr = 0;
+	int lastPointX, lastPointY;
+	int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+	int dy = abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+	int err = (dx > dy ? dx : -dy) / 2, e2;
+	int SkipCount = 0;
+	for (;;) {
+		if (SkipCount <= 0)	//|| (x0 == x1 && y0 == y1) )	//should we skip actualling putting point to the screen?
+				{
+			plotPoint(x0, y0);
+			lastPointX = x0;		//Save and hold the last point plotted
+			lastPointY = y0;
+			SkipCount = _graphDensity;
+		} else {
+			SkipCount--;//The point is to be skipped so we don't need to actually send the point to the screen buffer
+			//Just decrement Skip Point Counter till it gets to Zero, then plot the point
+		}
 
- if (arcSegment & arc1 && x <= xHalfWayLimit) plotPoint(xc - x, yc + y);		//Segment 1
+		if (x0 == x1 && y0 == y1) {
+			//Force a plot at the endpoint to 'finish the line' if the end point was not previously plotted
+			if (lastPointX != x1 && lastPointY != y1)
+				plotPoint(x1, y1);
+			break;
+		}
+		e2 = err;
+		if (e2 > -dx) {
+			err -= dy;
+			x0 += sx;
+		}
+		if (e2 < dy) {
+			err += dx;
+			y0 += sy;
+		}
+	}
 
- if (arcSegment & arc2 && x < xHalfWayLimit)  plotPoint(xc + x, yc + y);		//Segment 2 
+	return;
+}
 
- if (arcSegment & arc3 && y <= yHalfWayLimit) plotPoint(xc + x, yc + y);		//Segment 3
+void XYscope::plotRectangle(int x0, int y0, int x1, int y1) {
+	//	Plots a RECTANGLE LINE drawing
+	//	
+	//	Calling parameters:
+	//
+	//		x0, y0	Coordinate of starting point
+	//		x1, y1	Coordinate of ending point
+	//
+	//		  		Density is a COMMON variable that the using sets with setDensity() routine.
+	//				Higher values of Density increases the distance between ajacent plotted points of graphics figures.
+	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
+	//				Valid numbers are 0 to 100.  Note: depending upon size & focus of CRT, values more ~50 shows
+	//				cause lines of circles and vectors to begin to appear as dotted lines.
+	//
+	//	Returns: NOTHING
+	//
+	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//
+	//	20170424 Ver 0.0	E.Andrews	First cut
+	//	20170617 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+	//	
 
- if (arcSegment & arc4 && y <  yHalfWayLimit) plotPoint(xc + x, yc - y);		//Segment 4
+	plotErr = 0;
+	plotLine(x0, y0, x1, y0);	//Top horizontal line
+	plotLine(x1, y0, x1, y1);	//Right verticle line
+	plotLine(x1, y1, x0, y1);	//Bottom horizontal line
+	plotLine(x0, y1, x0, y0);	//Left verticle line
 
- if (arcSegment & arc5 && x <= xHalfWayLimit) plotPoint(xc + x, yc - y);		//Segment 5
+	return;
+}
 
- if (arcSegment & arc6 && x <  xHalfWayLimit) plotPoint(xc - x, yc - y);		//Segment 6
+void XYscope::plotCircle(int xc, int yc, int r) {
+	//	Routine for CIRCLE plotting.  Basic algorithm implementation/starting code base from: 
+	//	https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
+	//
+	//	Calling parameters:
+	//		ix		Array pointer into aaAudio.dacBuffer16() where X & Y point will be put.
+	//
+	//		xc, yc	Coordinate of point center of circle to be plotted.  
+	//				Valid Range:  0<= xc <= 4095, 0<= yc <= 4095
+	//
+	//		r		Radius of circle   
+	//
+	//	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
+	//				Caller should take care so that center - radius values do not exceed 4095.
+	//				Negative or coordinate values >4095 will be masked to 12 bits and will
+	//				fold-over the edges of the valid plot area (x,y) = (0 to 4095, 0 to 4095).
+	//
+	//				NOTE: Routine will set plotErr >0 & skip plotting if passed parameter errors are detected.
+	//	Returns: NOTHING
+	//
+	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//
+	//	20170322 Ver 0.0	E.Andrews	First cut
+	//	20170427 Ver 1.0	E.Andrews	Rework to improve shape
+	//	20170617 Ver 2.0	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+	//	20170619 Ver 2.1	E.Andrews	Make this routine run in four passes to improve plot quality at high DMA clock speeds
+	//	20261017 Ver 2.2				Queue the call when a command queue is set (see setCommandQueue)
+	//
 
- if (arcSegment & arc7 && x >= xHalfWayLimit) plotPoint(xc - x, yc - y);		//Segment 7
- 
- SkipCount=_graphDensity;;
- } else SkipCount--;
- if (sigma >= 0)
- {
- sigma += fa2 * (1 - y);
- y--;
- }
- sigma += b2 * ((4 * x) + 6);
- }
+	if (cmdQueue(cmdCircle, xc, yc, r, 0, 0))
+		return;
 
- second half
- //SkipCount=0;
- for (x = width, y = 0, sigma = 2*a2+b2*(1-2*width); a2*y <= b2*x; y++)
- {
- if(SkipCount<=0){
+	//plotCircle(xc, yc, r,255);
+	int arcSegment = 255;
 
- if (arcSegment & arc0 && x >  xHalfWayLimit) plotPoint(xc - x, yc + y);		//Segment 0
+	plotErr = 0;
+	int SkipCount = 0;
+	uint8_t pass = 0;
 
- if (arcSegment & arc1 && x <= xHalfWayLimit) plotPoint(xc - x, yc + y);		//Segment 1
+	//==========Check to be sure that the figure is fully on-screen
+	if ((xc + r > 4095) || (xc - r < 0))
+		plotErr = 1;
+	if ((yc + r > 4095) || (yc - r < 0))
+		plotErr = 1;
+	//==========Skip drawing if figure is faulted
+	if (plotErr == 0) {
 
- if (arcSegment & arc2 && x < xHalfWayLimit)  plotPoint(xc + x, yc + y);		//Segment 2 
+		int x, y, delta, error;
+		for (uint8_t loopCnt = 0; loopCnt < 4; loopCnt++) {	//Although this is 4X slower, it orders the points in a way that will improve plot quality
 
- if (arcSegment & arc3 && y <= yHalfWayLimit) plotPoint(xc + x, yc + y);		//Segment 3
+			x = 0;
+			y = r;	//radius
+			delta = 2 - 2 * r;
+			error = 0;
+			int xHalfWayLimit = int(float(r) * .707106);//xHalfWayLimit = xr * sin(45Deg)
+			int yHalfWayLimit = int(float(r) * .707106);//yHalfWayLimit = xr * cos(45Deg)
 
- if (arcSegment & arc4 && y <  yHalfWayLimit) plotPoint(xc + x, yc - y);		//Segment 4
+			while (y >= 0) {
+				if (SkipCount == 0 || y <= 0) {	//Actually plot a point whenever (SkipCount=0) OR (we're at the last point to be plotted)
+					int xp, yp;
+					switch (loopCnt) {
 
- if (arcSegment & arc5 && x <= xHalfWayLimit) plotPoint(xc + x, yc - y);		//Segment 5
+					case 0: {
+						xp = xc - x;
+						yp = yc + y;	//Segment 0, 1
+						//Serial.print("S01 (");Serial.print(xp);Serial.print(",");Serial.print(yp);Serial.println(")");						
+						//plotPoint(xc - x, yc + y);		//Segment 0, 1
+						if (arcSegment & arc0 && x >= xHalfWayLimit)
+							plotPoint(xp, yp);		//Segment 0
+						if (arcSegment & arc1 && x < xHalfWayLimit)
+							plotPoint(xp, yp);		//Segment 1
 
- if (arcSegment & arc6 && x <  xHalfWayLimit) plotPoint(xc - x, yc - y);		//Segment 6
+						break;
 
- if (arcSegment & arc7 && x >= xHalfWayLimit) plotPoint(xc - x, yc - y);		//Segment 7
- 
- SkipCount=_graphDensity;;
- } else SkipCount--;
- 
- if (sigma >= 0)
- {
- sigma += fb2 * (1 - x);
- x--;
- }
- sigma += a2 * ((4 * y) + 6);
- }
- }	
- return;
- }
+					}
+					case 1: {
+						xp = xc + x;
+						yp = yc + y;	//Segment 2, 3
+						//Serial.print("S23 (");Serial.print(xp);Serial.print(",");Serial.print(yp);Serial.println(")");					
+						//plotPoint(xc + x, yc + y);		//Segment 2, 3
+						if (arcSegment & arc2 && x < xHalfWayLimit)
+							plotPoint(xp, yp);		//Segment 2
+						if (arcSegment & arc3 && y <= yHalfWayLimit)
+							plotPoint(xp, yp);		//Segment 3
+						break;
+					}
+					case 2: {
+						xp = xc + x;
+						yp = yc - y;
+						//plotPoint(xc + x, yc - y);		//Segment 4, 5
+						if (arcSegment & arc4 && x < xHalfWayLimit)
+							plotPoint(xp, yp);		//Segment 4
+						if (arcSegment & arc5 && y <= yHalfWayLimit)
+							plotPoint(xp, yp);		//Segment 5
+						break;
+					}
+					case 3: {
+						xp = xc - x;
+						yp = yc - y;
+						//plotPoint(xc - x, yc - y);		//Segment 6. 7
+						if (arcSegment & arc6 && x < xHalfWayLimit)
+							plotPoint(xp, yp);		//Segment 6
+						if (arcSegment & arc7 && y <= yHalfWayLimit)
+							plotPoint(xp, yp);		//Segment 7
+						break;
+					}
+
+					}
+					//if (arcSegment & arc0 && x >= xHalfWayLimit) plotPoint(xc - x, yc + y);	//Segment 0
+					//if (arcSegment & arc1 && x < xHalfWayLimit) plotPoint(xc - x, yc + y);	//Segment 1
+					//if (arcSegment & arc2 && x < xHalfWayLimit) plotPoint(xc + x, yc + y);	//Segment 2
+					//if (arcSegment & arc3 && y <= yHalfWayLimit ) plotPoint(xc + x, yc + y);	//Segment 3
+					//if (arcSegment & arc4 && y < yHalfWayLimit) plotPoint(xc + x, yc - y);		//Segment 4
+					//if (arcSegment & arc5 && x <= xHalfWayLimit) plotPoint(xc + x, yc - y);		//Segment 5
+					//if (arcSegment & arc6 && x <= xHalfWayLimit) plotPoint(xc - x, yc - y);		//Segment 6
+					//if (arcSegment & arc7 && x > xHalfWayLimit) plotPoint(xc - x, yc - y);		//Segment 7
+					SkipCount = _graphDensity;
+				} else
+					SkipCount--;
+
+				error = 2 * (delta + y) - 1;
+
+				if ((delta < 0) && (error <= 0)) {
+					++x;
+					delta += 2 * x + 1;
+					continue;
+				}
+
+				error = 2 * (delta - x) - 1;
+
+				if (delta > 0 && error > 0) {
+					--y;
+					delta += 1 - 2 * y;
+					continue;
+				}
+				++x;
+				delta += 2 * (x - y);
+				--y;
+			}
+		}
+	}
+	return;
+}
+/*
+
+ void XYscope::plotCircle(int xc, int yc, int r){
+ //	Routine for CIRCLE plotting.  Basic algorithm implementation/starting code base from:
+ //	https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
+ //
+ //	Calling parameters:
+ //
+ //		xc, yc	Coordinate of point center of circle to be plotted.
+ //				Valid Range:  0<= xc <= 4095, 0<= yc <= 4095
+ //
+ //		r		Radius of circle
+ //
+ //		arcSegment	8-bit code corresponding to the arc segments that are to be drawn.
+ //					Bit = 1 means Draw arc segment, Bit = 0 means do NOT draw arc segment (Skip it!)
+ //
+
+ 1  |	 2
+ \	  |   /
+ 0  \  |  /  3
+ -------+-------
+ 7  /  |  \   4
+ /   |   \
+						   6  |  5
+
+ //
+ //	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
+ //				Caller should take care so that center - radius values do not exceed 4095.
+ //				Negative or coordinate values >4095 will be masked to 12 bits and will
+ //				fold-over the edges of the valid plot area (x,y) = (0 to 4095, 0 to 4095).
+ //
+ //				NOTE: Routine will set plotErr >0 & skip plotting if passed parameter errors are detected.
+ //
+ //	Returns: NOTHING
+ //
+ //	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+ //
+ //	20170322 Ver 0.0	E.Andrews	First cut
+ //	20170427 Ver 1.0	E.Andrews	Rework to improve shape
+ //	20170617 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+ //	20170714 Ver 0.3	E.Andrews	Overlay function when user wants a full circle
+ //
+ plotCircle(xc, yc, r,255);
+ }
+
+
+ */
+
+void XYscope::plotCircle(int xc, int yc, int r, uint8_t arcSegment) {
+	//	Routine for CIRCLE plotting.  Basic algorithm implementation/starting code base from: 
+	//	https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
+	//
+	//	Calling parameters:
+	//
+	//		xc, yc	Coordinate of point center of circle to be plotted.  
+	//				Valid Range:  0<= xc <= 4095, 0<= yc <= 4095
+	//
+	//		r		Radius of circle   
+	//
+	//		arcSegment	8-bit code corresponding to the arc segments that are to be drawn.
+	//					Bit = 1 means Draw arc segment, Bit = 0 means do NOT draw arc segment (Skip it!)
+	//
+	/*
+	 1  |	 2
+	 \	  |   /
+	 0  \  |  /  3
+	 -------+-------
+	 7  /  |  \   4
+	 /   |   \
+						   6  |  5
+	 */
+	//
+	//	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
+	//				Caller should take care so that center - radius values do not exceed 4095.
+	//				Negative or coordinate values >4095 will be masked to 12 bits and will
+	//				fold-over the edges of the valid plot area (x,y) = (0 to 4095, 0 to 4095).
+	//
+	//				NOTE: Routine will set plotErr >0 & skip plotting if passed parameter errors are detected.
+	//
+	//	Returns: NOTHING
+	//
+	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//
+	//	20170322 Ver 0.0	E.Andrews	First cut
+	//	20170427 Ver 1.0	E.Andrews	Rework to improve shape
+	//	20170617 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+	//	20170907 Ver 2.0 	E.Andrews	Abandon Bresenham algorithm for slower floating point approach
+	//									because new approach plots adjacent points and does not take advantage
+	//									of figure symetry.This Allows AGI to run at a higher DMA_CLK freq.
+	//	20261017 Ver 2.1				Queue the call when a command queue is set (see setCommandQueue)
+	//
+	if (cmdQueue(cmdCircleArc, xc, yc, r, 0, arcSegment))
+		return;
+	const float pi = atan(1) * 4;
+	const float arcAng0 = 0;
+	const float arcAng1 = pi * .25;		// .25 * pi
+	const float arcAng2 = pi * .5;		// .50 * pi
+	const float arcAng3 = pi * .75;		// .75 * pi
+	const float arcAng4 = pi;			//1.00 * pi
+	const float arcAng5 = pi * 1.25;	//1.25 * pi
+	const float arcAng6 = pi * 1.50;	//1.50 * pi
+	const float arcAng7 = pi * 1.75;	//1.75 * pi
+	const float FullCircle = 2 * pi;	//2.00 * pi
+	float circumf;
+	short xr, yr;
+	xr = yr = r;
+
+	//calculate circle circumference
+	circumf = FullCircle * r;
+
+	//Figure out how many points we will actually be plotting
+	//based on the current graphicsIntensity (_graphicsDensity) setting
+	float numOfPoints = circumf / _graphDensity;
+	//Calc the deltaAng between points
+	float deltaAng = FullCircle / (numOfPoints);
+
+	float angle;
+	short X, Y;
+
+	for (angle = 0; angle < FullCircle; angle = angle + deltaAng) {
+		X = int(xc - cos(angle) * xr);
+		Y = int(yc + sin(angle) * yr);
+
+		//Only plot those segments that are enabled by passed "arcSegment" variable
+		if (arcSegment & arc0 && angle <= arcAng1)
+			plotPoint(X, Y);					//Segment 0
+		if (arcSegment & arc1 && angle > arcAng1 && angle <= arcAng2)
+			plotPoint(X, Y);	//Segment 1
+		if (arcSegment & arc2 && angle > arcAng2 && angle <= arcAng3)
+			plotPoint(X, Y);	//Segment 2
+		if (arcSegment & arc3 && angle > arcAng3 && angle <= arcAng4)
+			plotPoint(X, Y);	//Segment 3
+		if (arcSegment & arc4 && angle > arcAng4 && angle <= arcAng5)
+			plotPoint(X, Y);	//Segment 4
+		if (arcSegment & arc5 && angle > arcAng5 && angle <= arcAng6)
+			plotPoint(X, Y);	//Segment 5
+		if (arcSegment & arc6 && angle > arcAng6 && angle <= arcAng7)
+			plotPoint(X, Y);	//Segment 6
+		if (arcSegment & arc7 && angle > arcAng7)
+			plotPoint(X, Y);						//Segment 7
+	}
+
+	return;
+}
+
+void XYscope::plotCircleBres(int xc, int yc, int r, uint8_t arcSegment) {
+	/*
+	//	Routine for CIRCLE plotting.  Basic algorithm implementation/starting code base from:
+	//	https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
+	//
+	//	Calling parameters:
+	//
+	//		xc, yc	Coordinate of point center of circle to be plotted.
+	//				Valid Range:  0<= xc <= 4095, 0<= yc <= 4095
+	//
+	//		r		Radius of circle
+	//
+	//		arcSegment	8-bit code corresponding to the arc segments that are to be drawn.
+	//					Bit = 1 means Draw arc segment, Bit = 0 means do NOT draw arc segment (Skip it!)
+	//
+	//
+	//					   1  |	 2
+	//					  \	  |   /
+	//					0  \  |  /  3
+	//				   -------+-------
+	//					7  /  |  \   4
+	//					  /   |   \
+	//					   6  |  5
+	//
+	//
+	//	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
+	//				Caller should take care so that center - radius values do not exceed 4095.
+	//				Negative or coordinate values >4095 will be masked to 12 bits and will
+	//				fold-over the edges of the valid plot area (x,y) = (0 to 4095, 0 to 4095).
+	//
+	//				NOTE: Routine will set plotErr >0 & skip plotting if passed parameter errors are detected.
+	//
+	//	Returns: NOTHING
+	//
+	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//
+	//	20170322 Ver 0.0	E.Andrews	First cut
+	//	20170427 Ver 1.0	E.Andrews	Rework to improve shape
+	//	20170617 Ver 0.2	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+	//
+	*/
+	plotErr = 0;
+	int SkipCount = 0;
+	//==========Check to be sure that the figure is fully on-screen
+	if ((xc + r > 4095) || (xc - r < 0))
+		plotErr = 1;
+	if ((yc + r > 4095) || (yc - r < 0))
+		plotErr = 1;
+	//==========Skip drawing if figure is faulted
+	if (plotErr == 0) {
+
+		int x = 0;
+		int y = r;	//radius
+		int delta = 2 - 2 * r;
+		int error = 0;
+
+		int xHalfWayLimit = int(float(r) * .707106);//xHalfWayLimit = xr * sin(45Deg)
+		int yHalfWayLimit = int(float(r) * .707106);//yHalfWayLimit = xr * cos(45Deg)
+		while (y >= 0) {
+			//if (SkipCount<=0 || y <= 0){
+			if (SkipCount <= 0 || y <= 0) {
+				if (arcSegment & arc0 && x >= xHalfWayLimit)
+					plotPoint(xc - x, yc + y);		//Segment 0
+				if (arcSegment & arc1 && x < xHalfWayLimit)
+					plotPoint(xc - x, yc + y);		//Segment 1
+				if (arcSegment & arc2 && x < xHalfWayLimit)
+					plotPoint(xc + x, yc + y);		//Segment 2 
+				if (arcSegment & arc3 && y <= yHalfWayLimit)
+					plotPoint(xc + x, yc + y);	//Segment 3
+				if (arcSegment & arc4 && y < yHalfWayLimit)
+					plotPoint(xc + x, yc - y);		//Segment 4
+				if (arcSegment & arc5 && x <= xHalfWayLimit)
+					plotPoint(xc + x, yc - y);		//Segment 5
+				if (arcSegment & arc6 && x <= xHalfWayLimit)
+					plotPoint(xc - x, yc - y);		//Segment 6
+				if (arcSegment & arc7 && x > xHalfWayLimit)
+					plotPoint(xc - x, yc - y);		//Segment 7
+
+				SkipCount = _graphDensity;
+			} else
+				SkipCount--;
+
+			error = 2 * (delta + y) - 1;
+			if ((delta < 0) && (error <= 0)) {
+				++x;
+				delta += 2 * x + 1;
+				continue;
+			}
+			error = 2 * (delta - x) - 1;
+
+			if (delta > 0 && error > 0) {
+				--y;
+				delta += 1 - 2 * y;
+				continue;
+			}
+			++x;
+			delta += 2 * (x - y);
+			--y;
+		}
+	}
+	return;
+}
+
+void XYscope::plotEllipse(int xc, int yc, int xr, int yr) {
+	//	Routine for horizontal ELLIPSE plotting.
+	//		Algorithm implementation/starting code base from: 
+	//			https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
+	//			Also see: http://members.chello.at/~easyfilter/bresenham.html 
+	//	Calling parameters:
+	//		xc, yc	Coordinate of point center of ellipse to be plotted.  
+	//				Valid Range:  0<= x0 <= 4095, 0<= y0 <= 4095
+	//
+	//		xr, yr	X-Radius of ellipse, Y-radius of ellipse   
+	//				Valid Range:  0<= xr <= 4095, 0<= yr <= 4095	//
+	//
+	//	Returns: NOTHING
+	//
+	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//
+	//	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
+	//				Negative coordinates or coordinate values >4095 will be masked to 12 bits and will
+	//				be folded-over the edges of the valid plot area which is (x,y) = (0 to 4095, 0 to 4095).	
+	//
+	//				NOTE: Routine will set plotErr to non-zero value and skip plotting if error in passed parameters are detected.
+	//
+	//	20170424	Ver 0.0	E.Andrews	First cut, irratic operation
+	//	20170427	Ver 1.0	E.Andrews	This version uses some DOUBLE variables to correct ocasional mishapen ellipses!)
+	//	20170617 	Ver 1.1	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+
+	//Adjust passed coordinates to algorithm needs 
+
+	plotEllipse(xc, yc, xr, yr, 255);//Call standard plotEllipse function with all segments=ON (255)
+	return;
+}
+
+void XYscope::plotEllipseBres(int xc, int yc, int xr, int yr,
+		uint8_t arcSegment)
+//TODO REMOVE routine
+		{
+	//	Routine for horizontal ELLIPSE plotting.
+	//		Breseham Algorithm implementation/starting code base from:
+	//			https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
+	//			Also see: http://members.chello.at/~easyfilter/bresenham.html
+	//	Calling parameters:
+	//		xc, yc	Coordinate of point center of ellipse to be plotted.
+	//				Valid Range:  0<= x0 <= 4095, 0<= y0 <= 4095
+	//
+	//		xr, yr	X-Radius of ellipse, Y-radius of ellipse
+	//				Valid Range:  0<= xr <= 4095, 0<= yr <= 4095
+	//
+	//		arcSegment	8-bit code corresponding to the arc segments that are to be drawn.
+	//					Bit = 1 means Draw arc segment, Bit = 0 means do NOT draw arc segment (Skip it!)
+	//					Any combination from 1 to 8 segments may be spec'd.
+	/*
+	 1  |	 2
+	 \	  |   /
+	 0  \  |  /  3
+	 -------+-------
+	 7  /  |  \   4
+	 /   |   \
+						   6  |  5
+	 */
+	//
+	//	Returns: NOTHING
+	//
+	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//
+	//	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
+	//				Negative coordinates or coordinate values >4095 will be masked to 12 bits and will
+	//				be folded-over the edges of the valid plot area which is (x,y) = (0 to 4095, 0 to 4095).
+	//
+	//				NOTE: Routine will set plotErr to non-zero value and skip plotting if error in passed parameters are detected.
+	//
+	//	20170424	Ver 0.0	E.Andrews	First cut, Works but had erratic operation
+	//	20170427	Ver 1.0	E.Andrews	This version uses some DOUBLE variables to correct occasional mis-shaoed ellipses!
+	//	20170617 	Ver 1.1	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+	plotErr = 0;		//Initialize plotErr to FALSE (No errors)...
+	//Check to see if passed coordinates fully fit into the display range
+	int x0 = xc - xr;//x0,y0 = lower left hand corner of a rectangle bounding the totality of the Ellipse
+	int y0 = yc - yr;
+	int x1 = xc + xr;//x1,y1 = upper right hand corner of a rectangle bounding the totality of the Ellipse
+	int y1 = yc + yr;
+	short px, py;
+	//==========Check to be sure that the figure is fully on-screen; Set PlotErr flag if NO
+	if ((x0 > 4095) || (x0 < 0) || (x1 > 4095) || (x1 < 0))
+		plotErr = 1;
+	if ((y0 > 4095) || (y0 < 0) || (y1 > 4095) || (y1 < 0))
+		plotErr = 1;
+
+	//==========Skip drawing if passed parameters are faulted
+	if (plotErr == 0) {
+		int SkipCount = 0;	//Initialize the point-skip counter...
+		double width = 1 * xr;
+		int height = 1 * yr;
+		//  The following variables must be DOUBLE or ellipse shape can
+		//	be plotted badly deformed due to value over-flows
+		//  Note: On Arduino DUE, sizeof(double)=8 bytes
+		double a2 = width * width;
+		double b2 = height * height;
+		double fa2 = 4 * a2, fb2 = 4 * b2;
+		double x, y, sigma;
+		//Calculate segment 'HalfWayLimits'
+		int xHalfWayLimit = xr * .707106;	//xHalfWayLimit = xr * sin(45Deg)
+		int yHalfWayLimit = yr * .707106;	//yHalfWayLimit = xr * cos(45Deg)
+		/* first half */
+		for (x = 0, y = height, sigma = 2 * b2 + a2 * (1 - 2 * height);
+				b2 * x <= a2 * y; x++) {
+			if (SkipCount <= 0) {//Only plot the point if the arcsegment flag bit=1, otherwise, skip the point
+
+				if (arcSegment & arc0 && x > xHalfWayLimit) {
+					//plotPoint(xc - x, yc + y);		//Segment 0
+					px = xc - x;
+					py = yc + y;
+					plotPoint(px, py);
+					//Serial.print ("0, 0, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc1 && x <= xHalfWayLimit) {
+					//plotPoint(xc - x, yc + y);		//Segment 1
+					px = xc - x;
+					py = yc + y;
+					plotPoint(px, py);
+					//Serial.print ("0, 1, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc2 && x < xHalfWayLimit) {
+					//plotPoint(xc + x, yc + y);		//Segment 2
+					px = xc + x;
+					py = yc + y;
+					plotPoint(px, py);
+					//Serial.print ("0, 2, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc3 && y <= yHalfWayLimit) {
+					//plotPoint(xc + x, yc + y);		//Segment 3					px=xc+x; py=yc+y;
+					px = xc + x;
+					py = yc + y;
+					plotPoint(px, py);
+					//Serial.print ("0, 3, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc4 && y < yHalfWayLimit) {
+					//plotPoint(xc + x, yc - y);		//Segment 4
+					px = xc + x;
+					py = yc - y;
+					plotPoint(px, py);
+					//Serial.print ("0, 4, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc5 && x <= xHalfWayLimit) {
+					//plotPoint(xc + x, yc - y);		//Segment 5
+					px = xc + x;
+					py = yc - y;
+					plotPoint(px, py);
+					//Serial.print ("0, 5, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc6 && x < xHalfWayLimit) {
+					//plotPoint(xc - x, yc - y);		//Segment 6
+					px = xc - x;
+					py = yc - y;
+					plotPoint(px, py);
+					//Serial.print ("0, 6, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc7 && x >= xHalfWayLimit) {
+					//plotPoint(xc - x, yc - y);		//Segment 7
+					px = xc - x;
+					py = yc - y;
+					plotPoint(px, py);
+					//Serial.print ("0, 7, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				SkipCount = _graphDensity;
+				;
+			} else
+				SkipCount--;
+			if (sigma >= 0) {
+				sigma += fa2 * (1 - y);
+				y--;
+			}
+			sigma += b2 * ((4 * x) + 6);
+		}
+
+		/* second half */
+		//SkipCount=0;
+		//int X, Y;
+		for (x = width, y = 0, sigma = 2 * a2 + b2 * (1 - 2 * width);
+				a2 * y <= b2 * x; y++) {
+			if (SkipCount <= 0) {
+
+				if (arcSegment & arc0 && x > xHalfWayLimit) {
+					//plotPoint(xc - x, yc + y);		//Segment 0
+					px = xc - x;
+					py = yc + y;
+					plotPoint(px, py);
+					//Serial.print ("1, 0, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc1 && x <= xHalfWayLimit) {
+					//plotPoint(xc - x, yc + y);		//Segment 1
+					px = xc - x;
+					py = yc + y;
+					plotPoint(px, py);
+					//Serial.print ("1, 1, ");Serial.print(px); Serial.print(", "); Serial.println(py);
+				}
+
+				if (arcSegment & arc2 && x < xHalfWayLimit) {
+					//plotPoint(xc + x, yc + y);		//Segment 2
+					px = xc + x;
+					py = yc + y;
+					plotPoint(px, py);
+					//Serial.print ("1, 2, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc3 && y <= yHalfWayLimit) {
+					//plotPoint(xc + x, yc + y);		//Segment 3
+					px = xc + x;
+					py = yc + y;
+					plotPoint(px, py);
+					//Serial.print ("1, 3, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc4 && y < yHalfWayLimit) {
+					//plotPoint(xc + x, yc - y);		//Segment 4
+					px = xc + x;
+					py = yc - y;
+					plotPoint(px, py);
+					//Serial.print ("1, 4, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc5 && x <= xHalfWayLimit) {
+					//plotPoint(xc + x, yc - y);		//Segment 5
+					px = xc + x;
+					py = yc - y;
+					plotPoint(px, py);
+					//Serial.print ("1, 5, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc6 && x < xHalfWayLimit) {
+					//plotPoint(xc - x, yc - y);		//Segment 6
+					px = xc - x;
+					py = yc - y;
+					plotPoint(px, py);
+					//Serial.print ("1, 6, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				if (arcSegment & arc7 && x >= xHalfWayLimit) {
+					//plotPoint(xc - x, yc - y);		//Segment 7
+					px = xc - x;
+					py = yc - y;
+					plotPoint(px, py);
+					//Serial.print ("1, 7, ");Serial.print(px);Serial.print(", ");	Serial.println(py);
+				}
+
+				SkipCount = _graphDensity;
+				;
+			} else
+				SkipCount--;
+
+			if (sigma >= 0) {
+				sigma += fb2 * (1 - x);
+				x--;
+			}
+			sigma += a2 * ((4 * y) + 6);
+		}
+	}
+	return;
+}
+
+void XYscope::plotEllipse(int xc, int yc, int xr, int yr, uint8_t arcSegment) {
+	//	Routine for non-rotated ELLIPSE plotting.
+	//		Algorithm implementation uses standard geometry (not speed optized)
+	//
+	//	Calling parameters:
+	//		xc, yc	Coordinate of point center of ellipse to be plotted.
+	//				Valid Range:  0<= x0 <= 4095, 0<= y0 <= 4095
+	//
+	//		xr, yr	X-Radius of ellipse, Y-radius of ellipse
+	//				Valid Range:  0<= xr <= 4095, 0<= yr <= 4095
+	//
+	//		arcSegment	8-bit code corresponding to the arc segments that are to be drawn.
+	//					Bit = 1 means Draw arc segment, Bit = 0 means do NOT draw arc segment (Skip it!)
+	//					Any combination from 1 to 8 segments may be spec'd.
+	/*
+	 1  |	 2
+	 \	  |   /
+	 0  \  |  /  3
+	 -------+-------
+	 7  /  |  \   4
+	 /   |   \
+						   6  |  5
+	 */
+	//
+	//	Returns: NOTHING
+	//
+	//	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+	//
+	//	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
+	//				Negative coordinates or coordinate values >4095 will be masked to 12 bits and will
+	//				be folded-over the edges of the valid plot area which is (x,y) = (0 to 4095, 0 to 4095).
+	//
+	//				NOTE: Routine will set plotErr to non-zero value and skip plotting if error in passed parameters are detected.
+	//
+	//	20170424	Ver 0.0	E.Andrews	First cut, Works but had erratic operation
+	//	20170427	Ver 1.0	E.Andrews	This version uses some DOUBLE variables to correct occasional mis-shaoed ellipses!
+	//	20170617 	Ver 1.1	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+	//	20170907	Ver 2.0 E.Andrews	Abandon Bresenham algorithm for slower floating point approach
+	//									because new approach plots adjacent points and does not take advantage
+	//									of figure symetry.This Allows AGI to run at a higher DMA_CLK freq.
+	//	20261017 Ver 2.1				Queue the call when a command queue is set (see setCommandQueue)
+	if (cmdQueue(cmdEllipseArc, xc, yc, xr, yr, arcSegment))
+		return;
+	const float pi = atan(1) * 4;
+	const float arcAng0 = 0;
+	const float arcAng1 = pi * .25;		// .25 * pi
+	const float arcAng2 = pi * .5;		// .50 * pi
+	const float arcAng3 = pi * .75;		// .75 * pi
+	const float arcAng4 = pi;			//1.00 * pi
+	const float arcAng5 = pi * 1.25;	//1.25 * pi
+	const float arcAng6 = pi * 1.50;	//1.50 * pi
+	const float arcAng7 = pi * 1.75;	//1.75 * pi
+	const float FullCircle = 2 * pi;	//2.00 * pi
+	float circumf;
+	//calculate ellipse circumference
+
+	circumf = FullCircle * sqrt((pow(xr, 2) + pow(yr, 2)) / 2.);
+	//Figure out how many points we will actually be plotting
+	//based on the current graphicsIntensity (_graphicsDensity) setting
+	float numOfPoints = circumf / _graphDensity;
+	//Calc the deltaAng between points
+	float deltaAng = FullCircle / (numOfPoints);
+
+	float angle;
+	short X, Y;
+
+	for (angle = 0; angle < FullCircle; angle = angle + deltaAng) {
+		X = int(xc - cos(angle) * xr);
+		Y = int(yc + sin(angle) * yr);
+
+		//Only plot those segments that are enabled by passed "arcSegment" variable
+		if (arcSegment & arc0 && angle <= arcAng1)
+			plotPoint(X, Y);					//Segment 0
+		if (arcSegment & arc1 && angle > arcAng1 && angle <= arcAng2)
+			plotPoint(X, Y);	//Segment 1
+		if (arcSegment & arc2 && angle > arcAng2 && angle <= arcAng3)
+			plotPoint(X, Y);	//Segment 2
+		if (arcSegment & arc3 && angle > arcAng3 && angle <= arcAng4)
+			plotPoint(X, Y);	//Segment 3
+		if (arcSegment & arc4 && angle > arcAng4 && angle <= arcAng5)
+			plotPoint(X, Y);	//Segment 4
+		if (arcSegment & arc5 && angle > arcAng5 && angle <= arcAng6)
+			plotPoint(X, Y);	//Segment 5
+		if (arcSegment & arc6 && angle > arcAng6 && angle <= arcAng7)
+			plotPoint(X, Y);	//Segment 6
+		if (arcSegment & arc7 && angle > arcAng7)
+			plotPoint(X, Y);						//Segment 7
+	}
+}
+/*
+
+ void XYscope::plotEllipse_BAK(int xc, int yc, int xr, int yr,uint8_t arcSegment=255)
+ //TODO Rework this routine
+ {
+ //	Routine for horizontal ELLIPSE plotting.
+ //		Algorithm implementation/starting code base from: 
+ //			https://sites.google.com/site/ruslancray/lab/projects/bresenhamscircleellipsedrawingalgorithm/bresenham-s-circle-ellipse-drawing-algorithm
+ //			Also see: http://members.chello.at/~easyfilter/bresenham.html 
+ //	Calling parameters:
+ //		xc, yc	Coordinate of point center of ellipse to be plotted.  
+ //				Valid Range:  0<= x0 <= 4095, 0<= y0 <= 4095
+ //
+ //		xr, yr	X-Radius of ellipse, Y-radius of ellipse   
+ //				Valid Range:  0<= xr <= 4095, 0<= yr <= 4095
+ //	
+ //		arcSegment	8-bit code corresponding to the arc segments that are to be drawn.
+ //					Bit = 1 means Draw arc segment, Bit = 0 means do NOT draw arc segment (Skip it!)
+ //					Any combination from 1 to 8 segments may be spec'd.
+
+ //   \ 1 | 2 /
+ //    \  |  /
+ //   0 \ | / 3
+ //  -----+-------
+ //   7  /|\  4
+ //     / | \
+ //    /6 | 5\
+ //
+ //
+ //	Returns: NOTHING
+ //
+ //	Global Variables: Loads points int XY_List, updates XYlistEnd pointer
+ //
+ //	CAUTIONS:	Caller should take care so that center + radius values do not exceed 4095.
+ //				Negative coordinates or coordinate values >4095 will be masked to 12 bits and will
+ //				be folded-over the edges of the valid plot area which is (x,y) = (0 to 4095, 0 to 4095).	
+ //
+ //				NOTE: Routine will set plotErr to non-zero value and skip plotting if error in passed parameters are detected.
+ //
+ //	20170424	Ver 0.0	E.Andrews	First cut, Works but had erratic operation
+ //	20170427	Ver 1.0	E.Andrews	This version uses some DOUBLE variables to correct occasional mis-shaoed ellipses!
+ //	20170617 	Ver 1.1	E.Andrews	Simplify Routine Call by eliminating need to pass the index pointer
+ 
+ plotErr=0;		//Initialize plotErr to FALSE (No errors)...
+ //Check to see if passed coordinates fully fit into the display range
+ int x0 = xc - xr;	//x0,y0 = lower left hand corner of a rectangle bounding the totality of the Ellipse
+ int y0 = yc - yr;
+ int x1 = xc + xr;	//x1,y1 = upper right hand corner of a rectangle bounding the totality of the Ellipse
+ int y1 = yc + yr;
+ //==========Check to be sure that the figure is fully on-screen; Set PlotErr flag if NO
+ if ((x0>4095 )||(x0<0)||(x1>4095 )||(x1<0)) plotErr=1;
+ if ((y0>4095 )||(y0<0)||(y1>4095 )||(y1<0)) plotErr=1;
+
+ //==========Skip drawing if passed parameters are faulted
+ if (plotErr==0){
+ int SkipCount = 0;	//Initialize the point-skip counter...
+ double width=1*xr;
+ int height=1*yr;		
+ //  The following variables must be DOUBLE or ellipse shape can
+ //	be plotted badly deformed due to value over-flows
+ //  Note: On Arduino DUE, sizeof(double)=8 bytes
+ double a2 = width * width;			
+ double b2 = height * height;
+ double fa2 = 4 * a2, fb2 = 4 * b2;
+ double x, y, sigma;
+ //Calculate segment 'HalfWayLimits'
+ int xHalfWayLimit=xr*.707106;	//xHalfWayLimit = xr * sin(45Deg)
+ int yHalfWayLimit=yr*.707106;	//yHalfWayLimit = xr * cos(45Deg)
+ first half
+ for (x = 0, y = height, sigma = 2*b2+a2*(1-2*height); b2*x <= a2*y; x++)
+ {
+ if(SkipCount<=0){	//Only plot the point if the arcsegment flag bit=1, otherwise, skip the point
+
+ if (arcSegment & arc0 && x >  xHalfWayLimit) plotPoint(xc - x, yc + y);		//Segment 0
+
+ if (arcSegment & arc1 && x <= xHalfWayLimit) plotPoint(xc - x, yc + y);		//Segment 1
+
+ if (arcSegment & arc2 && x < xHalfWayLimit)  plotPoint(xc + x, yc + y);		//Segment 2 
+
+ if (arcSegment & arc3 && y <= yHalfWayLimit) plotPoint(xc + x, yc + y);		//Segment 3
+
+ if (arcSegment & arc4 && y <  yHalfWayLimit) plotPoint(xc + x, yc - y);		//Segment 4
+
+ if (arcSegment & arc5 && x <= xHalfWayLimit) plotPoint(xc + x, yc - y);		//Segment 5
+
+ if (arcSegment & arc6 && x <  xHalfWayLimit) plotPoint(xc - x, yc - y);		//Segment 6
+
+ if (arcSegment & arc7 && x >= xHalfWayLimit) plotPoint(xc - x, yc - y);		//Segment 7
+ 
+ SkipCount=_graphDensity;;
+ } else SkipCount--;
+ if (sigma >= 0)
+ {
+ sigma += fa2 * (1 - y);
+ y--;
+ }
+ sigma += b2 * ((4 * x) + 6);
+ }
+
+ second half
+ //SkipCount=0;
+ for (x = width, y = 0, sigma = 2*a2+b2*(1-2*width); a2*y <= b2*x; y++)
+ {
+ if(SkipCount<=0){
+
+ if (arcSegment & arc0 && x >  xHalfWayLimit) plotPoint(xc - x, yc + y);		//Segment 0
+
+ if (arcSegment & arc1 && x <= xHalfWayLimit) plotPoint(xc - x, yc + y);		//Segment 1
+
+ if (arcSegment & arc2 && x < xHalfWayLimit)  plotPoint(xc + x, yc + y);		//Segment 2 
+
+ if (arcSegment & arc3 && y <= yHalfWayLimit) plotPoint(xc + x, yc + y);		//Segment 3
+
+ if (arcSegment & arc4 && y <  yHalfWayLimit) plotPoint(xc + x, yc - y);		//Segment 4
+
+ if (arcSegment & arc5 && x <= xHalfWayLimit) plotPoint(xc + x, yc - y);		//Segment 5
+
+ if (arcSegment & arc6 && x <  xHalfWayLimit) plotPoint(xc - x, yc - y);		//Segment 6
+
+ if (arcSegment & arc7 && x >= xHalfWayLimit) plotPoint(xc - x, yc - y);		//Segment 7
+ 
+ SkipCount=_graphDensity;;
+ } else SkipCount--;
+ 
+ if (sigma >= 0)
+ {
+ sigma += fb2 * (1 - x);
+ x--;
+ }
+ sigma += a2 * ((4 * y) + 6);
+ }
+ }	
+ return;
+ }
+
+ */
+
+void XYscope::plotArduinoLogo(int& charX, int& charY, int& charHt) {
+	//	Plots the horizontal, figure-8 Arduino LOGO to the screen,  Displays "ARDUINO DUE"
+	//	text below the figure-8 logo.
+	//
+	//	Calling parameters:
+	//
+	//		x0, y0	Coordinate of lower left hand corner of logo and as passed by REFERENCE and will be updated by
+	//				this routine; they will be incremented (and returned) pointing to the next character position to the right.
+	//				(x0,y0) values will	wrap to right most character position in the next (lower) row when end-of-line is reached.
+	//
+	//		CharHt	Logo_height in pixels, Range: 16<=CharHt<=4095
+	//				Note: Logo_width is 1.6 X Logo_height!
+	//
+	//-----COMMON VARIABLES----- (Not passed during procedure call)
+	//		 Density is a COMMON variable that is changed by calling the setDensity() routine.
+	//				Higher values of Density increases the distance between ajacent plotted points of graphics figures.
+	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
+	//				Valid numbers are 0 to 100.  Note: depending upon size & focus of CRT, values more ~50 shows
+	//				cause lines of circles and vectors to begin to appear as dotted lines.
+	//
+	//	Returns: charX & charY are updated.
+	//
+	//	201703719 Ver 0.0	E.Andrews	First cut
+	//
+
+	plotErr = 0;
+	//Make CharScale Factor
+	float Char_ScaleFactor = float(charHt) / 16;
+
+	//Plot the two logo characters, 13 spaces apart
+
+	int Tx = charX + 13, Ty = charY;
+	plotChar(128, charX, charY, charHt);
+
+	//Move charX to the right by 13*CharHt places...
+	charX = Tx + 13 * Char_ScaleFactor;	//Fixed, non-proportional Font...
+
+	charY = Ty;
+	plotChar(129, charX, charY, charHt);
+	Ty = Ty - charHt / 16;
+	Tx = Tx + charHt / 8;//Starting location for "Ardu.." text for PROPORTIONAL FONT
+	if (getFontSpacing() != mono)
+		Tx = Tx + ((charHt / 8) * .75);	//Starting location for "Ardu.." text for PROPORTIONAL FONT
+	printSetup(Tx, Ty, charHt / 5);
+	print((char *)"ARDUINO DUE");
+
+	return;
+}
+
+const short prop = 0, monoTight = 8, mono = 10, monoNorm = 10, monoWide = 12;//Define FontSpacing  Constants
+
+void XYscope::setFontSpacing(short spacingMode) {
+	//Set Font Proportional or mono spaced mode...
+	//
+	//	Calling parameters:
+	//
+	//		spacingMode  Valid range 0-15.  Normal values are: prop=0, monoTight=8, mono=10, monoNorm=10, monoWide=12;
+	//					representing Proportional Spacing, tight Mono Spacing, Normal Mono Spacing, Wide Mono Spacing
+	//
+	//-----COMMON VARIABLES-----
+	//		fontSpacing
+	//
+	//	Returns: Nothing.
+	//
+	//	20170906 Ver 0.0	E.Andrews	First cut
+	//
+	if (spacingMode >= 0 && spacingMode < 16)
+		_fontSpacing = spacingMode;
+	//TODO Serial.print ("SpacingMode=");Serial.print(spacingMode); Serial.print(", _fontSpacing=");Serial.println(_fontSpacing);
+	return;
+}
+
+short XYscope::getFontSpacing() {
+	//Retrieve current font spacing value.
+	//
+	//	Calling parameters:  NONE
+	//
+	//-----COMMON VARIABLES-----
+	//		fontSpacing
+	//
+	//	Returns: Current fontSpacing Value.  Normal values are: prop=0, monoTight=8, mono=10, monoNorm=10, monoWide=12;
+	//			 representing Proportional Spacing, tight Mono Spacing, Normal Mono Spacing, Wide Mono Spacing
+	//
+	//	20170906 Ver 0.0	E.Andrews	First cut
+	//
+
+	return _fontSpacing;
+}
+void XYscope::plotChar(char c, int& charX, int& charY, int& charHt) {
+	//	Writes a single CHARACTER to screen
+
+	//	Calling parameters:
+	//
+	//		c		Ascii Charactor to be plotted, Range: 0<= digit <= 255
+	//				Note: Invalid or undefined characters will be plotted as "~"
+	//		
+	//		x0, y0	Coordinate of lower left hand cornder of character cell and as passed by REFERENCE and will be updated by
+	//				this routine; they will be incremented (and returned) pointing to the next character position to the right.
+	//				(x0,y0) values will	wrap to right most character position in the next (lower) row when end-of-line is reached.
+	//
+	//		CharHt	Character height in pixels, Range: 16<=CharHt<=4095
+	//
+	//-----COMMON VARIABLES----- (Not passed during procedure call)
+	//		 _textDensity is a COMMON variable that sets the plot brightness during plotChar operaitons.
+	//				Higher values of Density increases the distance between ajacent plotted points of graphics figures.
+	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
+	//
+	//	Returns: x0 & y0 are updated.
+	//
+	//	20170609 Ver 0.0	E.Andrews	First cut
+	//	20170714 Ver 1.0	E.Andrews	Simplified calling sequence
+	//	20170714 Ver 1.1	E.Andrews	Updated to use _textDensity value durin plotChar operations
+	//	20170905 Ver 2.0	E.Andrews	Added Proportional Font spacing into ROM & Ascii2Font arrays
+	//
+	boolean printDump = false; //Diagnostics flag used during code development (set to false to prevent debug message output)
+	plotErr = 0;
+
+	//Make CharScale Factor
+	float Char_ScaleFactor = float(charHt) / 16;
+
+	int EndOfPlot = 0;
+
+	int PlotCount = 10;
+
+	//Get pointer into the fontROM
+	int charRomIndex = int((Ascii2Font[int(c)] & 0x1ff)) - 1;//limit return to low order 9 bits
+	//Get Width of character (if it is present)
+	int charWidth;
+	charWidth = _fontSpacing;
+	//TODO Serial.print(" plotChar -");
+	if (_fontSpacing == 0) {
+		charWidth = int((Ascii2Font[int(c)]) >> 9);	//extract char width from b10-b13 (if available)
+
+		charWidth = charWidth & 0x0f;				//mask value to 0-15 range.
+		//TODO Serial.print(c); Serial.print(", width = ");Serial.print(charWidth);
+	}
+
+	//TODO Serial.print(", Final_width = ");Serial.println(charWidth);
+
+	//For Character Plotting, temporarily set  _density value to _textDensity
+	short tempDensity = _graphDensity;
+	_graphDensity = _textDensity;
+
+	while (EndOfPlot == 0) {
+		PlotCount--;
+		charRomIndex++;
+		//Initialize Retrieve OpCode
+		uint8_t OC = 0, EOC = 0, P1a = 0, P1b = 0, P2a = 0, P2b = 0, P3 = 0;
+		EOC=EOC;
+		//Unpack OPCODE, EndOfChar Flag, P1,P2,P3
+		OC = DigitFont[charRomIndex].Opcode;	//Retrieve OPCODE from FontROM
+		if ((OC & 0x80) != 0)
+			EndOfPlot++;//Test to see if End_of_Charaacter (EOC) is set; end processing if so
+		OC = OC & 0x0f;						//Strip down to just lower 4 bits
+		P1b = DigitFont[charRomIndex].P1;//Retrieve P1 from FontROM and unpack 
+		P1a = P1b >> 4;
+		P1b = P1b & 0x0f;
+		P2b = DigitFont[charRomIndex].P2;//Retrieve P2 from FontROM and unpack 
+		P2a = P2b >> 4;
+		P2b = P2b & 0x0f;
+		P3 = DigitFont[charRomIndex].P3;			//Retrieve P3 from FontROM
+
+		//Process each graphics element code
+		uint8_t const NOP = 0x0, PNT = 0x1, LIN = 0x2, REC = 0x3, CIR = 0x4,
+				ELP = 0x5;//NOP = No Operaton, PNT = plot a single POINT, LIN = Plot a LINE
+		//REC = Plot a Rectangle, CIR = Plot a Circle or a partial circular segment 
+		//ELP = Plot an Ellipse or a partial ellipical segment.
+		//translate to plotting location and scale ROM data by CharHeight value
+		int x0 = P1a * Char_ScaleFactor + charX;//Start X for lines, points, rectangles...Center point for Circles & Ellipses												
+		int y0 = P1b * Char_ScaleFactor + charY;//Start Y for lines, points, rectangles...Center point for Circles & Ellipses
+		int x1 = P2a * Char_ScaleFactor + charX;//End X for lines and Rectangles												
+		int y1 = P2b * Char_ScaleFactor + charY;//End Y for Lines and Rectangles
+		int xCP = x0;					//X Center Point for Circle & Ellipse
+		int yCP = y0;					//Y Center Point for Circle & Ellipse
+		int r1 = P2a * Char_ScaleFactor;//Radius for Circle, RadiusX for Ellipse
+		int r2 = P2b * Char_ScaleFactor;				//RadiusY for Ellipse
+		uint8_t SegmentFlag = P3;		//Segment flag for Circles and Ellipse
+
+		if (printDump) {
+			//lookup char in ROM and start processing
+
+			Serial.println("|----------plotChar Data Dump -------------|");
+			Serial.print("charIndex = ");
+			Serial.print(charRomIndex);
+			Serial.print("  (charX,charY)= ");
+			Serial.print(charX);
+			Serial.print(",");
+			Serial.print(charY);
+			Serial.print("   Char_ScaleFactor = ");
+			Serial.println(Char_ScaleFactor, 2);
+			Serial.print("  OpCode,P1,P2,P3 = ");
+			Serial.print(OC, HEX);
+			Serial.print(", ");
+			Serial.print(DigitFont[charRomIndex].P1, HEX);
+			Serial.print(", ");
+			Serial.print(DigitFont[charRomIndex].P2, HEX);
+			Serial.print(", ");
+			Serial.print(DigitFont[charRomIndex].P3, HEX);
+			Serial.print("   .... P1a,P1b,P2a,P2b,P3 = ");
+			Serial.print(P1a);
+			Serial.print(", ");
+			Serial.print(P1b);
+			Serial.print(", ");
+			Serial.print(P2a);
+			Serial.print(", ");
+			Serial.print(P2b);
+			Serial.print(", ");
+			Serial.print(P3, HEX);
+			Serial.println();
+			Serial.print("   (x0,y0) = ");
+			Serial.print(x0);
+			Serial.print(",");
+			Serial.print(y0);
+			Serial.print("   (x1,y1) = ");
+			Serial.print(x1);
+			Serial.print(",");
+			Serial.print(y1);
+			Serial.print("   (xCP,yCP) = ");
+			Serial.print(xCP);
+			Serial.print(",");
+			Serial.print(yCP);
+			Serial.print("   (r1,r2) = ");
+			Serial.print(r1);
+			Serial.print(",");
+			Serial.print(r2);
+			Serial.print("   SegmentFlag = ");
+			Serial.print(SegmentFlag, HEX);
+
+		}
+
+
+		switch (OC) {
+		case NOP:	//Do nothing
+			if (printDump)
+				Serial.print("    OpCode= NOP");
+			break;
+		case PNT:	//Plot a point 		P1=(x0,y0), P2 Not Used, P3 Not Used
+			if (printDump)
+				Serial.print("    OpCode= PNT");
+			plotPoint(x0, y0);
+			break;
+		case LIN:	//plot a line		P1=(x0,y0), P2=(x1,y1), P3 Not Used
+			if (printDump)
+				Serial.print("    OpCode= LIN");
+			plotLine(x0, y0, x1, y1);
+			break;
+		case REC:	//plot a rectangle	P1=(x0,y0), P2=(x1,y1), P3 Not Used
+			if (printDump)
+				Serial.print("    OpCode= REC");
+			plotRectangle(x0, y0, x1, y1);
+			break;
+		case CIR://plot a circle		P1=(xCenterPoint,yCenterPoint), P2=(radiusX,not used), P3=Segment Flags (0-7)
+			if (printDump)
+				Serial.print("    OpCode= CIR");
+			plotCircle(xCP, yCP, r1, SegmentFlag);
+			break;
+		case ELP://plot an ellipse	P1=(xCenterPoint,yCenterPoint), P2=(radiusX,radiusY), P3=Segment Flags (0-7)
+			if (printDump)
+				Serial.print("    OpCode= ELP");
+			plotEllipse(xCP, yCP, r1, r2, SegmentFlag);
+			break;
+		default:	//Do Nothing
+			break;
+		}
+
+		if ((OC & 0x80) != 0)
+			EndOfPlot++;	//Does this instruction have the EndOfChar flag set?
+		if (PlotCount == 10)
+			EndOfPlot++;//Backup check to prevent more than MaxCount of graphic primatives to be processed (prevents run-ons...)
+		//if (EndOfPlot!=0) Serial.println (" <<-END OF CHARACTER"); else Serial.println("");
+
+	}
+	//Done with Character Plotting, reset  _graphDensity value to teh temp value...
+	_graphDensity = tempDensity;
+
+	//Move charX to the right by one character size...
+	charX = charX + charWidth * Char_ScaleFactor;//Move to the right one place...
+	if (charX + charHt > 4095) {//Perform NEW LINE function if we will spill over...
+		charX = 0;
+		charY = charY - 15 * Char_ScaleFactor;
+	}
+
+	return;
+}
+
+void XYscope::plotCharUL(char c, int& charX, int& charY, int& charHt) {
+	//	Writes a single CHARACTER to screen with UNDERLINE
+	//
+	//	Calling Paramerters:
+	//
+	//		c		Ascii Charactor to be plotted, Range: 0<= digit <= 255
+	//				Note: Invalid or undefined characters will be plotted as "~"
+	//				Character will be printed with UNDERLINE beneath it!
+	//
+	//		x0, y0	Coordinate of lower left hand corner of character cell and as passed by REFERENCE and will be updated by
+	//				this routine; they will be incremented (and returned) pointing to the next character position to the right.
+	//				(x0,y0) values will	wrap to right most character position in the next (lower) row when end-of-line is reached.
+	//
+	//		CharHt	Character height in pixels, Range: 16<=CharHt<=4095
+	//
+	//-----COMMON VARIABLES----- (Not passed during procedure call)
+	//		 TextIntensity is a COMMON variable that is changed by calling the setTextIntensity() routine.
+	//				Higher values of Density increases the distance between adjacent plotted points of graphics figures.
+	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
+	//				Valid numbers are 0 to 100.  Note: depending upon size & focus of CRT, values more ~50 shows
+	//				cause lines of circles and vectors to begin to appear as dotted lines.
+	//
+	//	Returns: x0 & y0 are updated.
+	//
+	//	20170718 Ver 0.0	E.Andrews	First cut
+	//	20170905 Ver 2.0	E.Andrews	Reordered things so Proportional Font spacing will work for UL characcters
+	//
+	int charX_Temp = charX;	//Remember the original passed Coordinates
+	int charY_Temp = charY;
+	int c_Temp = c;
+	c = '_';
+	plotChar(c, charX_Temp, charY_Temp, charHt);	//Now print the UNDERLINE
+
+	plotChar(c_Temp, charX, charY, charHt);			//Print the base character
+
+	return;
+}
+
+void XYscope::printSetup(short textX, short textY) {
+	//	Sets X and Y location for subsequent calls to XYscope.print(...)
+	//
+	//	Calling parameters:
+	//	
+	//		x0, y0	Coordinate of lower left hand corner of character cell.  Range: 0 to 4095.
+	//
+	//-----COMMON VARIABLES----- (Not passed during procedure call)
+	//		 Density is a COMMON variable that is changed by calling the setDensity() routine.
+	//				Higher values of Density increases the distance between ajacent plotted points of graphics figures.
+	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
+	//				Valid numbers are 0 to 100.  Note: depending upon size & focus of CRT, values more ~50 shows
+	//				cause lines of circles and vectors to begin to appear as dotted lines.
+	//	Returns:  NOTHING
+	//
+	//	201703610 Ver 0.0	E.Andrews	First cut
+	//
+	charX = textX;
+	charY = textY;
+}
+
+void XYscope::printSetup(short textX, short textY, short textSize = -1) {
+	//	Sets X and Y location for subsequent calls to XYscope.print(...)
+	//
+	//	Calling parameters:
+	//	
+	//		x0, y0	Coordinate of lower left hand corner of character cell.  Range: 0 to 4095.
+	//
+	//		textSize	Character height in pixels, Range: 16<=CharHt<=4095
+	//
+	//-----COMMON VARIABLES----- (Not passed during procedure call)
+	//		 Density is a COMMON variable that is changed by calling the setDensity() routine.
+	//				Higher values of Density increases the distance between ajacent plotted points of graphics figures.
+	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
+	//				Valid numbers are 0 to 100.  Note: depending upon size & focus of CRT, values more ~50 shows
+	//				cause lines of circles and vectors to begin to appear as dotted lines.
+	//	Returns:  NOTHING
+	//
+	//	201703610 Ver 0.0	E.Andrews	First cut
+	//
+	charX = textX;
+	charY = textY;
+	if (textSize > 0)
+		charSize = textSize;
+}
+
+void XYscope::printSetup(short textX, short textY, short textSize = -1,
+		short textBright = -1) {
+	//	Sets X and Y location for subsequint calls to XYscope.print(...) 
+	//
+	//	Calling parameters:
+	//	
+	//		x0, y0	Coordinate of lower left hand cornder of character cell.  Range: 0 to 4095.
+	//
+	//		textSize	Character height in pixels, Range: 16<=CharHt<=4095
+	//
+	//		textBright	Sets text brightness (%). Range: 1 to approx 255, Larger=BRIGHTER.
+	//				Values less than 25% will be less bright and or lower text quality.
+	//
+	//-----OTHER NOTES
+	//	Use int GetTextIntensity() to read current text setting.
+	//	SetTextIntensity(value) is an alternate way to set text brightness value
+	//	Returns:  NOTHING
+	//
+	//	201703610 Ver 0.0	E.Andrews	First cut
+	//
+	charX = textX;
+	charY = textY;
+	if (textSize > 0)
+		charSize = textSize;
+	if (textBright > 0)
+		setTextIntensity(textBright);
+}
+
+void XYscope::print(char* text) {
+	print(text, bool(false));
+	return;
+}
+void XYscope::print(char* text, bool UL_Flag = false) {
+	//	Print text sring to screen at current x-y locations. 
+	//
+	//	Calling parameters:
+	//	
+	//		text	String of text to be printed to screen
+	//
+	//		UL_Flag	Boolean, true=UNDERLINE text, False=NO-UNDERLINE
+	//
+	//  Other Notes
+	//		Use PrintSetup(...) to set XY locations, textSize, and textBrightness
+	//
+	//	Returns:  NOTHING
+	//
+	//	201703610 Ver 0.0	E.Andrews	First cut
+	//	
+	int textPtr = 0;
+	while (text[textPtr] != 0) {
+		if (UL_Flag)
+			plotCharUL(text[textPtr], charX, charY, charSize);
+		else
+			plotChar(text[textPtr], charX, charY, charSize);
+		textPtr++;
+	}
+
+}
+void XYscope::printUnderline(int nPlaces) {
+	//	Print underline character to screen at current x-y locations.
+	//
+	//	Calling parameters:
+	//
+	//		nPlaces	Integer, value=Number of Underline places to write
+	//
+	//  Other Notes
+	//		Use PrintSetup(...) to set XY locations, textSize, and textBrightness
+	//
+	//	Returns:  NOTHING
+	//
+	//	201703610 Ver 0.0	E.Andrews	First cut
+	//	201703718 Ver 1.0	E.Andrews	Update to work with UNDERLINE flag
+	//
+	for (int n=nPlaces; n > 0; n--)
+		;
+	{
+		plotChar('_', charX, charY, charSize);
+	}
+	return;
+}
+void XYscope::print(int number) {
+	//	Print integer number to screen at current x-y locations.
+	//
+	//	Calling parameters:
+	//
+	//		number	Integer, value to be printed to screen
+	//
+	//	Returns:  NOTHING
+	//
+	//  Other Notes
+	//		Use PrintSetup(...) to set XY locations, textSize, and textBrightness
+	//
+	//	201703610 Ver 0.0	E.Andrews	First cut
+	//	201703718 Ver 1.0	E.Andrews	Update to work with UNDERLINE flag
+	//
+
+	print(number, bool(false));
+	return;
+}
+void XYscope::print(int number, bool UL_Flag = false) {
+	//	Print integer number to screen at current x-y locations. 
+	//
+	//	Calling parameters:
+	//	
+	//		number	Integer, value to be printed to screen
+	//
+	//		UL_Flag	Boolean, true=UNDERLINE text, False=NO-UNDERLINE
+	//
+	//	Returns:  NOTHING
+	//
+	//  Other Notes
+	//		Use PrintSetup(...) to set XY locations, textSize, and textBrightness
+	//
+	//	201703610 Ver 0.0	E.Andrews	First cut
+	//	201703718 Ver 1.0	E.Andrews	Add UNDERLINE capability
+	//
+
+	char charsToPrint[30] = { 0 };
+	int digitCount = 0;
+
+	if (number < 0) {
+		//Serial.print("-");
+		if (UL_Flag)
+			plotCharUL('-', charX, charY, charSize);
+		else
+			plotChar('-', charX, charY, charSize);
+		number = abs(number);		//Convert NEG number to POSITIVE
+	}
+	//Disect value, extract individual digits into array and count digits extracted
+	if (number == 0) {
+		charsToPrint[0] = '0';
+		digitCount = 0;
+	} else {
+		while (number > 0 && digitCount < 30) {
+			//Serial.print("  Extracted["); Serial.print(digitCount); Serial.print("]:"); Serial.print(number%10);
+			//Extract least significant digit and store it into array as an ASCII character
+			charsToPrint[digitCount] = '0' + number % 10;
+			number = number / 10;
+			digitCount++;
+		}
+		digitCount--;
+	}
+
+	//Serial.println();
+
+	//Now print stored Ascii digits in proper order!
+	for (int i = digitCount; i >= 0; i--) {
+		//Serial.print( i);Serial.print(":");Serial.print(charsToPrint[i]);Serial.print("   ");
+		//Print each char digit to the screen!
+		if (UL_Flag)
+			plotCharUL(charsToPrint[i], charX, charY, charSize);
+		else
+			plotChar(charsToPrint[i], charX, charY, charSize);
 
- */
+	}
+	//Serial.println();
+}
 
-void XYscope::plotArduinoLogo(int& charX, int& charY, int& charHt) {
-	//	Plots the horizontal, figure-8 Arduino LOGO to the screen,  Displays "ARDUINO DUE"
-	//	text below the figure-8 logo.
+void XYscope::print(float number) {
+	//	Print floating point number to screen at current x-y locations. 
 	//
 	//	Calling parameters:
+	//	
+	//		number	Floating point value to be printed to screen, defaults to show two digits to the right of the DP displayed.
 	//
-	//		x0, y0	Coordinate of lower left hand corner of logo and as passed by REFERENCE and will be updated by
-	//				this routine; they will be incremented (and returned) pointing to the next character position to the right.
-	//				(x0,y0) values will	wrap to right most character position in the next (lower) row when end-of-line is reached.
-	//
-	//		CharHt	Logo_height in pixels, Range: 16<=CharHt<=4095
-	//				Note: Logo_width is 1.6 X Logo_height!
-	//
-	//-----COMMON VARIABLES----- (Not passed during procedure call)
-	//		 Density is a COMMON variable that is changed by calling the setDensity() routine.
-	//				Higher values of Density increases the distance between ajacent plotted points of graphics figures.
-	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
-	//				Valid numbers are 0 to 100.  Note: depending upon size & focus of CRT, values more ~50 shows
-	//				cause lines of circles and vectors to begin to appear as dotted lines.
+	//	Returns:  NOTHING
 	//
-	//	Returns: charX & charY are updated.
+	//  Other Notes
+	//		Use PrintSetup(...) to set XY location, textSize, and textBrightness
 	//
-	//	201703719 Ver 0.0	E.Andrews	First cut
+	//	201703610 Ver 0.0	E.Andrews	First cut
 	//
 
-	plotErr = 0;
-	//Make CharScale Factor
-	float Char_ScaleFactor = float(charHt) / 16;
-
-	//Plot the two logo characters, 13 spaces apart
-
-	int Tx = charX + 13, Ty = charY;
-	plotChar(128, charX, charY, charHt);
-
-	//Move charX to the right by 13*CharHt places...
-	charX = Tx + 13 * Char_ScaleFactor;	//Fixed, non-proportional Font...
-
-	charY = Ty;
-	plotChar(129, charX, charY, charHt);
-	Ty = Ty - charHt / 16;
-	Tx = Tx + charHt / 8;//Starting location for "Ardu.." text for PROPORTIONAL FONT
-	if (getFontSpacing() != mono)
-		Tx = Tx + ((charHt / 8) * .75);	//Starting location for "Ardu.." text for PROPORTIONAL FONT
-	printSetup(Tx, Ty, charHt / 5);
-	print((char *)"ARDUINO DUE");
+	print(float(number), 2, bool(false));//Default: 2 places to the right of the DP.
 
-	return;
 }
 
-const short prop = 0, monoTight = 8, mono = 10, monoNorm = 10, monoWide = 12;//Define FontSpacing  Constants
-
-void XYscope::setFontSpacing(short spacingMode) {
-	//Set Font Proportional or mono spaced mode...
+void XYscope::print(float number, int placesToPrint = 2) {
+	//	Print floating point number to screen at current x-y locations. 
 	//
 	//	Calling parameters:
+	//	
+	//		number			Float, value to be printed to screen, defaults to show two digits to the right of the DP displayed.
 	//
-	//		spacingMode  Valid range 0-15.  Normal values are: prop=0, monoTight=8, mono=10, monoNorm=10, monoWide=12;
-	//					representing Proportional Spacing, tight Mono Spacing, Normal Mono Spacing, Wide Mono Spacing
+	//		placesToPrint	Integer, value defines number ot digits to the right of the dec point that should be plotted.
 	//
-	//-----COMMON VARIABLES-----
-	//		fontSpacing
+	//	Returns:  NOTHING
 	//
-	//	Returns: Nothing.
+	//  Other Notes
+	//		Use PrintSetup(...) to set XY location, textSize, and textBrightness
 	//
-	//	20170906 Ver 0.0	E.Andrews	First cut
+	//	201703610 Ver 0.0	E.Andrews	First cut
 	//
-	if (spacingMode >= 0 && spacingMode < 16)
-		_fontSpacing = spacingMode;
-	//TODO Serial.print ("SpacingMode=");Serial.print(spacingMode); Serial.print(", _fontSpacing=");Serial.println(_fontSpacing);
-	return;
-}
 
-short XYscope::getFontSpacing() {
-	//Retrieve current font spacing value.
-	//
-	//	Calling parameters:  NONE
-	//
-	//-----COMMON VARIABLES-----
-	//		fontSpacing
-	//
-	//	Returns: Current fontSpacing Value.  Normal values are: prop=0, monoTight=8, mono=10, monoNorm=10, monoWide=12;
-	//			 representing Proportional Spacing, tight Mono Spacing, Normal Mono Spacing, Wide Mono Spacing
-	//
-	//	20170906 Ver 0.0	E.Andrews	First cut
-	//
+	print(float(number), placesToPrint, bool(false));
 
-	return _fontSpacing;
 }
-void XYscope::plotChar(char c, int& charX, int& charY, int& charHt) {
-	//	Writes a single CHARACTER to screen
 
+void XYscope::print(float number, int placesToPrint = 2, bool UL_Flag = false) {
+	//	Print floating point number to screen at current x-y locations.
+	//
 	//	Calling parameters:
 	//
-	//		c		Ascii Charactor to be plotted, Range: 0<= digit <= 255
-	//				Note: Invalid or undefined characters will be plotted as "~"
-	//		
-	//		x0, y0	Coordinate of lower left hand cornder of character cell and as passed by REFERENCE and will be updated by
-	//				this routine; they will be incremented (and returned) pointing to the next character position to the right.
-	//				(x0,y0) values will	wrap to right most character position in the next (lower) row when end-of-line is reached.
+	//		number			Float, value to be printed to screen, defaults to show two digits to the right of the DP displayed.
 	//
-	//		CharHt	Character height in pixels, Range: 16<=CharHt<=4095
+	//		placesToPrint	Integer, value defines number ot digits to the right of the dec point that should be plotted.
 	//
-	//-----COMMON VARIABLES----- (Not passed during procedure call)
-	//		 _textDensity is a COMMON variable that sets the plot brightness during plotChar operaitons.
-	//				Higher values of Density increases the distance between ajacent plotted points of graphics figures.
-	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
+	//		UL_Flag=false	Boolean, TRUE=underline digits, FALSE= do not underline digits
 	//
-	//	Returns: x0 & y0 are updated.
+	//	Returns:  NOTHING
 	//
-	//	20170609 Ver 0.0	E.Andrews	First cut
-	//	20170714 Ver 1.0	E.Andrews	Simplified calling sequence
-	//	20170714 Ver 1.1	E.Andrews	Updated to use _textDensity value durin plotChar operations
-	//	20170905 Ver 2.0	E.Andrews	Added Proportional Font spacing into ROM & Ascii2Font arrays
+	//  Other Notes
+	//		Use PrintSetup(...) to set XY locations, textSize, and textBrightness
+	//
+	//	201703610 Ver 0.0	E.Andrews	First cut
 	//
-	boolean printDump = false; //Diagnostics flag used during code development (set to false to prevent debug message output)
-	plotErr = 0;
 
-	//Make CharScale Factor
-	float Char_ScaleFactor = float(charHt) / 16;
+	//check and bound placesToPrint to a reasonable number
+	if (placesToPrint < 0 || placesToPrint > 10)
+		placesToPrint = 2;	//Reset placesToPrint to reasonable number if it's out of bounds!
 
-	int EndOfPlot = 0;
+	if (number < 0) {
+		//Serial.print("-");
+		//Plot a NEGATIVE sign for negative numbers
+		if (UL_Flag)
+			plotCharUL('-', charX, charY, charSize);
+		else
+			plotChar('-', charX, charY, charSize);
+	}
 
-	int PlotCount = 10;
+	number = abs(number);
+	int digitCount = 0;
 
-	//Get pointer into the fontROM
-	int charRomIndex = int((Ascii2Font[int(c)] & 0x1ff)) - 1;//limit return to low order 9 bits
-	//Get Width of character (if it is present)
-	int charWidth;
-	charWidth = _fontSpacing;
-	//TODO Serial.print(" plotChar -");
-	if (_fontSpacing == 0) {
-		charWidth = int((Ascii2Font[int(c)]) >> 9);	//extract char width from b10-b13 (if available)
+	// Figure out how many digits we will be printing for the Integer Portion of the number...
+	//intNumber=int(number);	//Capture an integer version of the floating point number
 
-		charWidth = charWidth & 0x0f;				//mask value to 0-15 range.
-		//TODO Serial.print(c); Serial.print(", width = ");Serial.print(charWidth);
+	//Serial.println("  Figuring out how many digits to print...");
+	while ((number / (pow(10, digitCount))) > 9.9999999999) {
+		//Serial.print(digitCount);Serial.print("=");Serial.print(pow(10,digitCount)); Serial.print( " : "); Serial.print((number/pow(10,digitCount))); Serial.print("_");
+		digitCount++;
 	}
+	//Serial.print("  Here's the num of digits I think I must print for the Integer part: ");Serial.println(digitCount);
+	//Now print just the integer part of the number...
 
-	//TODO Serial.print(", Final_width = ");Serial.println(charWidth);
+	while (digitCount >= 0) {
+		number = abs(number);	//disect and print it as a positive number...
+		int digitToPrint = number / pow(10, digitCount);
+		char charToPrint = '0' + digitToPrint;
+		//plotChar(charToPrint,charX,charY,charSize);;	//Convert each digit to a single ASCII character and print it!
+		if (UL_Flag)
+			plotCharUL(charToPrint, charX, charY, charSize);
+		else
+			plotChar(charToPrint, charX, charY, charSize);//Convert digit to a single ASCII character and print it!
+		//Serial.print(digitToPrint); Serial.print("_");
+		//Serial.print("[");
+		//Serial.print(charToPrint);Serial.Print("]  ");
 
-	//For Character Plotting, temporarily set  _density value to _textDensity
-	short tempDensity = _graphDensity;
-	_graphDensity = _textDensity;
+		number = number - digitToPrint * pow(10, digitCount);
+		digitCount--;
+	}
+	// Insert DP character Here!!
+	//plotCircle(charX-int ix, int xc, int yc, int r)
+	//plotPoint();
+	if (UL_Flag)
+		plotCharUL('.', charX, charY, charSize);
+	else
+		plotChar('.', charX, charY, charSize);
+	number = number * pow(10, placesToPrint);
+	digitCount = placesToPrint - 1;
 
-	while (EndOfPlot == 0) {
-		PlotCount--;
-		charRomIndex++;
-		//Initialize Retrieve OpCode
-		uint8_t OC = 0, EOC = 0, P1a = 0, P1b = 0, P2a = 0, P2b = 0, P3 = 0;
-		EOC=EOC;
-		//Unpack OPCODE, EndOfChar Flag, P1,P2,P3
-		OC = DigitFont[charRomIndex].Opcode;	//Retrieve OPCODE from FontROM
-		if ((OC & 0x80) != 0)
-			EndOfPlot++;//Test to see if End_of_Charaacter (EOC) is set; end processing if so
-		OC = OC & 0x0f;						//Strip down to just lower 4 bits
-		P1b = DigitFont[charRomIndex].P1;//Retrieve P1 from FontROM and unpack 
-		P1a = P1b >> 4;
-		P1b = P1b & 0x0f;
-		P2b = DigitFont[charRomIndex].P2;//Retrieve P2 from FontROM and unpack 
-		P2a = P2b >> 4;
-		P2b = P2b & 0x0f;
-		P3 = DigitFont[charRomIndex].P3;			//Retrieve P3 from FontROM
+	while (digitCount >= 0) {
+		number = abs(number);	//disect and print it as a positive number...
+		int digitToPrint = int(number / pow(10, digitCount));
+		//int digitToPrint=digitToPrintNoRound;
+		//int digitToPrintRoundUp = int((number+.5) / pow(10, digitCount));
+		//if (digitCount==0) digitToPrint = digitToPrintRoundUp;
+		char charToPrint = '0' + digitToPrint;
+		if (UL_Flag) plotCharUL(charToPrint, charX, charY, charSize);
+		else plotChar(charToPrint, charX, charY, charSize);//Convert digit to a single ASCII character and print it!
+		//Serial.print(digitToPrint); Serial.print("_");
+		//Serial.print("[");
+		//Serial.print(charToPrint);Serial.Print("]  ");
+		
+		//Now shift by power of 10
+		number = number - digitToPrint * pow(10, digitCount);
+		digitCount--;
+	}
+	//Serial.println();
 
-		//Process each graphics element code
-		uint8_t const NOP = 0x0, PNT = 0x1, LIN = 0x2, REC = 0x3, CIR = 0x4,
-				ELP = 0x5;//NOP = No Operaton, PNT = plot a single POINT, LIN = Plot a LINE
-		//REC = Plot a Rectangle, CIR = Plot a Circle or a partial circular segment 
-		//ELP = Plot an Ellipse or a partial ellipical segment.
-		//translate to plotting location and scale ROM data by CharHeight value
-		int x0 = P1a * Char_ScaleFactor + charX;//Start X for lines, points, rectangles...Center point for Circles & Ellipses												
-		int y0 = P1b * Char_ScaleFactor + charY;//Start Y for lines, points, rectangles...Center point for Circles & Ellipses
-		int x1 = P2a * Char_ScaleFactor + charX;//End X for lines and Rectangles												
-		int y1 = P2b * Char_ScaleFactor + charY;//End Y for Lines and Rectangles
-		int xCP = x0;					//X Center Point for Circle & Ellipse
-		int yCP = y0;					//Y Center Point for Circle & Ellipse
-		int r1 = P2a * Char_ScaleFactor;//Radius for Circle, RadiusX for Ellipse
-		int r2 = P2b * Char_ScaleFactor;				//RadiusY for Ellipse
-		uint8_t SegmentFlag = P3;		//Segment flag for Circles and Ellipse
+}
 
-		if (printDump) {
-			//lookup char in ROM and start processing
+void XYscope::setDmaClockRate(uint32_t New_XfrRate_hz) {
+	//	Routine to setup Timer Counter 0 which is used to clock DMA transformers.
+	//	(This is just a CALLER FREINDLIER version of txSetup)
+	//
+	//	Begin automatically calls this routine.  User only needs to call this 
+	//	this routine if he/she wants to change clock rate during runtime.
+	//
+	//	Calling parameters:
+	//	
+	//	New_XfrRateHZ	This is the intended DMA Transfer Rate in Hertz.
+	//				Note that Point_Clk_Freq = XfrRateHz/2.
+	//
+	//	CAUTIONS:	Usual XfrRateHz values should be in 300,000 to 800,000 range.
+	//
+	//				Lower values make the screen refresh take longer and therefore
+	//				reduces the total number of points that can be displayed before
+	//				CRT flicker becomes visually apparant.
+	//
+	//				Higher values demand more of the XY display/oscilloscope 
+	//				hardware but do allow more points to be plotted before refresh
+	//				flicker is a apparent.
+	//
+	//	Returns:	Nothing.
+	//	Other Notes:
+	//		This routine calculates and set the front and back porch of the blanking signals
+	//		based on the clock rate specified when it is called.
+	//
+	//	20170405 Ver 0.0	E.Andrews	First cut
+	//	20261017 Ver 0.1				Porch counts computed by setPorchCounts() (they depend on the transfer mode too)
+	//
+	//This routine sets up TimerCounter0
+	//TC0 is used to drive DAC0 & dAC1
 
-			Serial.println("|----------plotChar Data Dump -------------|");
-			Serial.print("charIndex = ");
-			Serial.print(charRomIndex);
-			Serial.print("  (charX,charY)= ");
-			Serial.print(charX);
-			Serial.print(",");
-			Serial.print(charY);
-			Serial.print("   Char_ScaleFactor = ");
-			Serial.println(Char_ScaleFactor, 2);
-			Serial.print("  OpCode,P1,P2,P3 = ");
-			Serial.print(OC, HEX);
-			Serial.print(", ");
-			Serial.print(DigitFont[charRomIndex].P1, HEX);
-			Serial.print(", ");
-			Serial.print(DigitFont[charRomIndex].P2, HEX);
-			Serial.print(", ");
-			Serial.print(DigitFont[charRomIndex].P3, HEX);
-			Serial.print("   .... P1a,P1b,P2a,P2b,P3 = ");
-			Serial.print(P1a);
-			Serial.print(", ");
-			Serial.print(P1b);
-			Serial.print(", ");
-			Serial.print(P2a);
-			Serial.print(", ");
-			Serial.print(P2b);
-			Serial.print(", ");
-			Serial.print(P3, HEX);
-			Serial.println();
-			Serial.print("   (x0,y0) = ");
-			Serial.print(x0);
-			Serial.print(",");
-			Serial.print(y0);
-			Serial.print("   (x1,y1) = ");
-			Serial.print(x1);
-			Serial.print(",");
-			Serial.print(y1);
-			Serial.print("   (xCP,yCP) = ");
-			Serial.print(xCP);
-			Serial.print(",");
-			Serial.print(yCP);
-			Serial.print("   (r1,r2) = ");
-			Serial.print(r1);
-			Serial.print(",");
-			Serial.print(r2);
-			Serial.print("   SegmentFlag = ");
-			Serial.print(SegmentFlag, HEX);
+	tcSetup(New_XfrRate_hz);
+	DmaClkPeriod_us = (float(1 / float(New_XfrRate_hz)) * 1000000.);
+	//Calculate new value and Update the 'FRONT-PORCH' blankCount
+	//serial.print("\n   DmaClkPeriod_us=");Serial.print(DmaClkPeriod_us);Serial.print("  blankCount=").Serial.println(blankCount);
+	setPorchCounts();
+	Serial.print("\n   DmaClkPeriod_us=");
+	Serial.print(DmaClkPeriod_us);
+	Serial.print("  frontPorchBlankCount=");
+	Serial.print(frontPorchBlankCount);
+	Serial.print(", backPorchBlankCount=");
+	Serial.println(backPorchBlankCount);
 
-		}
+}
 
+void XYscope::setPorchCounts(void) {
+	//	Calculate the front and back porch blank counts for the current DMA clock period and transfer mode.
+	//
+	//	In full-word mode the PDC hands the DACC a whole point (X and Y) per transfer, so when the last
+	//	transfer is done (TXBUFE) one more point is still waiting to be converted than in half-word mode.
+	//	The back porch is stretched by one point time (2 conversions, ~60ns per count) to cover it.  The
+	//	front porch does not change: conversions are paced by TC0 in both modes.
+	//
+	//	20261017 Ver 0.0				First cut (from setDmaClockRate)
 
-		switch (OC) {
-		case NOP:	//Do nothing
-			if (printDump)
-				Serial.print("    OpCode= NOP");
-			break;
-		case PNT:	//Plot a point 		P1=(x0,y0), P2 Not Used, P3 Not Used
-			if (printDump)
-				Serial.print("    OpCode= PNT");
-			plotPoint(x0, y0);
-			break;
-		case LIN:	//plot a line		P1=(x0,y0), P2=(x1,y1), P3 Not Used
-			if (printDump)
-				Serial.print("    OpCode= LIN");
-			plotLine(x0, y0, x1, y1);
-			break;
-		case REC:	//plot a rectangle	P1=(x0,y0), P2=(x1,y1), P3 Not Used
-			if (printDump)
-				Serial.print("    OpCode= REC");
-			plotRectangle(x0, y0, x1, y1);
-			break;
-		case CIR://plot a circle		P1=(xCenterPoint,yCenterPoint), P2=(radiusX,not used), P3=Segment Flags (0-7)
-			if (printDump)
-				Serial.print("    OpCode= CIR");
-			plotCircle(xCP, yCP, r1, SegmentFlag);
-			break;
-		case ELP://plot an ellipse	P1=(xCenterPoint,yCenterPoint), P2=(radiusX,radiusY), P3=Segment Flags (0-7)
-			if (printDump)
-				Serial.print("    OpCode= ELP");
-			plotEllipse(xCP, yCP, r1, r2, SegmentFlag);
-			break;
-		default:	//Do Nothing
-			break;
-		}
+	frontPorchBlankCount = int(DmaClkPeriod_us * 186.23 - 52.1 + .5);
+	backPorchBlankCount = int(DmaClkPeriod_us * 79. - 36 + .5);
+	if (_dmaUnitsPerPoint == 1)
+		backPorchBlankCount += int(DmaClkPeriod_us * 2 * 1000. / 60. + .5);
+}
 
-		if ((OC & 0x80) != 0)
-			EndOfPlot++;	//Does this instruction have the EndOfChar flag set?
-		if (PlotCount == 10)
-			EndOfPlot++;//Backup check to prevent more than MaxCount of graphic primatives to be processed (prevents run-ons...)
-		//if (EndOfPlot!=0) Serial.println (" <<-END OF CHARACTER"); else Serial.println("");
+void XYscope::setFullWordMode(bool enable) {
+	//	Routine to select the DACC/PDC transfer mode.
+	//
+	//	Half-word mode (default): the PDC makes two 16 bit bus transfers per XY point.
+	//	Full-word mode: the PDC makes ONE 32 bit bus transfer per point.  A pointList entry is already an
+	//	X/Y pair of tagged shorts, which is exactly the layout the DACC expects in a word, so no list changes.
+	//	Half the bus transfers (and half the PDC count per block) leaves more bus bandwidth for other DMA
+	//	users, such as an ADC running alongside.  Points are still converted one sample per TC0 clock, so
+	//	the point rate, refresh times and autoSetRefreshTime() are the same in both modes.
+	//
+	//	Calling parameters:
+	//		enable	true = full-word mode, false = half-word mode
+	//
+	//	Returns: NOTHING.  Ignored while streaming (see streamBegin).
+	//
+	//	20261017 Ver 0.0				First cut
 
-	}
-	//Done with Character Plotting, reset  _graphDensity value to teh temp value...
-	_graphDensity = tempDensity;
+	if (_ringList != NULL)
+		return;
+	beginEdit();				//Mode is only changed while the PDC is idle
+	_dmaUnitsPerPoint = enable ? 1 : 2;
+	xyHalDacWordMode(enable);
+	setPorchCounts();
+	commitEdit();
+}
 
-	//Move charX to the right by one character size...
-	charX = charX + charWidth * Char_ScaleFactor;//Move to the right one place...
-	if (charX + charHt > 4095) {//Perform NEW LINE function if we will spill over...
-		charX = 0;
-		charY = charY - 15 * Char_ScaleFactor;
-	}
+bool XYscope::getFullWordMode() {
+	//	Routine to retrieve the DACC/PDC transfer mode (see setFullWordMode).
+	//
+	//	20261017 Ver 0.0				First cut
 
-	return;
+	return _dmaUnitsPerPoint == 1;
 }
 
-void XYscope::plotCharUL(char c, int& charX, int& charY, int& charHt) {
-	//	Writes a single CHARACTER to screen with UNDERLINE
+void XYscope::tcSetup(uint32_t New_XfrRateHz) {
+	//	Routine to setup Timer Counter 0.  TC0 is used to clock DMA transformers.
 	//
-	//	Calling Paramerters:
+	//	User does NOT usually directly call this routine; XYscope.Begin automatically
+	//	does Counter timer setup.
 	//
-	//		c		Ascii Charactor to be plotted, Range: 0<= digit <= 255
-	//				Note: Invalid or undefined characters will be plotted as "~"
-	//				Character will be printed with UNDERLINE beneath it!
+	//	Calling parameters:
+	//	
+	//	XfrRateHZ	User specifies the desired intended DMA Transfer Rate in Hertz.
+	//				Note that Point_Clk_Freq = XfrRateHz/2.
 	//
-	//		x0, y0	Coordinate of lower left hand corner of character cell and as passed by REFERENCE and will be updated by
-	//				this routine; they will be incremented (and returned) pointing to the next character position to the right.
-	//				(x0,y0) values will	wrap to right most character position in the next (lower) row when end-of-line is reached.
+	//				Typically, XfrRateHz should be in the 300,000-800,000 range.
+	//				User may need to experiment with this value to see what works best
+	//				for the'scope'being used as a display screen.
 	//
-	//		CharHt	Character height in pixels, Range: 16<=CharHt<=4095
+	//				Smaller values make the screen refresh take longer and therefore
+	//				reduces the total number of points that can be displayed before
+	//				CRT flicker becomes visually apparant.
 	//
-	//-----COMMON VARIABLES----- (Not passed during procedure call)
-	//		 TextIntensity is a COMMON variable that is changed by calling the setTextIntensity() routine.
-	//				Higher values of Density increases the distance between adjacent plotted points of graphics figures.
-	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
-	//				Valid numbers are 0 to 100.  Note: depending upon size & focus of CRT, values more ~50 shows
-	//				cause lines of circles and vectors to begin to appear as dotted lines.
+	//				Larger values demand more of the XY display/oscilloscope 
+	//				hardware but do allow more points to be plotted before refresh
+	//				flicker is a apparent.
 	//
-	//	Returns: x0 & y0 are updated.
+	//	Returns:	Nothing.
 	//
-	//	20170718 Ver 0.0	E.Andrews	First cut
-	//	20170905 Ver 2.0	E.Andrews	Reordered things so Proportional Font spacing will work for UL characcters
+	//	20170405 Ver 0.0	E.Andrews	First cut
+	//	20261017 Ver 0.1				Register level setup moved into the HAL (xyHalTcSetup)
 	//
-	int charX_Temp = charX;	//Remember the original passed Coordinates
-	int charY_Temp = charY;
-	int c_Temp = c;
-	c = '_';
-	plotChar(c, charX_Temp, charY_Temp, charHt);	//Now print the UNDERLINE
 
-	plotChar(c_Temp, charX, charY, charHt);			//Print the base character
+	if (New_XfrRateHz > 0)	//DO NOTHING if XfrRateHz is zero or less.
+			{
+		uint32_t tcTicks = FreqToTimerTicks(New_XfrRateHz);	//Convert "Hz value" to "Clock Ticks"
+		xyHalTcSetup(tcTicks);	//Program TC0 (and its TIOA0 output to the AGI hardware) for the new rate
 
-	return;
+		//Setup is done; Remember the setting for later recall as needed
+		DmaClkFreq_Hz = New_XfrRateHz;
+	}
 }
 
-void XYscope::printSetup(short textX, short textY) {
-	//	Sets X and Y location for subsequent calls to XYscope.print(...)
+void XYscope::dacSetup(void) {
+	//	Routine to setup DAC and Interrupt Controller for DMA transformers.
+	//
+	//	User calls this once during SETUP.
 	//
 	//	Calling parameters:
 	//	
-	//		x0, y0	Coordinate of lower left hand corner of character cell.  Range: 0 to 4095.
+	//	None
 	//
-	//-----COMMON VARIABLES----- (Not passed during procedure call)
-	//		 Density is a COMMON variable that is changed by calling the setDensity() routine.
-	//				Higher values of Density increases the distance between ajacent plotted points of graphics figures.
-	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
-	//				Valid numbers are 0 to 100.  Note: depending upon size & focus of CRT, values more ~50 shows
-	//				cause lines of circles and vectors to begin to appear as dotted lines.
-	//	Returns:  NOTHING
+	//	Returns:	Nothing.
+	//		ix		Returns updated pointer into array where next graphics point will go.
 	//
-	//	201703610 Ver 0.0	E.Andrews	First cut
+	//	20170407 Ver 0.0	E.Andrews	First cut
+	//	20261017 Ver 1.0				Register level setup moved into the HAL (xyHalDacSetup)
+	//	20261017 Ver 1.1				Re-apply the full-word mode setting (see setFullWordMode)
 	//
-	charX = textX;
-	charY = textY;
+
+	//	DAC is used in TAG mode (Bits 12,13 of each data word select DAC0/DAC1) and
+	//	is triggered by TC0.  See xyHalDacSetup() for the register level details.
+	xyHalDacSetup();
+	xyHalDacWordMode(_dmaUnitsPerPoint == 1);
 }
 
-void XYscope::printSetup(short textX, short textY, short textSize = -1) {
-	//	Sets X and Y location for subsequent calls to XYscope.print(...)
+void XYscope::dacHandler(void) {
+	//	Routine to handls END OF TRANSFER dma interrupt.  
+	//	This ISR is called when the DMA transfer to the CRT screen is finished.
+	//	The Primary task of the routine is to set crtBlaningPin output pin to HIGH
+	//	so that the screen is turned off.
+	//
+	//	User does NOT directly call this routine.
 	//
 	//	Calling parameters:
-	//	
-	//		x0, y0	Coordinate of lower left hand corner of character cell.  Range: 0 to 4095.
+	//				None.
 	//
-	//		textSize	Character height in pixels, Range: 16<=CharHt<=4095
+	//	Returns:	Nothing.
 	//
-	//-----COMMON VARIABLES----- (Not passed during procedure call)
-	//		 Density is a COMMON variable that is changed by calling the setDensity() routine.
-	//				Higher values of Density increases the distance between ajacent plotted points of graphics figures.
-	//				Smaller values of Density reduces the distand between adjacent plotted points of graphics figures.
-	//				Valid numbers are 0 to 100.  Note: depending upon size & focus of CRT, values more ~50 shows
-	//				cause lines of circles and vectors to begin to appear as dotted lines.
-	//	Returns:  NOTHING
 	//
-	//	201703610 Ver 0.0	E.Andrews	First cut
+	//	20170405 Ver 0.0	E.Andrews	First cut.
+	//	20170405 Ver 0.1	E.Andrews	Reworked to play nicely with timer driven refresh inteerupt
+	//	20170526 Ver 0.2	E.Andrews	Cleaned up comments and throw out unused code fragments
+	//	20261017 Ver 0.3				DACC status/interrupt access goes through the HAL (XYscopeHal.h)
+	//	20261017 Ver 0.4				Perform pending double buffer swap at end of transfer
+	//	20261017 Ver 0.5				Bump frame counter and call user frame callback
+	//	20261017 Ver 0.6				Walk the DMA block chain (ENDTX); frame ends when both PDC counters are empty (TXBUFE)
+	//	20261017 Ver 0.7				Streaming: feed the PDC from the ring instead
+	//	20261017 Ver 0.8				Back porch timed by the blank timer instead of a busy-wait + digitalWrite
+	//	20261017 Ver 0.9				Event driven refresh: start an overdue frame right away (back to back)
 	//
-	charX = textX;
-	charY = textY;
-	if (textSize > 0)
-		charSize = textSize;
-}
 
-void XYscope::printSetup(short textX, short textY, short textSize = -1,
-		short textBright = -1) {
-	//	Sets X and Y location for subsequint calls to XYscope.print(...) 
-	//
-	//	Calling parameters:
-	//	
-	//		x0, y0	Coordinate of lower left hand cornder of character cell.  Range: 0 to 4095.
-	//
-	//		textSize	Character height in pixels, Range: 16<=CharHt<=4095
-	//
-	//		textBright	Sets text brightness (%). Range: 1 to approx 255, Larger=BRIGHTER.
-	//				Values less than 25% will be less bright and or lower text quality.
-	//
-	//-----OTHER NOTES
-	//	Use int GetTextIntensity() to read current text setting.
-	//	SetTextIntensity(value) is an alternate way to set text brightness value
-	//	Returns:  NOTHING
-	//
-	//	201703610 Ver 0.0	E.Andrews	First cut
-	//
-	charX = textX;
-	charY = textY;
-	if (textSize > 0)
-		charSize = textSize;
-	if (textBright > 0)
-		setTextIntensity(textBright);
-}
+	//Retrive DACC interupt status
+	uint32_t status = xyHalDmaStatus();
+	bool frameDone = false;
+
+	if (_ringList != NULL) {
+		streamAdvance(status);
+		return;
+	}
+
+	//More blocks to go?  Hand the next one to the PDC and stay unblanked.
+	if (chainAdvance(status))
+		return;
+
+	if ((status & XYHAL_TXBUFE) == XYHAL_TXBUFE) {//Verify the whole chain has really been sent
+		//digitalWrite(crtBlankingPin,HIGH);	//turnoff crt beam
+
+		//digitalWrite(crtBlankingPin,LOW);	//Keep Beam On a little while longer...
+		//digitalWrite(crtBlankingPin,LOW);	//Keep Beam On a little while longer...
+		//digitalWrite(crtBlankingPin,LOW);	//Keep Beam On a little while longer...
+		//digitalWrite(crtBlankingPin,HIGH);	//turnoff crt beam
+		///digitalWrite(crtBlankingPin,LOW);	//turnoff crt beam}
+		///digitalWrite(crtBlankingPin,HIGH);	//turnoff crt beam}
+		///digitalWrite(crtBlankingPin,LOW);	//turnoff crt beam}
+		///digitalWrite(crtBlankingPin,LOW);	//turnoff crt beam}
+
+		xyHalDmaIrqDisable(XYHAL_ENDTX | XYHAL_TXBUFE);//disable interrupts.  TXBUFE = Interrupt when both PDC counters are empty
+		swapBuffers();	//DMA is idle; safe to make a presented BACK buffer the new FRONT buffer
+		_frameCount++;
+		frameDone = true;
+		//ENDTX = End of Transmit Buffer.  ENDTX is set when DACC_TCR = 0.
+		//This statis check is insurance to be sure it is safe to start updating DMA registers
+		//This interlocks with ENDTX status bit so that we only change and update the DMA registers inbetween active DMA transfers.
+		// //digitalWrite(crtBlankingPin,HIGH);	//Reset External Sync Signal
+		//Update CURRENT REGISTER SET to get it ready for next DMA Operation
+		// //DACC->DACC_TPR = (uint32_t)XYlist;		//(DACC_TPR) = Transmit (source data) Pointer Register
+		//Set this register to the starting address of the XYList[] array)
+		// //DACC->DACC_TCR = XYlistEnd;				//(DACC_TCR)= Transmit Counter Register. Loading this value initiates the start of a transfer
+		//The TCR should be set to number of integers we want to happen for each DMA transfer.
+		//In this case, XYlistEnd is always pointing at the last element of array XYlist[].	
+		//So...Set this TCR register = XYlistEnd counter value
+
+		//NVIC_DisableIRQ(DACC_IRQn);			//Disable DACC IRQ in the Nested Vectored Interrupt Controller (NVIC)
+		//NVIC_ClearPendingIRQ(DACC_IRQn);	//Clear any pending DACC IRQ in the Nested Vectored Interrupt Controller (NVIC)
+		//NVIC_EnableIRQ(DACC_IRQn);			//Now, ENABLE DACC IRQ in the Nested Vectored Interrupt Controller (NVIC)
+		//dacc_enable_interrupt(DACC, DACC_IER_ENDTX);	//Enable DAC interrupt.
+		//dacc_enable_interrupt(DACC, DACC_IER_TXBUFE);	//Enable DAC interrupt. DACC_IER_TXBUFE = Interrupt at End_of_Transmit_Buffer_EMPTY event
 
-void XYscope::print(char* text) {
-	print(text, bool(false));
-	return;
+	}
+
+	xyHalBlankAfter(backPorchBlankCount);	//BLANK display once the last point has been plotted (~60ns per count, timer driven)
+
+	if (frameDone && _refreshPending) {		//Event driven refresh: minimum frame period already over
+		_refreshPending = false;
+		_backToBack = true;
+		initiateDacDma();
+		_backToBack = false;
+	}
+
+	void (*frameCallback)(uint32_t) = _frameCallback;
+	if (frameDone && frameCallback != NULL)
+		frameCallback(_frameCount);	//Beam is already blanked, so callback time does not show on the screen
 }
-void XYscope::print(char* text, bool UL_Flag = false) {
-	//	Print text sring to screen at current x-y locations. 
+
+//void initiateDacDma(short& ArrayPtr,int NumOfPoints){
+
+void XYscope::initiateDacDma(void) {
 	//
-	//	Calling parameters:
-	//	
-	//		text	String of text to be printed to screen
+	//	This routine will initiate a DMA transfer of the current XYlist of points to DAC0 (X) & DAC1 (Y)
+	//	causing the points to "paint" onto the CRT screen.  It is called from the DacHandler ISR routine.
 	//
-	//		UL_Flag	Boolean, true=UNDERLINE text, False=NO-UNDERLINE
+	//	Timer3 is used to trigger this routine every 'refreshPeriodMs'.  Usually refreshPeriodMs is a constant
+	//	(defined in XYscope.h) that is normally set to a value in the 16 to 32 range of values.  The XY points
+	//	will be repainted and with the help of POV (persistance of vision) appear continuously to the observer.
+	//	If refreshPeriodms is set too long, the screen image will flicker or be noticably blinking.
 	//
-	//  Other Notes
-	//		Use PrintSetup(...) to set XY locations, textSize, and textBrightness
+	//	Calling parameters: NONE
 	//
-	//	Returns:  NOTHING
+	//	Returns:	NOTHING
 	//
-	//	201703610 Ver 0.0	E.Andrews	First cut
-	//	
-	int textPtr = 0;
-	while (text[textPtr] != 0) {
-		if (UL_Flag)
-			plotCharUL(text[textPtr], charX, charY, charSize);
+	//	20170418 Ver 0.0	E.Andrews	First cut.
+	//	20170724 Ver 0.1	E.Andrews	Reworked to automatically adjust FRONT PORCH blanking signal
+	//									based on active DMA clock rate.
+	//	20261017 Ver 0.2				PDC register access goes through the HAL (xyHalDmaStart)
+	//	20261017 Ver 0.3				Paint the FRONT buffer when double buffering
+	//	20261017 Ver 0.4				Skip refresh while a beginEdit()/commitEdit() window is open
+	//	20261017 Ver 0.5				Transfer is a chain of blocks (background layer + dynamic list)
+	//	20261017 Ver 0.6				Static (FLASH) lists are chained after the dynamic list
+	//	20261017 Ver 0.7				Dynamic list may continue into extra chunks (scatter-gather)
+	//	20261017 Ver 0.8				Display program points are generated after the chain (ping-pong staging buffers);
+	//									a refresh never cuts a running display program short
+	//	20261017 Ver 0.9				Packed list is decoded into the staging buffers after the display program
+	//	20261017 Ver 1.0				Do nothing while streaming
+	//	20261017 Ver 1.1				Pool objects are chained after the dynamic list
+	//	20261017 Ver 1.2				Front porch timed by the blank timer instead of a busy-wait + digitalWrites;
+	//									millis() is only read when the screen saver is on
+	//	20261017 Ver 1.3				Event driven refresh: arm the one-shot refresh timer, or leave the start to
+	//									dacHandler() while the last frame is still being painted
+	//	20261017 Ver 1.4				Interlaced list is painted one field per refresh from the staging buffers
+	//	20261017 Ver 1.5				Repeated segments are chained more than once
+	//	20261017 Ver 1.6				Event driven refresh: keep the one-shot running while a start is deferred
+	//	20261017 Ver 1.7				Field count latched once per refresh (_fldCount)
+	//	20261018 Ver 1.8				Event driven refresh: re-arm the one-shot only while the ring drains after
+	//									streamEnd(), or (no sooner than refreshRetryUs) while a refresh is held off
+
+	//Event driven refresh (see setEventRefresh).  The refresh timer is a one-shot that marks the earliest start of
+	//the next frame.  If this frame is still being painted, dacHandler() starts the next one as soon as it ends, so
+	//the one-shot is NOT armed again: at minFrame_us = 0 it would fire every few microseconds all frame long.  The
+	//exception is the last ring blocks after streamEnd(), whose end dacHandler() does not see: retry once they are out.
+	if (_eventRefresh && _ringList == NULL) {
+		if ((xyHalDmaStatus() & XYHAL_TXBUFE) == 0) {
+			if (_ringDrain_us != 0)
+				xyHalRefreshTimerOnce(_ringDrain_us);
+			else
+				_refreshPending = true;
+			return;
+		}
+		_ringDrain_us = 0;
+	}
+
+	if (_ringList != NULL)		//Streaming: the DACC ISR keeps the DMA going by itself (streamEnd() restarts the one-shot)
+		return;
+
+	//Reader side of the edit protocol (see beginEdit).  Stay blanked and try again next refresh (event driven:
+	//commitEdit() starts the refresh, the one-shot is only a backstop).
+	if ((_editSeq & 1) != 0) {
+		_deferredRefreshes = _deferredRefreshes + 1;
+		if (_eventRefresh) {
+			_refreshPending = true;
+			xyHalRefreshTimerOnce(refreshRetryUs());
+		}
+		return;
+	}
+	//Display program still generating the last refresh (program longer than the refresh period): let it finish.
+	if (_streamSource != streamNone) {
+		_deferredRefreshes = _deferredRefreshes + 1;
+		if (_eventRefresh)
+			xyHalRefreshTimerOnce(refreshRetryUs());
+		return;
+	}
+	if (_eventRefresh)
+		xyHalRefreshTimerOnce(ActiveRefreshPeriod_us);	//Earliest start of the next frame
+	xyHalMemoryBarrier();
+
+	//Pick up a presented BACK buffer in case the ENDTX interrupt did not get to it.
+	swapBuffers();
+
+	//Build the block chain for this refresh and START the transfer: the background layer (if any),
+	//then the dynamic list, then any static lists.  In single buffer mode, XYlistEnd is always pointing at the last element of the list.
+	_dmaBlockCount = 0;
+	chainAdd(_bgList, _bgPoints);
+	_fldCount = _fields;	//Read ONCE: loop() may change _fields (autoSetRefreshTime) while this refresh is painted
+	if (_fldCount == 1) {	//Interlaced lists are copied out one field per refresh by streamFill (streamField)
+		if (_doubleBuffer)
+			chainAdd(_dmaList, _dmaListEnd);
 		else
-			plotChar(text[textPtr], charX, charY, charSize);
-		textPtr++;
+			chainAddSegments(_dmaList, _plotListSize, XYlistEnd);
 	}
+	chainAddPool();
+	for (int i = 0; i < MaxStaticLists; i++)
+		chainAdd(_staticList[i].list, _staticList[i].points);
+	streamReset();
+	chainStart();
+
+	//Now that DMA transfer is underway, we must UNBLANK the Z-Axis by setting the Blanking Pin LOW, once
+	//actual data is starting to appear at DAC0/DAC1.  The blank timer makes that edge frontPorchBlankCount
+	//(~60ns per count) from now, so this ISR does not have to wait for it.
+
+	if (_screenOnTime_ms != 0 && millis() > _crtOffTOD_ms)
+		xyHalBlankNow(true);	//Keep BLANKED; ScreenSave time exceeded
+	else if (_backToBack)
+		xyHalBlankPulse(backPorchBlankCount, frontPorchBlankCount);	//Last frame's back porch first, then the front porch
+	else
+		xyHalUnblankAfter(frontPorchBlankCount);	//Stay blanked for the front porch, then unblank and resume display
 
+	//Enable interrupt when the PDC needs its next block (ENDTX) or when dac runs out of data (TXBUFE)...
+	xyHalDmaIrqEnable(chainPending() ? XYHAL_ENDTX : XYHAL_TXBUFE);
 }
-void XYscope::printUnderline(int nPlaces) {
-	//	Print underline character to screen at current x-y locations.
+
+void paintCrt_isrsss() {	//TODO REMOVE THIS ROUTINE!
+	//	paintCrtISR Interrupt Service Routine
 	//
-	//	Calling parameters:
+	//	This routine will initiate a DMA transfer of the current XYlist of points to DAC0 (X) & DAC1 (Y)
+	//	causing the points to "paint" onto the CRT screen.
 	//
-	//		nPlaces	Integer, value=Number of Underline places to write
+	//	Timer3 is used to trigger this routine every 'refreshPeriodMs'.  Usually refreshPeriodMs is a constant
+	//	(defined in XYscope.h) that is normally set to a value in the 16 to 32 range of values.  The XY points
+	//	will be repainted and with the help of POV (persistance of vision) appear continuously to the observer.
+	//	If refreshPeriodms is set too long, the screen image will flicker or be noticably blinking.
 	//
-	//  Other Notes
-	//		Use PrintSetup(...) to set XY locations, textSize, and textBrightness
+	//	Calling parameters:
+	//				None.
 	//
-	//	Returns:  NOTHING
+	//	Returns:	Nothing.
 	//
-	//	201703610 Ver 0.0	E.Andrews	First cut
-	//	201703718 Ver 1.0	E.Andrews	Update to work with UNDERLINE flag
 	//
-	for (int n=nPlaces; n > 0; n--)
-		;
-	{
-		plotChar('_', charX, charY, charSize);
-	}
-	return;
+	//	20170418 Ver 0.0	E.Andrews	First cut.
+	//
+
+	//digitalWrite(crtBlankingPin,HIGH);	//Go into blanking...
+
+	// *** END TEST SIGNAL **********	TODO You can DELETE this block when scope testing is no longer needed
+	const uint8_t Led13 = 13;//	*	Attach scope probe to pin 13 to monitor entry and exit into this routine
+	digitalWrite(Led13, HIGH);	//	*   Entering ISR, Set LED13=HIGH
+	// *** END TEST SIGNAL **********
+
+	//initiateDacDma();	//Start the DMA transfer to paint the CRT screen
+
+	// *** END TEST SIGNAL **********	TODO You can DELETE this block when scope testing is no longer needed
+	digitalWrite(Led13, LOW);	//	*	Leaving ISR, Set LED13=LOW
+	// *** END TEST SIGNAL **********
+
 }
-void XYscope::print(int number) {
-	//	Print integer number to screen at current x-y locations.
+
+void XYscope::disableDac(void) {
+	xyHalDmaIrqDisable(XYHAL_ENDTX | XYHAL_TXBUFE);
+	_streamSource = streamNone;	//Staging buffers will not be filled again for this refresh
+}
+
+void XYscope::setScreenSaveSecs(long ScreenOnTime_sec) {
+	//	Routine to set/change the screen-save period.
 	//
 	//	Calling parameters:
 	//
-	//		number	Integer, value to be printed to screen
+	//	ScreenOnTime_sec	The time that the display will remain active after the last plotPoint call.
+	//						This screen timer begins after the LAST plotPoint command is executed;
+	//						Display will blank when timer expires.
 	//
-	//	Returns:  NOTHING
+	//						ScreenOnTime_Sec = 0 means that the screen saver function is OFF.
 	//
-	//  Other Notes
-	//		Use PrintSetup(...) to set XY locations, textSize, and textBrightness
+	//	Returns:	Nothing.
 	//
-	//	201703610 Ver 0.0	E.Andrews	First cut
-	//	201703718 Ver 1.0	E.Andrews	Update to work with UNDERLINE flag
+	//	20170705 Ver 0.0	E.Andrews	First cut
 	//
-
-	print(number, bool(false));
-	return;
+	_screenOnTime_ms = ScreenOnTime_sec * 1000;
+	if (_screenOnTime_ms != 0)
+		_crtOffTOD_ms = millis() + _screenOnTime_ms;
 }
-void XYscope::print(int number, bool UL_Flag = false) {
-	//	Print integer number to screen at current x-y locations. 
+long XYscope::getScreenSaveSecs(void) {
+	//	Routine to get the screen-save period.
 	//
 	//	Calling parameters:
-	//	
-	//		number	Integer, value to be printed to screen
-	//
-	//		UL_Flag	Boolean, true=UNDERLINE text, False=NO-UNDERLINE
 	//
-	//	Returns:  NOTHING
+	//	ScreenOnTime_sec	The time that the display will remain active when there is no plotPoint activity.
+	//						This screen timer begins after the LAST plotPoint command is executed.
+	//						ScreenOnTime_Sec = 0 means that the screen saver function is OFF
+	//						and the screen continuously on.
 	//
-	//  Other Notes
-	//		Use PrintSetup(...) to set XY locations, textSize, and textBrightness
+	//	Returns:	ScreenOnTime_sec
 	//
-	//	201703610 Ver 0.0	E.Andrews	First cut
-	//	201703718 Ver 1.0	E.Andrews	Add UNDERLINE capability
+	//	20170705 Ver 0.0	E.Andrews	First cut
 	//
-
-	char charsToPrint[30] = { 0 };
-	int digitCount = 0;
-
-	if (number < 0) {
-		//Serial.print("-");
-		if (UL_Flag)
-			plotCharUL('-', charX, charY, charSize);
-		else
-			plotChar('-', charX, charY, charSize);
-		number = abs(number);		//Convert NEG number to POSITIVE
-	}
-	//Disect value, extract individual digits into array and count digits extracted
-	if (number == 0) {
-		charsToPrint[0] = '0';
-		digitCount = 0;
-	} else {
-		while (number > 0 && digitCount < 30) {
-			//Serial.print("  Extracted["); Serial.print(digitCount); Serial.print("]:"); Serial.print(number%10);
-			//Extract least significant digit and store it into array as an ASCII character
-			charsToPrint[digitCount] = '0' + number % 10;
-			number = number / 10;
-			digitCount++;
-		}
-		digitCount--;
-	}
-
-	//Serial.println();
-
-	//Now print stored Ascii digits in proper order!
-	for (int i = digitCount; i >= 0; i--) {
-		//Serial.print( i);Serial.print(":");Serial.print(charsToPrint[i]);Serial.print("   ");
-		//Print each char digit to the screen!
-		if (UL_Flag)
-			plotCharUL(charsToPrint[i], charX, charY, charSize);
-		else
-			plotChar(charsToPrint[i], charX, charY, charSize);
-
-	}
-	//Serial.println();
+	return _screenOnTime_ms / 1000;
 }
 
-void XYscope::print(float number) {
-	//	Print floating point number to screen at current x-y locations. 
+void XYscope::setRefreshPeriodUs(uint32_t refresh_us) {
+	//	Routine to set/change the refresh timer.  User can call any time to change the refresh period.
 	//
 	//	Calling parameters:
-	//	
-	//		number	Floating point value to be printed to screen, defaults to show two digits to the right of the DP displayed.
 	//
-	//	Returns:  NOTHING
+	//	refresh_us	Refresh period in microseconds (us). Value is nominally 15000 < refresh_us < 33000.
 	//
-	//  Other Notes
-	//		Use PrintSetup(...) to set XY location, textSize, and textBrightness
+	//	CAUTIONS:
+	//	1) 	For short persistance phosphors, refresh_us may need to <25000 (25 ms)
+	//	   	to prevent display flicker.
+	//	2)	If refresh time is set too short, the whole display list may not be visualized.
 	//
-	//	201703610 Ver 0.0	E.Andrews	First cut
+	//	Returns:	Nothing.
 	//
-
-	print(float(number), 2, bool(false));//Default: 2 places to the right of the DP.
-
+	//	20170705 Ver 0.0	E.Andrews	First cut
+	//	20261017 Ver 0.1				Event driven refresh: sets the minimum frame period (see setEventRefresh)
+	//
+	ActiveRefreshPeriod_us = refresh_us;//Store the value as the ActiveRefreshPeriod
+	if (!_eventRefresh)
+		xyHalRefreshTimerStart(refresh_us);	//Set the refresh timer
 }
-
-void XYscope::print(float number, int placesToPrint = 2) {
-	//	Print floating point number to screen at current x-y locations. 
+long XYscope::getRefreshPeriodUs(void) {
+	//	Routine to Get the refresh timer.  User can call any time to change the refresh period.
 	//
 	//	Calling parameters:
-	//	
-	//		number			Float, value to be printed to screen, defaults to show two digits to the right of the DP displayed.
 	//
-	//		placesToPrint	Integer, value defines number ot digits to the right of the dec point that should be plotted.
+	//	refresh_us	Refresh period in microseconds (us). Value is nominally 15000 < refresh_us < 33000.
 	//
-	//	Returns:  NOTHING
+	//	CAUTIONS:
+	//	1) 	For short persistance phoshors, refresh_us may need to <25000 (25 ms)
+	//	   	to prevent display flicker.
+	//	2)	If refresh time is set too short, the whole display list may not be visualized.
 	//
-	//  Other Notes
-	//		Use PrintSetup(...) to set XY location, textSize, and textBrightness
+	//	Returns:	Currently active refresh period (in microseconds)
 	//
-	//	201703610 Ver 0.0	E.Andrews	First cut
+	//	20170705 Ver 0.0	E.Andrews	First cut
 	//
 
-	print(float(number), placesToPrint, bool(false));
-
+	return ActiveRefreshPeriod_us;
 }
 
-void XYscope::print(float number, int placesToPrint = 2, bool UL_Flag = false) {
-	//	Print floating point number to screen at current x-y locations.
-	//
-	//	Calling parameters:
-	//
-	//		number			Float, value to be printed to screen, defaults to show two digits to the right of the DP displayed.
-	//
-	//		placesToPrint	Integer, value defines number ot digits to the right of the dec point that should be plotted.
+void XYscope::autoSetRefreshTime(void) {
+	//	This routine automatically adjusts the crt refresh period.  Time will be
+	//	set based to CrtMinRefresh_ms OR TimeReqdToPlotAllPoints_us, whichever
+	//  is larger. User should call this function.
 	//
-	//		UL_Flag=false	Boolean, TRUE=underline digits, FALSE= do not underline digits
+	//	Call this routine AFTER every major write the XYlist to be sure all points are
+	//	visualized.
 	//
-	//	Returns:  NOTHING
+	//	Calling parameters: NONE
 	//
-	//  Other Notes
-	//		Use PrintSetup(...) to set XY locations, textSize, and textBrightness
+	//	Returns:	NOTHING.
+	//  Other Notes:  Use GetRefreshPeriodUs() routine to retrieve the active value.
 	//
-	//	201703610 Ver 0.0	E.Andrews	First cut
+	//	201707017 Ver 0.0	E.Andrews	First cut
+	//	20261017 Ver 0.1				Count the points generated by the display program during the last refresh
+	//	20261017 Ver 0.2				Count the points in the packed store
+	//	20261017 Ver 0.3				Count the points in the object pool
+	//	20261017 Ver 0.4				Nothing to do for event driven refresh
+	//	20261017 Ver 0.5				Auto interlace: pick the number of fields, count one field of the list
+	//	20261017 Ver 0.6				Count repeated segment points
 	//
 
-	//check and bound placesToPrint to a reasonable number
-	if (placesToPrint < 0 || placesToPrint > 10)
-		placesToPrint = 2;	//Reset placesToPrint to reasonable number if it's out of bounds!
+	uint32_t crtRefreshTime_us, TimeReqdToPlotAllPoints_us;
 
-	if (number < 0) {
-		//Serial.print("-");
-		//Plot a NEGATIVE sign for negative numbers
-		if (UL_Flag)
-			plotCharUL('-', charX, charY, charSize);
-		else
-			plotChar('-', charX, charY, charSize);
+	// Points painted every refresh besides the list.  Add a "20 Point Buffer" into the calculation to ensure float
+	// to integer round off errors do not result in over-run conditions.
+	uint32_t otherPoints = _bgPoints + _poolPoints + _staticPoints + _genLastPoints + _packPoints + 20;
+	if (!_doubleBuffer)
+		for (int s = 0; s < _segmentCount; s++)
+			otherPoints += (_segment[s].repeat - 1) * _segment[s].capacity;
+
+	// Auto interlace (setInterlace(0)): use as few fields as it takes to paint a field within CrtMinRefresh_ms
+	if (_interlace == 0) {
+		uint8_t fields = 1;
+		while (fields < MaxFields
+				&& DmaClkPeriod_us * 2 * (otherPoints + (XYlistEnd + fields - 1) / fields) > CrtMinRefresh_ms * 1000)
+			fields++;
+		_fields = fields;
 	}
 
-	number = abs(number);
-	int digitCount = 0;
-
-	// Figure out how many digits we will be printing for the Integer Portion of the number...
-	//intNumber=int(number);	//Capture an integer version of the floating point number
-
-	//Serial.println("  Figuring out how many digits to print...");
-	while ((number / (pow(10, digitCount))) > 9.9999999999) {
-		//Serial.print(digitCount);Serial.print("=");Serial.print(pow(10,digitCount)); Serial.print( " : "); Serial.print((number/pow(10,digitCount))); Serial.print("_");
-		digitCount++;
-	}
-	//Serial.print("  Here's the num of digits I think I must print for the Integer part: ");Serial.println(digitCount);
-	//Now print just the integer part of the number...
+	if (_eventRefresh)		//Frames follow the DMA; no period to estimate
+		return;
 
-	while (digitCount >= 0) {
-		number = abs(number);	//disect and print it as a positive number...
-		int digitToPrint = number / pow(10, digitCount);
-		char charToPrint = '0' + digitToPrint;
-		//plotChar(charToPrint,charX,charY,charSize);;	//Convert each digit to a single ASCII character and print it!
-		if (UL_Flag)
-			plotCharUL(charToPrint, charX, charY, charSize);
-		else
-			plotChar(charToPrint, charX, charY, charSize);//Convert digit to a single ASCII character and print it!
-		//Serial.print(digitToPrint); Serial.print("_");
-		//Serial.print("[");
-		//Serial.print(charToPrint);Serial.Print("]  ");
+	// Calculate the display time needed based on number of points in XYlist (one field of it when interlaced)
+	TimeReqdToPlotAllPoints_us = int(DmaClkPeriod_us * 2 * (otherPoints + (XYlistEnd + _fields - 1) / _fields));
 
-		number = number - digitToPrint * pow(10, digitCount);
-		digitCount--;
+	//  Compare calculated TimeReqd.. to MinRefresh value as as spec'd in header file.
+	//  Pick which ever time is slowest....
+	if (TimeReqdToPlotAllPoints_us > CrtMinRefresh_ms * 1000) {
+		crtRefreshTime_us = TimeReqdToPlotAllPoints_us;	//Set Refresh time = to miniumn defined refreshtime or that required to get all the points to the screen...
+	} else {
+		crtRefreshTime_us = CrtMinRefresh_ms * 1000;//Min Refresh Time in microseconds...
 	}
-	// Insert DP character Here!!
-	//plotCircle(charX-int ix, int xc, int yc, int r)
-	//plotPoint();
-	if (UL_Flag)
-		plotCharUL('.', charX, charY, charSize);
-	else
-		plotChar('.', charX, charY, charSize);
-	number = number * pow(10, placesToPrint);
-	digitCount = placesToPrint - 1;
 
-	while (digitCount >= 0) {
-		number = abs(number);	//disect and print it as a positive number...
-		int digitToPrint = int(number / pow(10, digitCount));
-		//int digitToPrint=digitToPrintNoRound;
-		//int digitToPrintRoundUp = int((number+.5) / pow(10, digitCount));
-		//if (digitCount==0) digitToPrint = digitToPrintRoundUp;
-		char charToPrint = '0' + digitToPrint;
-		if (UL_Flag) plotCharUL(charToPrint, charX, charY, charSize);
-		else plotChar(charToPrint, charX, charY, charSize);//Convert digit to a single ASCII character and print it!
-		//Serial.print(digitToPrint); Serial.print("_");
-		//Serial.print("[");
-		//Serial.print(charToPrint);Serial.Print("]  ");
-		
-		//Now shift by power of 10
-		number = number - digitToPrint * pow(10, digitCount);
-		digitCount--;
+	//	Now see if we need to actually change the refresh timer...
+	//  Only Update REFRESH timer period (microseconds) when new time <> currently active timer
+	if (ActiveRefreshPeriod_us != crtRefreshTime_us) {
+		xyHalRefreshTimerStart(crtRefreshTime_us);	//Upadate Timer Period
+		ActiveRefreshPeriod_us = crtRefreshTime_us;	//Store new value "ActiveRefreshPeriod_us"
 	}
-	//Serial.println();
 
 }
 
-void XYscope::setDmaClockRate(uint32_t New_XfrRate_hz) {
-	//	Routine to setup Timer Counter 0 which is used to clock DMA transformers.
-	//	(This is just a CALLER FREINDLIER version of txSetup)
-	//
-	//	Begin automatically calls this routine.  User only needs to call this 
-	//	this routine if he/she wants to change clock rate during runtime.
-	//
-	//	Calling parameters:
-	//	
-	//	New_XfrRateHZ	This is the intended DMA Transfer Rate in Hertz.
-	//				Note that Point_Clk_Freq = XfrRateHz/2.
+void XYscope::setEventRefresh(bool enable, uint32_t minFrame_us) {
+	//	Routine to select how refreshes are scheduled.
 	//
-	//	CAUTIONS:	Usual XfrRateHz values should be in 300,000 to 800,000 range.
+	//	Fixed period (default): Timer3 starts a refresh every getRefreshPeriodUs() microseconds.  The period is
+	//	an estimate (see autoSetRefreshTime); too short and frames are cut off, too long and the CRT sits idle.
 	//
-	//				Lower values make the screen refresh take longer and therefore
-	//				reduces the total number of points that can be displayed before
-	//				CRT flicker becomes visually apparant.
+	//	Event driven: each refresh is started from the end of the previous one.  A frame starts when the last one
+	//	has been painted (DACC ISR, TXBUFE), but no sooner than minFrame_us after the start of the last one.
+	//	Heavy scenes are painted back to back; light ones are capped at 1/minFrame_us frames per second.  The
+	//	refresh timer is only used as a one-shot for the minimum period; its registers are written directly
+	//	rather than through DueTimer::start().  autoSetRefreshTime() does nothing in this mode, and
+	//	setRefreshPeriodUs() changes the minimum frame period.
 	//
-	//				Higher values demand more of the XY display/oscilloscope 
-	//				hardware but do allow more points to be plotted before refresh
-	//				flicker is a apparent.
+	//	Calling parameters:
+	//		enable			true = event driven, false = fixed period
+	//		minFrame_us		Minimum frame period (event driven).  0 = paint frames back to back.
 	//
-	//	Returns:	Nothing.
-	//	Other Notes:
-	//		This routine calculates and set the front and back porch of the blanking signals
-	//		based on the clock rate specified when it is called.
+	//	Returns: NOTHING.  When switching back to a fixed period, the period is the last minimum frame period;
+	//	call autoSetRefreshTime() or setRefreshPeriodUs() to change it.
 	//
-	//	20170405 Ver 0.0	E.Andrews	First cut
+	//	20261017 Ver 0.0				First cut
+
+	beginEdit();			//DMA idle; no new refresh can start
+	if (enable) {
+		xyHalRefreshTimerStop();
+		ActiveRefreshPeriod_us = minFrame_us;
+	}
+	_refreshPending = false;
+	_eventRefresh = enable;
+	commitEdit();
+	if (enable)
+		xyHalRefreshTimerOnce(0);		//First frame right away
+	else {
+		if (ActiveRefreshPeriod_us == 0)
+			ActiveRefreshPeriod_us = CrtMinRefresh_ms * 1000;
+		xyHalRefreshTimerStart(ActiveRefreshPeriod_us);
+	}
+}
+
+bool XYscope::getEventRefresh() {
+	//	Routine to retrieve the refresh mode (see setEventRefresh).
 	//
-	//This routine sets up TimerCounter0
-	//TC0 is used to drive DAC0 & dAC1
+	//	20261017 Ver 0.0				First cut
+	return _eventRefresh;
+}
 
-	tcSetup(New_XfrRate_hz);
-	DmaClkPeriod_us = (float(1 / float(New_XfrRate_hz)) * 1000000.);
-	//Calculate new value and Update the 'FRONT-PORCH' blankCount
-	//serial.print("\n   DmaClkPeriod_us=");Serial.print(DmaClkPeriod_us);Serial.print("  blankCount=").Serial.println(blankCount);
-	frontPorchBlankCount = int(DmaClkPeriod_us * 186.23 - 52.1 + .5);
-	backPorchBlankCount = int(DmaClkPeriod_us * 79. - 36 + .5);
-	Serial.print("\n   DmaClkPeriod_us=");
-	Serial.print(DmaClkPeriod_us);
-	Serial.print("  frontPorchBlankCount=");
-	Serial.print(frontPorchBlankCount);
-	Serial.print(", backPorchBlankCount=");
-	Serial.println(backPorchBlankCount);
+uint32_t XYscope::refreshRetryUs() {
+	//	Routine to get the delay before an event driven refresh that had to be held off (edit window, display
+	//	program) is tried again: the minimum frame period, but no less than CrtMinRefresh_ms, so a short
+	//	minimum frame period does not turn the one-shot into an interrupt storm.
+	//
+	//	20261018 Ver 0.0				First cut
 
+	uint32_t floor_us = CrtMinRefresh_ms * 1000;
+	return ActiveRefreshPeriod_us > floor_us ? ActiveRefreshPeriod_us : floor_us;
 }
 
-void XYscope::tcSetup(uint32_t New_XfrRateHz) {
-	//	Routine to setup Timer Counter 0.  TC0 is used to clock DMA transformers.
+void XYscope::setInterlace(uint8_t fields) {
+	//	Routine to split the display list into interlaced fields.
 	//
-	//	User does NOT usually directly call this routine; XYscope.Begin automatically
-	//	does Counter timer setup.
+	//	When the list takes longer to paint than CrtMinRefresh_ms, stretching the refresh period makes the whole
+	//	display flicker.  With N fields, each refresh paints every Nth point of the list only (field 0: points
+	//	0, N, 2N...; field 1: points 1, N+1...), so a refresh takes about 1/N of the time.  Every stroke, and
+	//	so every part of the screen, is still drawn each refresh; its dots simply take turns.
 	//
 	//	Calling parameters:
-	//	
-	//	XfrRateHZ	User specifies the desired intended DMA Transfer Rate in Hertz.
-	//				Note that Point_Clk_Freq = XfrRateHz/2.
-	//
-	//				Typically, XfrRateHz should be in the 300,000-800,000 range.
-	//				User may need to experiment with this value to see what works best
-	//				for the'scope'being used as a display screen.
+	//		fields	1 = off (default), 2 to MaxFields = that many fields,
+	//				0 = automatic: autoSetRefreshTime() picks the fewest fields (up to MaxFields) that fit the list
+	//				into CrtMinRefresh_ms.  Call autoSetRefreshTime() after plotting, as usual.
+	//
+	//	Returns: NOTHING.
+	//
+	//	Notes:
+	//	1)	Only the dynamic list (XYlist, including chunks and the double buffer) is interlaced.  The background
+	//		layer, pool objects, static lists, display program and packed list are painted every refresh.
+	//	2)	The field is copied from the DACC ISR into the staging buffers (after the other staging sources), so
+	//		the dynamic list is painted last instead of first.
+	//	3)	Every refresh (field) counts as a frame (see getFrameCount).
+	//
+	//	20261017 Ver 0.0				First cut
+
+	if (fields > MaxFields)
+		fields = MaxFields;
+	beginEdit();
+	_stage = stageBuffers;
+	_interlace = fields;
+	_fields = fields > 1 ? fields : 1;
+	_field = 0;
+	commitEdit();
+	if (fields == 0)
+		autoSetRefreshTime();
+}
+
+void XYscope::setLodControl(bool enable, uint32_t targetFrame_us) {
+	//	Routine to turn the level of detail (LOD) controller on or off.
 	//
-	//				Smaller values make the screen refresh take longer and therefore
-	//				reduces the total number of points that can be displayed before
-	//				CRT flicker becomes visually apparant.
+	//	Without it, a growing scene either stretches the refresh period (autoSetRefreshTime: flicker) or runs
+	//	out of list room (plotPoint drops the rest of the scene).  With it, every plotStart() looks at the scene
+	//	being replaced: how long it takes to paint (all points, as autoSetRefreshTime counts them) against
+	//	targetFrame_us, and whether it overflowed the list.  The dot spacing of lines, arcs and characters for
+	//	the NEXT scene is then scaled so that scene comes in at about 90% of the target.  Nothing changes while
+	//	the scene takes 80% to 100% of the target (hysteresis), so a steady scene keeps a steady look.
 	//
-	//				Larger values demand more of the XY display/oscilloscope 
-	//				hardware but do allow more points to be plotted before refresh
-	//				flicker is a apparent.
+	//	The level of detail works on top of setGraphicsIntensity()/setTextIntensity(): at level L percent the
+	//	dot spacing is the intensity's spacing * 100 / L.  Points that do not depend on the dot spacing (the
+	//	background layer, pool objects, static lists, plotPoint/plotPoints) are counted but not scaled.
 	//
-	//	Returns:	Nothing.
+	//	Calling parameters:
+	//		enable			true = controller on, false = off (full detail)
+	//		targetFrame_us	Frame time budget (default: CrtMinRefresh_ms)
 	//
-	//	20170405 Ver 0.0	E.Andrews	First cut
+	//	Returns: NOTHING.  See getLodLevel().
 	//
+	//	20261017 Ver 0.0				First cut
 
-	if (New_XfrRateHz > 0)	//DO NOTHING if XfrRateHz is zero or less.
-			{
-		uint32_t tcTicks = FreqToTimerTicks(New_XfrRateHz);	//Convert "Hz value" to "Clock Ticks"
-		// Send TC0 Clock signal to external pin so AGS hardware can se it to sync things up
-		int ulPin = 2; // just an example:   it's 2  for the Timer0 TIOAO
-		PIO_Configure(g_APinDescription[ulPin].pPort,
-				g_APinDescription[ulPin].ulPinType,
-				g_APinDescription[ulPin].ulPin,
-				g_APinDescription[ulPin].ulPinConfiguration);
-
-		// Enable TC0  
-		pmc_enable_periph_clk (TC_INTERFACE_ID);
-
-		//Set Mode and Frequency of TC0
-		Tc * tc = TC0;
-		TcChannel * t = &tc->TC_CHANNEL[0];
-		t->TC_CCR = TC_CCR_CLKDIS;
-		t->TC_IDR = 0xFFFFFFFF;
-		t->TC_SR;
-		t->TC_RC = tcTicks;    		// Sets PERIOD of timer in "tcTicks" units
-		t->TC_RA = (tcTicks - tcTicks / 2);	// Use this value to alter clock signal symmetry...(tcTicks/2 = 50%)
-
-		//TC_CMR = Timer Counter Channel Mode Register, a four byte register used to set WAVEFORM MODE
-		//	Note: Since the DUE MCK = 84 MHz, the following master clock source settings are available
-		// 		TC-CMR_TCCLOCKS_TIMER_CLOCK1 sets the clock source to be =  MCK/2  (48.0   MHz)
-		// 		TC-CMR_TCCLOCKS_TIMER_CLOCK2 sets the clock source to be =  MCK/8  (10.5   MHz)
-		// 		TC-CMR_TCCLOCKS_TIMER_CLOCK3 sets the clock source to be =  MCK/32 ( 2.652 MHz)
-		// 		TC-CMR_TCCLOCKS_TIMER_CLOCK3 sets the clock source to be =  MCK/128( 0.65625 MHz or 656.25 KHz)
-		t->TC_CMR = TC_CMR_TCCLKS_TIMER_CLOCK1 | TC_CMR_WAVE
-				| TC_CMR_WAVSEL_UP_RC;
-		t->TC_CMR = (t->TC_CMR & 0xFFF0FFFF) | TC_CMR_ACPA_CLEAR
-				| TC_CMR_ACPC_SET;
-		t->TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
-
-		//Setup is done; Remember the setting for later recall as needed
-		DmaClkFreq_Hz = New_XfrRateHz;
+	_lodEnable = enable;
+	_lodTarget_us = targetFrame_us;
+	if (!enable) {
+		_lodLevel = 100;
+		setGraphicsIntensity(_graphBrightness);	//Back to full detail
+		setTextIntensity(_textBrightness);
 	}
 }
 
-void XYscope::dacSetup(void) {
-	//	Routine to setup DAC and Interrupt Controller for DMA transformers.
-	//
-	//	User calls this once during SETUP.
-	//
-	//	Calling parameters:
-	//	
-	//	None
+uint8_t XYscope::getLodLevel() {
+	//	Routine to retrieve the level of detail picked by the LOD controller (see setLodControl).
 	//
-	//	Returns:	Nothing.
-	//		ix		Returns updated pointer into array where next graphics point will go.
+	//	Returns: Percent: 100 = full detail, down to LodMinLevel
 	//
-	//	20170407 Ver 0.0	E.Andrews	First cut
+	//	20261017 Ver 0.0				First cut
+	return _lodLevel;
+}
+
+uint8_t XYscope::getInterlace() {
+	//	Routine to retrieve the number of fields in use (see setInterlace).
 	//
+	//	20261017 Ver 0.0				First cut
+	return _fields;
+}
+
+/****************************************************************************/
+/* Private Functions */
+/****************************************************************************/
 
-	//----------------------------------------------------    
-	//  DAC SETUP
-	//----------------------------------------------------
-	pmc_enable_periph_clk (DACC_INTERFACE_ID); 	// start clocking DAC
+int XYscope::lodDensity(int density) {
+	//	Dot spacing at the current level of detail (see setLodControl).
+	//
+	//	20261017 Ver 0.0				First cut
 
-	dacc_reset (DACC);		//This returns DAC hardware to power-up conditions
+	if (_lodLevel >= 100)
+		return density;
+	return (density * 100 + _lodLevel / 2) / _lodLevel;
+}
 
-	dacc_set_transfer_mode(DACC, 0);//for this variable, 0=HALFWORD_MODE (16 bits integers) or 1=FULLWORD_MODE (32 bit integers)
-	dacc_set_power_save(DACC, 0, 0);	//Setup of DAC Power_Save option
-	// Set DACC Analog Current Register - Use typical recommended values of 0x01 for IBCTLDACCORE and 0x02 for IBCTLCH0/IBCTLCH1
-	// This may sets the slew rate of DACC register & IBCTLDACCH0/IBCTLDACCH1:
-	dacc_set_analog_control(DACC,
-			DACC_ACR_IBCTLCH0(0x02) | DACC_ACR_IBCTLCH1(0x02)
-					| DACC_ACR_IBCTLDACCORE(0x01));
-	dacc_set_trigger(DACC, 1);
+void XYscope::lodUpdate(void) {
+	//	Level of detail controller step; called by plotStart() while the old list is still there.
+	//	The points that follow the dot spacing are taken to scale with the level of detail, the rest are fixed.
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Overflow is taken from _listFull (plotErr also flags off-screen figures)
+
+	uint32_t budget = uint32_t(_lodTarget_us / (DmaClkPeriod_us * 2));		//Points that fit in the target frame time
+	uint32_t fixedPoints = _bgPoints + _poolPoints + _staticPoints + 20;		//Counted as autoSetRefreshTime does
+	uint32_t scaledPoints = (XYlistEnd + _fields - 1) / _fields + _genLastPoints + _packPoints;
+	if (_listFull)
+		scaledPoints *= 2;			//List overflowed: the scene was larger than what got plotted
+	uint32_t points = fixedPoints + scaledPoints;
+	if (scaledPoints == 0 || (points <= budget && (points >= budget * 4 / 5 || _lodLevel >= 100)))
+		return;						//Inside the hysteresis band (or nothing to scale)
+
+	uint32_t aim = budget * 9 / 10;
+	int level = LodMinLevel;
+	if (aim > fixedPoints) {
+		uint32_t scaled = uint32_t((uint64_t(_lodLevel) * (aim - fixedPoints)) / scaledPoints);
+		level = scaled > 100 ? 100 : (scaled < LodMinLevel ? LodMinLevel : scaled);
+	}
+	if (level == _lodLevel)
+		return;
+	_lodLevel = level;
+	setGraphicsIntensity(_graphBrightness);		//Recompute the densities at the new level
+	setTextIntensity(_textBrightness);
+}
 
-	dacc_enable_channel(DACC, 0);	//Enable DAC0
-	dacc_enable_channel(DACC, 1);	//Enable DAC1
+uint32_t XYscope::FreqToTimerTicks(uint32_t freqHz) {
+	return VARIANT_MCK / 2UL / freqHz;//Converts frequency(Hz) into Timer Count values for TC programming
+}
 
-	// DACC_MR bit definitions
+void XYscope::segmentPad(int handle) {
+	//	Fill the unused slots of a segment with harmless points (see segmentOpen, Note 1).
 	//
-	//	|	31	|	30	|	29	|	28	|	27	|	26	|	25	|	24	|
-	//	+-------+-------+-------+-------+-------+-------+-------+-------+	STARTUP TIME: Time till initial startup conversion 
-	//	|		|		|<-------------- STARTUP TIME ----------------->|	0=0 periods of DACC CLOCK, 63=4032 periods of DACC CLOCK 
-	//	+-------+-------+-------+-------+-------+-------+-------+-------+	Typical value = 3 to 8. (See table on pg 1366 of HW Data Sheet for more details)
-	//
-	//	|	23	|	22	|	21	|	20	|	19	|	18	|	17	|	16	|
-	//	+-------+-------+-------+-------+-------+-------+-------+-------+	MAXS: Startup after wake up; 0=Normal (No Sleep), 1=Fast Wake up Sleep Mode
-	//	|		|		| MAXS	|  TAG	|		|		|<--USER  SEL-->|	TAG: 0=DIS (Tag Selection Mode Disabled, using USER_SEL value to chan conversion
-	//	+-------+-------+-------+-------+-------+-------+-------+-------+	USER_SEL: 0=Chan 0 Selected, 1=Chan 1 Selected (Only meaningful when TAG=1)
-	//
-	//	|	15	|	14	|	13	|	12	|	11	|	10	|	 9	|	 8	|
-	//	+-------+-------+-------+-------+-------+-------+-------+-------+	DAC AUTO REFRESH PERIOD
-	//	|<----------------------   REFRESH   -------------------------->| 	0: No DAC Refresh, >0: DAC Refresh Period = 1024 * REFRESH_VALUE/DACC_CLOCK
-	//	+-------+-------+-------+-------+-------+-------+-------+-------+
-	//
-	//	|	7	|	6	|	5	|	4	|	3	|	2	|	 1	|	 0	|
-	//	+-------+-------+-------+-------+-------+-------+-------+-------+	FAST WKUP: 0=Sleep Mode defined by SLEEP bit, 1=Fast Wak up Sleep Mode (Vref ON Between Conversions but DAC core is OFF)
-	//	|		|FSTWKUP| SLEEP	|WRD MOD|<----- TRIG SEL ------>| TRGEN	|	SLEEP: 0=Normal (No Sleep), 1=Sleep Mode (Sleeps between conversions)
-	//	+-------+-------+-------+-------+-------+-------+-------+-------+	WORD/HALF-WORD MODE: 0=Half Word Mode (16 Bit), 1=Full Word Mode (32 Bit)
-	//																		TRIG SEL: 0=Ext, 1=TC0_CH0, 2=TC0_CH1, 3=TC0_CH2,4=PWM Event_0,5=PWM Event_1,6=RESRVD,7=RESERVD
-	//																		TRGEN (Trig Enable): 0=Disabled, DACC in Free Run Mode, 1=Ext Trig mode.
-	//
-	//
-
-	//	DACC_MR REGISTER SETTINGS...
-	//		STARTUP TIME
-	DACC->DACC_MR |= 8 << 24;		//8=512 DACC clock periods of startup time.
-	//		MAXS Mode bit
-	DACC->DACC_MR |= 0 << 16;		//No Bits Set, MAXS=0 meaning NO SLEEP
-	//		TAG MODE Bit
-	DACC->DACC_MR |= 1 << 20;//TAG=1 (Bits 12,13 of incomming data selects DAC0/DAC1 destination )
-	//		DAC REFRESH 
-	DACC->DACC_MR |= 0 << 8;//No Bits Set.  REFRESH=0, meaning NO AUTO REFRESH DESIRED
-	//		FSTWKUP, SLEEP,WRD MODE, TRIG SEL, TRig ENABLE
-	DACC->DACC_MR |= 0;	//No Bits Set.  HALF_WORD MODE, EXT-TRIG, TRIG DISABLED
+	//	20261017 Ver 0.0				First cut
 
-	//----------------------------------------------------    
-	//  Interrupt Controller SETUP
-	//----------------------------------------------------
+	int start = _segment[handle].start;
+	int used = _segment[handle].used;
+	int capacity = _segment[handle].capacity;
 
-	NVIC_DisableIRQ (DACC_IRQn);//Disable DACC IRQ in the Nested Vectored Interrupt Controller (NVIC)
-	NVIC_ClearPendingIRQ(DACC_IRQn);//Clear any pending DACC IRQ in the Nested Vectored Interrupt Controller (NVIC)
-	NVIC_EnableIRQ(DACC_IRQn);//Now, ENABLE DACC IRQ in the Nested Vectored Interrupt Controller (NVIC)
+	if (used == 0) {
+		for (int i = 0; i < capacity; i++)
+			listPoint(start + i) = listPoint(start - 1);	//Segments always follow the plotStart() sync points, so start-1 exists
+	} else {
+		for (int i = used; i < capacity; i++)
+			listPoint(start + i) = listPoint(start + i - used);
+	}
+}
 
+int XYscope::poolAlloc(int capacity) {
+	//	Allocate a pool block of 'capacity' points from the first free block that is large enough.
+	//	The rest of that free block stays free.  Caller holds an edit window.
+	//
+	//	Returns: Block index, or -1 if no free block is large enough
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				New objects are not dimmed
+
+	for (int b = _poolHead; b >= 0; b = _poolBlock[b].next) {
+		poolBlock &block = _poolBlock[b];
+		if (block.state != blockFree || block.capacity < capacity)
+			continue;
+		if (block.capacity > capacity) {
+			int e = poolEntry();
+			if (e < 0)
+				return -1;
+			poolBlock &rest = _poolBlock[e];
+			rest.start = block.start + capacity;
+			rest.capacity = block.capacity - capacity;
+			rest.used = 0;
+			rest.state = blockFree;
+			rest.prev = b;
+			rest.next = block.next;
+			if (block.next >= 0)
+				_poolBlock[block.next].prev = e;
+			block.next = e;
+			block.capacity = capacity;
+		}
+		block.state = blockObject;
+		block.used = 0;
+		block.dim = 1;
+		return b;
+	}
+	return -1;
 }
 
-void XYscope::dacHandler(void) {
-	//	Routine to handls END OF TRANSFER dma interrupt.  
-	//	This ISR is called when the DMA transfer to the CRT screen is finished.
-	//	The Primary task of the routine is to set crtBlaningPin output pin to HIGH
-	//	so that the screen is turned off.
-	//
-	//	User does NOT directly call this routine.
-	//
-	//	Calling parameters:
-	//				None.
-	//
-	//	Returns:	Nothing.
-	//
-	//
-	//	20170405 Ver 0.0	E.Andrews	First cut.
-	//	20170405 Ver 0.1	E.Andrews	Reworked to play nicely with timer driven refresh inteerupt
-	//	20170526 Ver 0.2	E.Andrews	Cleaned up comments and throw out unused code fragments
+void XYscope::poolFree(int b) {
+	//	Return a block to the free space, merging it with free blocks on either side (free blocks never touch).
+	//	Caller holds an edit window.
 	//
+	//	20261017 Ver 0.0				First cut
 
-	//Retrive DACC interupt status
-	uint32_t status = dacc_get_interrupt_status(DACC);
-
-	if ((status & DACC_ISR_ENDTX) == DACC_ISR_ENDTX) {//Verify we have a true ENDTX interrupt event.
-		//digitalWrite(crtBlankingPin,HIGH);	//turnoff crt beam
+	poolBlock &block = _poolBlock[b];
+	block.state = blockFree;
+	block.used = 0;
+	int next = block.next;
+	if (next >= 0 && _poolBlock[next].state == blockFree) {
+		block.capacity += _poolBlock[next].capacity;
+		poolUnlink(next);
+		_poolBlock[next].state = blockUnused;
+	}
+	int prev = block.prev;
+	if (prev >= 0 && _poolBlock[prev].state == blockFree) {
+		_poolBlock[prev].capacity += block.capacity;
+		poolUnlink(b);
+		block.state = blockUnused;
+	}
+}
 
-		//digitalWrite(crtBlankingPin,LOW);	//Keep Beam On a little while longer...
-		//digitalWrite(crtBlankingPin,LOW);	//Keep Beam On a little while longer...
-		//digitalWrite(crtBlankingPin,LOW);	//Keep Beam On a little while longer...
-		//digitalWrite(crtBlankingPin,HIGH);	//turnoff crt beam
-		///digitalWrite(crtBlankingPin,LOW);	//turnoff crt beam}
-		///digitalWrite(crtBlankingPin,HIGH);	//turnoff crt beam}
-		///digitalWrite(crtBlankingPin,LOW);	//turnoff crt beam}
-		///digitalWrite(crtBlankingPin,LOW);	//turnoff crt beam}
+void XYscope::poolUnlink(int b) {
+	//	Take a block out of the address order list.
+	//
+	//	20261017 Ver 0.0				First cut
 
-		dacc_disable_interrupt(DACC, DACC_IER_ENDTX);//disable interrupt.  ENDTX = Interrupt at End_of_Transmit_Buffer event														//Skip this code and do nothing if not a ENDTX event
-		//ENDTX = End of Transmit Buffer.  ENDTX is set when DACC_TCR = 0.
-		//This statis check is insurance to be sure it is safe to start updating DMA registers
-		//This interlocks with ENDTX status bit so that we only change and update the DMA registers inbetween active DMA transfers.
-		// //digitalWrite(crtBlankingPin,HIGH);	//Reset External Sync Signal
-		//Update CURRENT REGISTER SET to get it ready for next DMA Operation
-		// //DACC->DACC_TPR = (uint32_t)XYlist;		//(DACC_TPR) = Transmit (source data) Pointer Register
-		//Set this register to the starting address of the XYList[] array)
-		// //DACC->DACC_TCR = XYlistEnd;				//(DACC_TCR)= Transmit Counter Register. Loading this value initiates the start of a transfer
-		//The TCR should be set to number of integers we want to happen for each DMA transfer.
-		//In this case, XYlistEnd is always pointing at the last element of array XYlist[].	
-		//So...Set this TCR register = XYlistEnd counter value
+	int prev = _poolBlock[b].prev, next = _poolBlock[b].next;
+	if (prev >= 0)
+		_poolBlock[prev].next = next;
+	else
+		_poolHead = next;
+	if (next >= 0)
+		_poolBlock[next].prev = prev;
+}
 
-		//NVIC_DisableIRQ(DACC_IRQn);			//Disable DACC IRQ in the Nested Vectored Interrupt Controller (NVIC)
-		//NVIC_ClearPendingIRQ(DACC_IRQn);	//Clear any pending DACC IRQ in the Nested Vectored Interrupt Controller (NVIC)
-		//NVIC_EnableIRQ(DACC_IRQn);			//Now, ENABLE DACC IRQ in the Nested Vectored Interrupt Controller (NVIC)
-		//dacc_enable_interrupt(DACC, DACC_IER_ENDTX);	//Enable DAC interrupt.
-		//dacc_enable_interrupt(DACC, DACC_IER_TXBUFE);	//Enable DAC interrupt. DACC_IER_TXBUFE = Interrupt at End_of_Transmit_Buffer_EMPTY event
+int XYscope::poolEntry(void) {
+	//	Find an unused entry of the block table.
+	//
+	//	20261017 Ver 0.0				First cut
 
-	}
+	for (int e = 0; e < MaxPoolBlocks; e++)
+		if (_poolBlock[e].state == blockUnused)
+			return e;
+	return -1;
+}
 
-	for (int i = backPorchBlankCount; i > 0; i--) {
-		__asm__ __volatile__("nop");
-		//loop to generate a short (~60ns per count), programmable delays
+int XYscope::sceneAdd(sceneNode &node, int capacity) {
+	//	Plot a new scene node at the end of the list and wrap a segment around it.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	if (_sceneCount >= MaxSegments || _activeSegment >= 0) {
+		plotErr = 1;
+		return -1;
 	}
-	digitalWrite(crtBlankingPin, HIGH);	//BLANK display...Last point has been plotted...
+	flush();
+	int listStart = XYlistEnd;
+	scenePlot(node);
+	int used = XYlistEnd - listStart;
+	XYlistEnd = listStart;
+	if (capacity < used)
+		capacity = used;
+	if (capacity == 0)
+		capacity = 1;		//Nothing visible (yet); keep one slot so the node can still be changed
+	int segment = segmentOpen(capacity, used);
+	if (segment < 0)
+		return -1;
+	node.segment = segment;
+	node.dirty = false;
+	_sceneNode[_sceneCount] = node;
+	return _sceneCount++;
 }
 
-//void initiateDacDma(short& ArrayPtr,int NumOfPoints){
+void XYscope::scenePlot(const sceneNode &node) {
+	//	Plot a scene node at XYlistEnd using the ordinary plot routines (never queued).
+	//
+	//	20261017 Ver 0.0				First cut
+
+	_cmdSuspend++;
+	switch (node.type) {
+	case sceneLine:
+		plotLine(node.p[0], node.p[1], node.p[2], node.p[3]);
+		break;
+	case sceneCircle:
+		plotCircle(node.p[0], node.p[1], node.p[2]);
+		break;
+	case sceneEllipse:
+		plotEllipse(node.p[0], node.p[1], node.p[2], node.p[3]);
+		break;
+	case sceneText: {
+		int savedX = charX, savedY = charY, savedSize = charSize;	//Do not disturb the user's print position
+		charX = node.p[0];
+		charY = node.p[1];
+		charSize = node.p[2];
+		print((char *) node.text, false);
+		charX = savedX;
+		charY = savedY;
+		charSize = savedSize;
+		break;
+	}
+	}
+	_cmdSuspend--;
+}
 
-void XYscope::initiateDacDma(void) {
+void XYscope::sceneSet(int node, uint8_t type, int p0, int p1, int p2, int p3) {
+	//	Update scene node parameters; mark the node dirty only when something changed.
 	//
-	//	This routine will initiate a DMA transfer of the current XYlist of points to DAC0 (X) & DAC1 (Y)
-	//	causing the points to "paint" onto the CRT screen.  It is called from the DacHandler ISR routine.
-	//
-	//	Timer3 is used to trigger this routine every 'refreshPeriodMs'.  Usually refreshPeriodMs is a constant
-	//	(defined in XYscope.h) that is normally set to a value in the 16 to 32 range of values.  The XY points
-	//	will be repainted and with the help of POV (persistance of vision) appear continuously to the observer.
-	//	If refreshPeriodms is set too long, the screen image will flicker or be noticably blinking.
+	//	20261017 Ver 0.0				First cut
+
+	if (node < 0 || node >= _sceneCount || _sceneNode[node].type != type)
+		return;
+	short *p = _sceneNode[node].p;
+	if (p[0] != p0 || p[1] != p1 || p[2] != p2 || p[3] != p3) {
+		p[0] = p0;
+		p[1] = p1;
+		p[2] = p2;
+		p[3] = p3;
+		_sceneNode[node].dirty = true;
+	}
+}
+
+void XYscope::swapBuffers(void) {
+	//	Make a presented BACK buffer the new FRONT buffer.  Called from the ISRs while the DMA is idle.
 	//
-	//	Calling parameters: NONE
+	//	20261017 Ver 0.0				First cut
+
+	if (_swapPending) {
+		_dmaList = _swapList;
+		_dmaListEnd = _swapListEnd;
+		_swapPending = false;
+	}
+}
+
+void XYscope::waitForSwap(void) {
+	//	Wait until a presented BACK buffer has been swapped in.  At most one refresh period.
 	//
-	//	Returns:	NOTHING
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				No wait while streaming
+
+	if (_editDepth > 0 || _ringList != NULL) {
+		swapBuffers();		//The DMA is not reading the list (edit window or streaming) and no refresh will do the swap for us
+		return;
+	}
+	while (_swapPending)
+		xyHalIdle();
+}
+
+void XYscope::chainAdd(const pointList *list, int points) {
+	//	Append a block to the DMA chain for the next transfer.  Empty blocks are skipped.  Blocks larger
+	//	than one PDC count (65535 Short-Integers) are split.
 	//
-	//	20170418 Ver 0.0	E.Andrews	First cut.
-	//	20170724 Ver 0.1	E.Andrews	Reworked to automatically adjust FRONT PORCH blanking signal
-	//									based on active DMA clock rate.
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Split blocks that are too large for the PDC counter
 
-	DACC->DACC_TPR = (uint32_t) XY_List;//(DACC_TPR) = Transmit (source data) Pointer Register
-	//DACC->DACC_TNPR = (uint32_t)XY_List;	//(DACC_TNPR) Transmit NEXT Pointer register. <--May not be needed...
-	//Set this register to the starting address of the XY_List[] array)
+	while (points > 0 && _dmaBlockCount < MaxDmaBlocks) {
+		int blockPoints = points < 32767 ? points : 32767;
+		_dmaBlock[_dmaBlockCount].list = list;
+		_dmaBlock[_dmaBlockCount].points = blockPoints;
+		_dmaBlockCount = _dmaBlockCount + 1;
+		list += blockPoints;
+		points -= blockPoints;
+	}
+}
 
-	DACC->DACC_TCR = XYlistEnd * 2;	//(DACC_TCR)= Transmit Count Register (TCR=How many Short-Integers to transfer).
-									//Set TCR register = XYlistEnd counter value
-	DACC->DACC_TNCR = 0;//(DACC_TNCR)= Transmit NEXT Counter Register is NOT USED; set to zero!. <--May not be needed...
-	//DACC->DACC_TNCR = XYlistEnd*2;		//(DACC_TNCR)= Transmit NEXT Counter Register. <--May not be needed...
-	//The TCR should be set to number of integers we want to happen for each DMA transfer.
-	//In this case, XYlistEnd is always pointing at the last element of array XY_List[].	
+void XYscope::chainAddPool(void) {
+	//	Append the pool objects to the DMA chain, in address order.  Objects that follow each other
+	//	without a gap go out as one block.  Dimmed objects are only added on their turn (see objectSetDim).
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Skip dimmed objects that are not due this refresh
+
+	const pointList *run = NULL;
+	int runPoints = 0;
+	uint32_t refresh = _frameCount;
+	for (int b = _poolHead; b >= 0; b = _poolBlock[b].next) {
+		const poolBlock &block = _poolBlock[b];
+		if (block.state != blockObject || block.used == 0)
+			continue;
+		if (block.dim > 1 && (refresh + b) % block.dim != 0)
+			continue;
+		if (run != NULL && run + runPoints == _pool + block.start)
+			runPoints += block.used;
+		else {
+			chainAdd(run, runPoints);
+			run = _pool + block.start;
+			runPoints = block.used;
+		}
+	}
+	chainAdd(run, runPoints);
+}
 
-	//This is how we START a transfer! (This will acttually start the DMA transfer
-	DACC->DACC_PTCR = DACC_PTCR_TXTEN;//(DACC_PTCR) = Receiver Transfer Enable Register  
+void XYscope::chainAddList(const pointList *list, int listSize, int points) {
+	//	Append a list of 'points' points to the DMA chain.  The first listSize points are at 'list',
+	//	the rest continue into the chunks.
+	//
+	//	20261017 Ver 0.0				First cut
 
-	//Now that DMA transfer is underway, we must UNBLANK the Z-Axis by setting the Blanking Pin LOW.
+	chainAdd(list, points < listSize ? points : listSize);
+	points -= listSize;
+	for (int c = 0; c < _chunkCount && points > 0; c++) {
+		chainAdd(_chunk[c].list, points < _chunk[c].points ? points : _chunk[c].points);
+		points -= _chunk[c].points;
+	}
+}
 
-	//The following repeated digitalWrites are used as fixed delays to properly time the
-	//state change of the crtBlanking signal which is used by the hardware interface &
-	//to properly unblank the output once actual data is starting to appear at DAC1/DAC2
+void XYscope::chainAddRange(const pointList *list, int listSize, int from, int to) {
+	//	Append points from..to-1 of a list to the DMA chain.  The first listSize points are at 'list',
+	//	the rest continue into the chunks.
+	//
+	//	20261017 Ver 0.0				First cut
 
-	digitalWrite(crtBlankingPin, HIGH);	//Stay blanked...
+	if (from < listSize) {
+		chainAdd(list + from, (to < listSize ? to : listSize) - from);
+		from = listSize;
+	}
+	int base = listSize;
+	for (int c = 0; c < _chunkCount && from < to; c++) {
+		int end = base + _chunk[c].points;
+		if (from < end) {
+			chainAdd(_chunk[c].list + (from - base), (to < end ? to : end) - from);
+			from = end;
+		}
+		base = end;
+	}
+}
 
-	for (int i = frontPorchBlankCount; i > 0; i--) {
-		__asm__ __volatile__("nop");
-		//loop to generate a short (~60ns per count), programmable delays
+void XYscope::chainAddSegments(const pointList *list, int listSize, int points) {
+	//	chainAddList(), except that repeated segments (see segmentSetRepeat) are added again right after
+	//	themselves.  A segment takes at most 2 blocks per copy (it may run from the list into a chunk);
+	//	segmentSetRepeat() keeps the total within MaxRepeatBlocks, so the chain has room for all of them.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	int from = 0;
+	int budget = MaxRepeatBlocks;
+	for (int s = 0; s < _segmentCount; s++) {
+		const segmentEntry &seg = _segment[s];
+		int end = seg.start + seg.capacity;
+		if (seg.repeat <= 1 || end > points || 2 * seg.repeat > budget)
+			continue;
+		budget -= 2 * seg.repeat;
+		chainAddRange(list, listSize, from, end);
+		for (int r = 1; r < seg.repeat; r++)
+			chainAddRange(list, listSize, seg.start, end);
+		from = end;
 	}
+	chainAddRange(list, listSize, from, points);
+}
 
-	if (millis() > _crtOffTOD_ms && _screenOnTime_ms != 0) {
-		digitalWrite(crtBlankingPin, HIGH);	//Keep BLANKED if ScreenSave Time Not yet Exceeded
-	} else
-		digitalWrite(crtBlankingPin, LOW);	//Unblank and resume display
+XYscope::pointList &XYscope::chunkPoint(int ix) {
+	//	listPoint() for indexes beyond the end of _plotList: find the chunk holding point ix.
+	//	Callers stay below _plotLimit, so ix is always inside one of the chunks.
+	//
+	//	20261017 Ver 0.0				First cut
 
-	dacc_enable_interrupt(DACC, DACC_IER_ENDTX); //Enable interrupt when dac runs out of data...
+	ix -= _plotListSize;
+	int c = 0;
+	while (c < _chunkCount - 1 && ix >= _chunk[c].points) {
+		ix -= _chunk[c].points;
+		c++;
+	}
+	return const_cast<pointList *>(_chunk[c].list)[ix];
 }
 
-void paintCrt_isrsss() {	//TODO REMOVE THIS ROUTINE!
-	//	paintCrtISR Interrupt Service Routine
-	//
-	//	This routine will initiate a DMA transfer of the current XYlist of points to DAC0 (X) & DAC1 (Y)
-	//	causing the points to "paint" onto the CRT screen.
-	//
-	//	Timer3 is used to trigger this routine every 'refreshPeriodMs'.  Usually refreshPeriodMs is a constant
-	//	(defined in XYscope.h) that is normally set to a value in the 16 to 32 range of values.  The XY points
-	//	will be repainted and with the help of POV (persistance of vision) appear continuously to the observer.
-	//	If refreshPeriodms is set too long, the screen image will flicker or be noticably blinking.
+void XYscope::setPlotLimit(void) {
+	//	plotPoint() stops adding points at _plotLimit: 3 points short of MaxBuffSize or of the room in
+	//	the list (XY_List/double buffer bank, plus the chunks in single buffer mode), whichever is less.
 	//
-	//	Calling parameters:
-	//				None.
+	//	20261017 Ver 0.0				First cut
+
+	int room = _plotListSize + (_doubleBuffer ? 0 : _chunkPoints);
+	_plotLimit = (MaxBuffSize < room ? MaxBuffSize : room) - 3;
+}
+
+void XYscope::chainStart(void) {
+	//	Start the DMA chain: first block into the PDC current registers, second into the next registers.
+	//	The PDC moves next->current by itself when the current count runs out; dacHandler() then
+	//	refills the next registers (see chainAdvance).
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Blocks come from chainNext() (chain, then display program)
+	//	20261017 Ver 0.2				PDC count per point follows the transfer mode (see setFullWordMode)
+
+	const pointList *list;
+	int points;
+	_dmaBlockNext = 0;
+	if (!chainNext(list, points)) {
+		xyHalDmaStart(_dmaList, 0);		//Nothing to paint; TXBUFE ends the "frame" right away
+		return;
+	}
+	xyHalDmaStart(list, points * _dmaUnitsPerPoint);	//Count is in Short-Integers (two per XY point), or words in full-word mode
+	if (chainNext(list, points))
+		xyHalDmaQueueNext(list, points * _dmaUnitsPerPoint);
+}
+
+bool XYscope::chainAdvance(uint32_t status) {
+	//	Called from dacHandler().  While blocks are left, hand the next one to the PDC.
 	//
-	//	Returns:	Nothing.
+	//	Returns: true if a block was handed over (transfer still running), false when the chain is finished.
 	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Blocks come from chainNext() (chain, then display program)
+	//	20261017 Ver 0.2				PDC count per point follows the transfer mode (see setFullWordMode)
+
+	const pointList *list;
+	int points;
+	if (!chainNext(list, points))
+		return false;
+	if ((status & XYHAL_TXBUFE) == XYHAL_TXBUFE)
+		xyHalDmaStart(list, points * _dmaUnitsPerPoint);	//PDC ran dry before we got here; restart it
+	else
+		xyHalDmaQueueNext(list, points * _dmaUnitsPerPoint);	//Also clears ENDTX
+	if (!chainPending()) {		//Last block handed over; next interrupt is end of frame
+		xyHalDmaIrqDisable(XYHAL_ENDTX);
+		xyHalDmaIrqEnable(XYHAL_TXBUFE);
+	}
+	return true;
+}
+
+bool XYscope::chainNext(const pointList *&list, int &points) {
+	//	Get the next block for the PDC: the blocks built by initiateDacDma() first, then staging buffers
+	//	filled by the display program generator.  The two staging buffers are used in turn; the one being
+	//	filled is always the one the PDC has finished with (the PDC holds at most the current and next block).
 	//
-	//	20170418 Ver 0.0	E.Andrews	First cut.
+	//	Returns: true with list/points set, false when there is nothing more to send this refresh.
 	//
+	//	20261017 Ver 0.0				First cut
 
-	//digitalWrite(crtBlankingPin,HIGH);	//Go into blanking...
+	if (_dmaBlockNext < _dmaBlockCount) {
+		list = _dmaBlock[_dmaBlockNext].list;
+		points = _dmaBlock[_dmaBlockNext].points;
+		_dmaBlockNext = _dmaBlockNext + 1;
+		return true;
+	}
+	while (_streamSource != streamNone) {
+		pointList *buf = _stage + _stageNext * StagePoints;
+		points = streamFill(buf, StagePoints);
+		if (points > 0) {
+			_stageNext ^= 1;
+			list = buf;
+			return true;
+		}
+	}
+	return false;
+}
 
-	// *** END TEST SIGNAL **********	TODO You can DELETE this block when scope testing is no longer needed
-	const uint8_t Led13 = 13;//	*	Attach scope probe to pin 13 to monitor entry and exit into this routine
-	digitalWrite(Led13, HIGH);	//	*   Entering ISR, Set LED13=HIGH
-	// *** END TEST SIGNAL **********
+bool XYscope::chainPending(void) {
+	//	true while chainNext() still has blocks to give out this refresh.
+	//
+	//	20261017 Ver 0.0				First cut
 
-	//initiateDacDma();	//Start the DMA transfer to paint the CRT screen
+	return _dmaBlockNext < _dmaBlockCount || _streamSource != streamNone;
+}
 
-	// *** END TEST SIGNAL **********	TODO You can DELETE this block when scope testing is no longer needed
-	digitalWrite(Led13, LOW);	//	*	Leaving ISR, Set LED13=LOW
-	// *** END TEST SIGNAL **********
+void XYscope::streamReset(void) {
+	//	Rewind the staging buffer sources.  Called by initiateDacDma() at the start of every refresh.
+	//
+	//	20261017 Ver 0.0				First cut
 
+	_streamSource = streamNone;
+	streamNext();
 }
 
-void XYscope::disableDac(void) {
-	dacc_disable_interrupt(DACC, DACC_IER_ENDTX);
+void XYscope::streamNext(void) {
+	//	Move on from the current staging buffer source to the next one that has points to paint.
+	//	Order: display program, packed list, interlaced list field.
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Interlaced list field
+	//	20261017 Ver 0.2				Field count latched by initiateDacDma
+
+	if (_streamSource < streamProgram && _program != NULL) {
+		programReset();
+		_streamSource = streamProgram;
+	} else if (_streamSource < streamPacked && _packStore != NULL && _packBytes > 0) {
+		_unpPos = 0;
+		_unpEnd = _packBytes;		//Points plotted from here on are painted next refresh
+		_unpRun = 0;
+		_unpX = _unpY = _unpVx = _unpVy = 0;
+		_streamSource = streamPacked;
+	} else if (_streamSource < streamField && _fldCount > 1) {
+		_fldList = _dmaList;
+		_fldListSize = _doubleBuffer ? _dmaListEnd : _plotListSize;
+		_fldEnd = _doubleBuffer ? _dmaListEnd : XYlistEnd;	//Points plotted from here on are painted next refresh
+		_fldPos = _field < _fldCount ? _field : 0;
+		_field = _fldPos + 1 < _fldCount ? _fldPos + 1 : 0;
+		_streamSource = streamField;
+	} else
+		_streamSource = streamNone;
 }
 
-void XYscope::setScreenSaveSecs(long ScreenOnTime_sec) {
-	//	Routine to set/change the screen-save period.
-	//
-	//	Calling parameters:
-	//
-	//	ScreenOnTime_sec	The time that the display will remain active after the last plotPoint call.
-	//						This screen timer begins after the LAST plotPoint command is executed;
-	//						Display will blank when timer expires.
-	//
-	//						ScreenOnTime_Sec = 0 means that the screen saver function is OFF.
-	//
-	//	Returns:	Nothing.
+int XYscope::streamFill(pointList *buf, int maxPoints) {
+	//	Fill a staging buffer from the current source.  A source that returns fewer points than asked for
+	//	has finished; the rest of the buffer is then filled from the next source.
 	//
-	//	20170705 Ver 0.0	E.Andrews	First cut
+	//	Returns: Points written (_streamSource = streamNone once all sources have finished)
 	//
-	_screenOnTime_ms = ScreenOnTime_sec * 1000;
-	if (_screenOnTime_ms != 0)
-		_crtOffTOD_ms = millis() + _screenOnTime_ms;
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Interlaced list field
+
+	int n = 0;
+	while (n < maxPoints && _streamSource != streamNone) {
+		if (_streamSource == streamProgram)
+			n += programFill(buf + n, maxPoints - n);
+		else if (_streamSource == streamPacked)
+			n += packedFill(buf + n, maxPoints - n);
+		else
+			n += fieldFill(buf + n, maxPoints - n);
+		if (n < maxPoints)
+			streamNext();
+	}
+	return n;
 }
-long XYscope::getScreenSaveSecs(void) {
-	//	Routine to get the screen-save period.
-	//
-	//	Calling parameters:
-	//
-	//	ScreenOnTime_sec	The time that the display will remain active when there is no plotPoint activity.
-	//						This screen timer begins after the LAST plotPoint command is executed.
-	//						ScreenOnTime_Sec = 0 means that the screen saver function is OFF
-	//						and the screen continuously on.
-	//
-	//	Returns:	ScreenOnTime_sec
-	//
-	//	20170705 Ver 0.0	E.Andrews	First cut
+
+void XYscope::programReset(void) {
+	//	Rewind the display program generator.  Called by streamReset() at the start of every refresh.
 	//
-	return _screenOnTime_ms / 1000;
+	//	20261017 Ver 0.0				First cut
+
+	_genPc = 0;
+	_genSp = 0;
+	_genOx = _genOy = 0;
+	_genDensity = _graphDensity;
+	_genOps = 0;
+	_genCount = 0;
+	_genFramePoints = 0;
 }
 
-void XYscope::setRefreshPeriodUs(uint32_t refresh_us) {
-	//	Routine to set/change the refresh timer.  User can call any time to change the refresh period.
-	//
-	//	Calling parameters:
-	//
-	//	refresh_us	Refresh period in microseconds (us). Value is nominally 15000 < refresh_us < 33000.
-	//
-	//	CAUTIONS:
-	//	1) 	For short persistance phosphors, refresh_us may need to <25000 (25 ms)
-	//	   	to prevent display flicker.
-	//	2)	If refresh time is set too short, the whole display list may not be visualized.
-	//
-	//	Returns:	Nothing.
+int XYscope::programFill(pointList *buf, int maxPoints) {
+	//	Expand the display program into buf, picking up exactly where the last call stopped (even in the
+	//	middle of a figure).  Runs inside the DACC ISR, so the per point work is a few adds and shifts.
 	//
-	//	20170705 Ver 0.0	E.Andrews	First cut
+	//	Returns: Points written.  Less than maxPoints only when the program has finished.
 	//
-	ActiveRefreshPeriod_us = refresh_us;//Store the value as the ActiveRefreshPeriod
-	Timer3.start(refresh_us);			//Set the refresh timer
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Skip points of conic arc segments that are masked off
+
+	int n = 0;
+	while (n < maxPoints) {
+		if (_genCount <= 0) {
+			if (!programStep()) {
+				_genLastPoints = _genFramePoints + n;
+				break;
+			}
+			continue;
+		}
+		int x, y;
+		if (_genKind == genLine) {
+			x = _genX >> 16;
+			y = _genY >> 16;
+			_genX += _genDx;
+			_genY += _genDy;
+		} else {
+			x = _genXc + ((_genXr * _genU) >> 14);
+			y = _genYc + ((_genYr * _genV) >> 14);
+			_genU += (_genE * _genV) >> 14;		//Minsky circle: uses the NEW U, so the figure closes without drifting
+			_genV -= (_genE * _genU) >> 14;
+			int seg = _genAng / 12868;			//pi/4 (2.14)
+			_genAng += _genE;
+			if ((_genArcs & (1 << (seg < 7 ? seg : 7))) == 0) {
+				_genCount--;					//Masked off: keep turning, paint nothing
+				continue;
+			}
+		}
+		buf[n].X = (x & 0xfff) | X_flag;
+		buf[n].Y = (y & 0xfff) | Y_flag;
+		n++;
+		_genCount--;
+	}
+	_genFramePoints += n;
+	return n;
 }
-long XYscope::getRefreshPeriodUs(void) {
-	//	Routine to Get the refresh timer.  User can call any time to change the refresh period.
-	//
-	//	Calling parameters:
-	//
-	//	refresh_us	Refresh period in microseconds (us). Value is nominally 15000 < refresh_us < 33000.
-	//
-	//	CAUTIONS:
-	//	1) 	For short persistance phoshors, refresh_us may need to <25000 (25 ms)
-	//	   	to prevent display flicker.
-	//	2)	If refresh time is set too short, the whole display list may not be visualized.
-	//
-	//	Returns:	Currently active refresh period (in microseconds)
-	//
-	//	20170705 Ver 0.0	E.Andrews	First cut
-	//
 
-	return ActiveRefreshPeriod_us;
+bool XYscope::programStep(void) {
+	//	Decode the opcode at _genPc.  Figure opcodes set up _genCount points for programFill() to expand.
+	//
+	//	Returns: false when the program has finished for this refresh (XYP_HALT or an error), else true.
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Arc segment mask operand on circles and ellipses; conics start at
+	//									(xc - xr, yc) and turn the same way as plotEllipse
+
+	if (++_genOps > MaxProgramOps)
+		return false;
+	const uint16_t *op = _program + _genPc;
+	switch (op[0]) {
+	case progLine:
+	case progPoint: {
+		bool line = (op[0] == progLine);
+		int x0 = _genOx + (int16_t) op[1], y0 = _genOy + (int16_t) op[2];
+		int x1 = line ? _genOx + (int16_t) op[3] : x0;
+		int y1 = line ? _genOy + (int16_t) op[4] : y0;
+		int steps = abs(x1 - x0) > abs(y1 - y0) ? abs(x1 - x0) : abs(y1 - y0);
+		int intervals = steps / (_genDensity + 1) + (steps % (_genDensity + 1) != 0 ? 1 : 0);	//One point every density+1 steps, plus the end point
+		_genKind = genLine;
+		_genX = x0 * 65536 + 0x8000;		//+1/2 so the >>16 rounds
+		_genY = y0 * 65536 + 0x8000;
+		_genDx = intervals ? (x1 - x0) * 65536 / intervals : 0;
+		_genDy = intervals ? (y1 - y0) * 65536 / intervals : 0;
+		_genCount = intervals + 1;
+		_genPc += line ? 5 : 3;
+		return true;
+	}
+	case progCircle:
+	case progEllipse: {
+		bool circle = (op[0] == progCircle);
+		_genXc = _genOx + (int16_t) op[1];
+		_genYc = _genOy + (int16_t) op[2];
+		_genXr = (int16_t) op[3];
+		_genYr = circle ? _genXr : (int16_t) op[4];
+		int r = abs(_genXr) > abs(_genYr) ? abs(_genXr) : abs(_genYr);
+		_genE = r > 0 ? ((_genDensity + 1) << 14) / r : 4096;	//Angle step = dot spacing / radius (radians, 2.14)
+		if (_genE > 4096)			//At least 25 points per figure
+			_genE = 4096;
+		if (_genE < 4)
+			_genE = 4;
+		_genKind = genConic;
+		_genU = -(1 << 14);
+		_genV = 0;
+		_genAng = 0;
+		_genArcs = circle ? op[4] : op[5];
+		_genCount = 102944 / _genE + 1;			//2*pi (2.14) / step, plus one to close the figure
+		_genPc += circle ? 5 : 6;
+		return true;
+	}
+	case progOrigin:
+		_genOx = (int16_t) op[1];
+		_genOy = (int16_t) op[2];
+		_genPc += 3;
+		return true;
+	case progDensity:
+		_genDensity = op[1] > 100 ? 100 : op[1];
+		_genPc += 2;
+		return true;
+	case progJump:
+		_genPc = op[1];
+		return true;
+	case progCall:
+		if (_genSp >= ProgramStackDepth)
+			return false;
+		_genStack[_genSp] = _genPc + 2;
+		_genStackOx[_genSp] = _genOx;
+		_genStackOy[_genSp] = _genOy;
+		_genSp++;
+		_genPc = op[1];
+		return true;
+	case progRet:
+		if (_genSp == 0)
+			return false;
+		_genSp--;
+		_genPc = _genStack[_genSp];
+		_genOx = _genStackOx[_genSp];
+		_genOy = _genStackOy[_genSp];
+		return true;
+	default:			//progHalt or unknown opcode
+		return false;
+	}
 }
 
-void XYscope::autoSetRefreshTime(void) {
-	//	This routine automatically adjusts the crt refresh period.  Time will be
-	//	set based to CrtMinRefresh_ms OR TimeReqdToPlotAllPoints_us, whichever
-	//  is larger. User should call this function.
+void XYscope::packReset(void) {
+	//	Empty the packed store and rewind the encoder.
 	//
-	//	Call this routine AFTER every major write the XYlist to be sure all points are
-	//	visualized.
+	//	20261017 Ver 0.0				First cut
+
+	_packBytes = 0;
+	_packPoints = 0;
+	_packRunIx = -1;
+	_packX = _packY = _packVx = _packVy = 0;
+}
+
+void XYscope::packPoint(int x0, int y0) {
+	//	Encode one point into the packed store.  Records (the decoder starts at 0,0 with a step of 0,0):
+	//
+	//		00xxxyyy					Step changes by (xxx-4, yyy-4); next point = last point + step
+	//		01nnnnnn					Next nnnnnn+1 points: same step (straight lines)
+	//		10xxxxxx xyyyyyyy			Step = (x, y), 7 bit signed each
+	//		1100xxxx xxxxxxxx yyyyyyyy yyyyyyyy	Absolute point (12 bits each); step = 0,0
+	//
+	//	Points along lines and curves change their step by -1..1 from point to point, so most of them take
+	//	one byte or less.  Points that do not fit in the store are dropped (plotErr = 1, _listFull).
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Record dropped points in _listFull
+
+	x0 &= 0xfff;
+	y0 &= 0xfff;
+	int dx = x0 - _packX, dy = y0 - _packY;
+	int ddx = dx - _packVx, ddy = dy - _packVy;
+	int ix = _packBytes;
+	if (ddx == 0 && ddy == 0 && _packRunIx >= 0 && (_packStore[_packRunIx] & 0x3f) < 0x3f) {
+		_packStore[_packRunIx]++;			//One more point on the current run
+	} else if (ddx == 0 && ddy == 0) {
+		if (ix + 1 > _packCapacity) {
+			plotErr = 1;
+			_listFull = true;
+			return;
+		}
+		_packRunIx = ix;
+		_packStore[ix++] = 0x40;
+	} else if (ddx >= -4 && ddx <= 3 && ddy >= -4 && ddy <= 3) {
+		if (ix + 1 > _packCapacity) {
+			plotErr = 1;
+			_listFull = true;
+			return;
+		}
+		_packRunIx = -1;
+		_packStore[ix++] = ((ddx + 4) << 3) | (ddy + 4);
+	} else if (dx >= -64 && dx <= 63 && dy >= -64 && dy <= 63) {
+		if (ix + 2 > _packCapacity) {
+			plotErr = 1;
+			_listFull = true;
+			return;
+		}
+		_packRunIx = -1;
+		_packStore[ix++] = 0x80 | ((dx >> 1) & 0x3f);
+		_packStore[ix++] = ((dx & 1) << 7) | (dy & 0x7f);
+	} else {
+		if (ix + 4 > _packCapacity) {
+			plotErr = 1;
+			_listFull = true;
+			return;
+		}
+		_packRunIx = -1;
+		_packStore[ix++] = 0xc0 | (x0 >> 8);
+		_packStore[ix++] = x0 & 0xff;
+		_packStore[ix++] = y0 >> 8;
+		_packStore[ix++] = y0 & 0xff;
+		dx = dy = 0;
+	}
+	_packX = x0;
+	_packY = y0;
+	_packVx = dx;
+	_packVy = dy;
+	_packPoints++;
+	_packBytes = ix;		//Record is complete; the ISR may now read it
+}
+
+int XYscope::packedFill(pointList *buf, int maxPoints) {
+	//	Decode the packed store into buf (see packPoint for the record format), picking up where the last
+	//	call stopped, even in the middle of a run.  Runs inside the DACC ISR.
+	//
+	//	Returns: Points written.  Less than maxPoints only when the store has been fully decoded.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	int n = 0;
+	while (n < maxPoints) {
+		if (_unpRun > 0)
+			_unpRun--;
+		else {
+			if (_unpPos >= _unpEnd)
+				break;
+			uint8_t b = _packStore[_unpPos++];
+			switch (b >> 6) {
+			case 0:
+				_unpVx += ((b >> 3) & 7) - 4;
+				_unpVy += (b & 7) - 4;
+				break;
+			case 1:
+				_unpRun = b & 0x3f;		//This point plus nnnnnn more
+				break;
+			case 2: {
+				uint8_t b1 = _packStore[_unpPos++];
+				int dx = ((b & 0x3f) << 1) | (b1 >> 7);
+				int dy = b1 & 0x7f;
+				_unpVx = dx >= 64 ? dx - 128 : dx;
+				_unpVy = dy >= 64 ? dy - 128 : dy;
+				break;
+			}
+			default:
+				_unpX = ((b & 0x0f) << 8) | _packStore[_unpPos];
+				_unpY = (_packStore[_unpPos + 1] << 8) | _packStore[_unpPos + 2];
+				_unpPos += 3;
+				_unpVx = _unpVy = 0;
+				break;
+			}
+		}
+		_unpX += _unpVx;
+		_unpY += _unpVy;
+		buf[n].X = (_unpX & 0xfff) | X_flag;
+		buf[n].Y = (_unpY & 0xfff) | Y_flag;
+		n++;
+	}
+	return n;
+}
+
+int XYscope::fieldFill(pointList *buf, int maxPoints) {
+	//	Copy every _fldCount'th point of the list into buf, picking up where the last call stopped.
+	//	Runs inside the DACC ISR.
 	//
-	//	Calling parameters: NONE
+	//	Returns: Points written.  Less than maxPoints only when the field has been fully copied.
 	//
-	//	Returns:	NOTHING.
-	//  Other Notes:  Use GetRefreshPeriodUs() routine to retrieve the active value.
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				Stride is the field count latched for this refresh
+
+	int n = 0;
+	int stride = _fldCount;
+	int end = _fldEnd < _fldListSize ? _fldEnd : _fldListSize;
+	while (n < maxPoints && _fldPos < end) {		//Points in the list itself
+		buf[n++] = _fldList[_fldPos];
+		_fldPos += stride;
+	}
+	while (n < maxPoints && _fldPos < _fldEnd) {	//Points that continue into the chunks
+		buf[n++] = chunkPoint(_fldPos);
+		_fldPos += stride;
+	}
+	return n;
+}
+
+int XYscope::streamTake(const pointList *&list) {
+	//	Next block for the PDC while streaming: up to StreamBlockPoints queued points (never across the end of
+	//	the ring), or the blanked filler when the ring is empty.
 	//
-	//	201707017 Ver 0.0	E.Andrews	First cut
+	//	Returns: Points of ring data in the block; 0 = filler (StreamFillerPoints points at _stage)
 	//
+	//	20261017 Ver 0.0				First cut
 
-	uint32_t crtRefreshTime_us, TimeReqdToPlotAllPoints_us;
+	int head = _ringHead;
+	xyHalMemoryBarrier();
+	if (head == _ringSend) {
+		if (_ringInFlight[1] != 0 || _ringInFlight[0] != 0) {	//Data just ran out
+			_ringUnderruns = _ringUnderruns + 1;
+			for (int i = 0; i < StreamFillerPoints; i++)
+				_stage[i] = _ringLast;
+			void (*streamCallback)(uint8_t, int) = _streamCallback;
+			if (streamCallback != NULL)
+				streamCallback(streamUnderrun, 0);
+		}
+		list = _stage;
+		return 0;
+	}
+	int points = (head > _ringSend ? head : _ringSize) - _ringSend;
+	if (points > StreamBlockPoints)
+		points = StreamBlockPoints;
+	list = _ringList + _ringSend;
+	_ringSend += points;
+	_ringLast = _ringList[_ringSend - 1];
+	if (_ringSend >= _ringSize)
+		_ringSend = 0;
+	return points;
+}
 
-	// Calculate the display time needed based on number of points in XYlist
-	// Add a "20 Point Buffer" into the calculation to ensure float to integer round off errors
-	// do not result in over-run conditions.
-	TimeReqdToPlotAllPoints_us = int(DmaClkPeriod_us * 2 * (XYlistEnd + 20));
+void XYscope::streamAdvance(uint32_t status) {
+	//	Called from dacHandler() while streaming, when the PDC has finished a block (ENDTX).  Frees the ring
+	//	space of the finished block, hands the PDC its next block and blanks/unblanks the beam for the block
+	//	that is now being sent.
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261017 Ver 0.1				PDC count per point follows the transfer mode (see setFullWordMode)
+	//	20261017 Ver 0.2				Blanking pin driven through the blank timer (xyHalBlankNow)
+
+	const pointList *list;
+	bool dry = (status & XYHAL_TXBUFE) == XYHAL_TXBUFE;	//ISR was late: the next block has finished too
+	for (int done = dry ? 2 : 1; done > 0; done--) {
+		int tail = _ringTail + _ringInFlight[0];
+		_ringTail = tail >= _ringSize ? tail - _ringSize : tail;
+		_ringInFlight[0] = _ringInFlight[1];
+		_ringInFlight[1] = 0;
+	}
+	if (dry) {
+		_ringInFlight[0] = streamTake(list);
+		xyHalDmaStart(list, (_ringInFlight[0] ? _ringInFlight[0] : StreamFillerPoints) * _dmaUnitsPerPoint);
+	}
+	_ringInFlight[1] = streamTake(list);
+	xyHalDmaQueueNext(list, (_ringInFlight[1] ? _ringInFlight[1] : StreamFillerPoints) * _dmaUnitsPerPoint);	//Also clears ENDTX
 
-	//  Compare calculated TimeReqd.. to MinRefresh value as as spec'd in header file.
-	//  Pick which ever time is slowest....
-	if (TimeReqdToPlotAllPoints_us > CrtMinRefresh_ms * 1000) {
-		crtRefreshTime_us = TimeReqdToPlotAllPoints_us;	//Set Refresh time = to miniumn defined refreshtime or that required to get all the points to the screen...
-	} else {
-		crtRefreshTime_us = CrtMinRefresh_ms * 1000;//Min Refresh Time in microseconds...
+	bool blank = (_ringInFlight[0] == 0);
+	if (blank != _ringBlanked) {
+		_ringBlanked = blank;
+		xyHalBlankNow(blank);
 	}
 
-	//	Now see if we need to actually change the refresh timer...
-	//  Only Update REFRESH timer period (microseconds) when new time <> currently active timer
-	if (ActiveRefreshPeriod_us != crtRefreshTime_us) {
-		Timer3.start(crtRefreshTime_us);			//Upadate Timer Period
-		ActiveRefreshPeriod_us = crtRefreshTime_us;	//Store new value "ActiveRefreshPeriod_us"
+	int level = getStreamLevel();
+	if (level < _ringHighMark)
+		_ringHighArmed = true;
+	void (*streamCallback)(uint8_t, int) = _streamCallback;
+	if (level <= _ringLowMark && _ringLowArmed) {
+		_ringLowArmed = false;
+		if (streamCallback != NULL)
+			streamCallback(streamLowWater, level);
 	}
+}
+
+bool XYscope::cmdQueue(uint8_t op, int p0, int p1, int p2, int p3, uint8_t arcSegment) {
+	//	Queue a plot call when deferred plotting is ON (see setCommandQueue).  A full queue is flushed first.
+	//
+	//	Returns: true = queued, false = caller must rasterize now
+	//
+	//	20261017 Ver 0.0				First cut
 
+	if (_cmdQueue == NULL || _cmdSuspend != 0)
+		return false;
+	if (_cmdCount >= _cmdSize && _cmdDone > 0) {	//Reuse the room of commands renderStep() has finished
+		_cmdCount -= _cmdDone;
+		memmove(_cmdQueue, _cmdQueue + _cmdDone, _cmdCount * sizeof(plotCommand));
+		_cmdDone = 0;
+	}
+	if (_cmdCount >= _cmdSize)
+		flush();
+	plotCommand &c = _cmdQueue[_cmdCount++];
+	c.op = op;
+	c.p[0] = p0;
+	c.p[1] = p1;
+	c.p[2] = p2;
+	c.p[3] = p3;
+	c.arcSegment = arcSegment;
+	c.density = _graphDensity > 255 ? 255 : _graphDensity;
+	return true;
 }
 
-/****************************************************************************/
-/* Private Functions */
-/****************************************************************************/
+bool XYscope::cmdRenderNext(void) {
+	//	Rasterize the next queued command (the one nearest to the beam with cmdReorder), unless cmdCull
+	//	finds it entirely off screen.  Caller holds _cmdSuspend.
+	//
+	//	Returns: false when the queue is empty
+	//
+	//	20261017 Ver 0.0				First cut
+	//	20261018 Ver 0.1				Reorder by the point each figure really starts at
 
-uint32_t XYscope::FreqToTimerTicks(uint32_t freqHz) {
-	return VARIANT_MCK / 2UL / freqHz;//Converts frequency(Hz) into Timer Count values for TC programming
+	if (_cmdDone >= _cmdCount) {
+		_cmdDone = _cmdCount = 0;
+		return false;
+	}
+	plotCommand *q = _cmdQueue;
+	if ((_cmdOptions & cmdReorder) != 0) {
+		//Greedy nearest neighbour from the last point plotted, to the first point each figure plots:
+		//plotCircle(xc, yc, r) starts at the top (xc, yc+r), the arc routines (circle and ellipse) at the
+		//left hand side (xc-xr, yc).  Lines may be drawn in either direction.
+		int bx = 0, by = 0;
+		if (_packStore != NULL) {
+			bx = _packX;
+			by = _packY;
+		} else if (XYlistEnd > 0) {
+			bx = listPoint(XYlistEnd - 1).X & 0xfff;
+			by = listPoint(XYlistEnd - 1).Y & 0xfff;
+		}
+		int best = _cmdDone, bestDist = 0x7fffffff;
+		bool bestFlip = false;
+		for (int j = _cmdDone; j < _cmdCount; j++) {
+			const short *p = q[j].p;
+			bool line = (q[j].op == cmdLine);
+			int sx = p[0], sy = p[1];
+			if (q[j].op == cmdCircle)
+				sy += p[2];
+			else if (!line)
+				sx -= p[2];
+			int d = abs(sx - bx) + abs(sy - by);
+			if (d < bestDist) {
+				best = j;
+				bestDist = d;
+				bestFlip = false;
+			}
+			if (line) {
+				d = abs(p[2] - bx) + abs(p[3] - by);
+				if (d < bestDist) {
+					best = j;
+					bestDist = d;
+					bestFlip = true;
+				}
+			}
+		}
+		plotCommand c = q[best];
+		q[best] = q[_cmdDone];
+		if (bestFlip) {
+			short t = c.p[0];
+			c.p[0] = c.p[2];
+			c.p[2] = t;
+			t = c.p[1];
+			c.p[1] = c.p[3];
+			c.p[3] = t;
+		}
+		q[_cmdDone] = c;
+	}
+	const plotCommand &c = q[_cmdDone++];
+	if ((_cmdOptions & cmdCull) != 0) {
+		int x0, y0, x1, y1;
+		cmdBounds(c, x0, y0, x1, y1);
+		if (x1 < 0 || y1 < 0 || x0 > 4095 || y0 > 4095)
+			return true;		//Entirely off screen
+	}
+	int savedDensity = _graphDensity;
+	_graphDensity = c.density;
+	switch (c.op) {
+	case cmdLine:
+		plotLine(c.p[0], c.p[1], c.p[2], c.p[3]);
+		break;
+	case cmdCircle:
+		plotCircle(c.p[0], c.p[1], c.p[2]);
+		break;
+	case cmdCircleArc:
+		plotCircle(c.p[0], c.p[1], c.p[2], c.arcSegment);
+		break;
+	case cmdEllipseArc:
+		plotEllipse(c.p[0], c.p[1], c.p[2], c.p[3], c.arcSegment);
+		break;
+	}
+	_graphDensity = savedDensity;
+	return true;
+}
+
+void XYscope::cmdBounds(const plotCommand &cmd, int &x0, int &y0, int &x1, int &y1) {
+	//	Bounding box of a queued command.
+	//
+	//	20261017 Ver 0.0				First cut
+
+	const short *p = cmd.p;
+	if (cmd.op == cmdLine) {
+		x0 = p[0] < p[2] ? p[0] : p[2];
+		x1 = p[0] < p[2] ? p[2] : p[0];
+		y0 = p[1] < p[3] ? p[1] : p[3];
+		y1 = p[1] < p[3] ? p[3] : p[1];
+	} else {
+		int xr = abs(p[2]);
+		int yr = (cmd.op == cmdEllipseArc) ? abs(p[3]) : xr;
+		x0 = p[0] - xr;
+		x1 = p[0] + xr;
+		y0 = p[1] - yr;
+		y1 = p[1] + yr;
+	}
 }
 
 void XYscope::begin(uint32_t dmaFreqHz) {
@@ -2407,18 +5363,24 @@ void XYscope::begin(uint32_t dmaFreqHz) {
 	//				hardware but do allow more points to be plotted before refresh
 	//				flicker is a apparent.
 	//
+	//				begin() takes over these DUE resources; the sketch must leave them alone:
+	//					DACC and its PDC channel, TC0 channel 0 (DAC clock, DueTimer's Timer0),
+	//					Timer3 (refresh; the sketch only attaches paintCrt_ISR to it),
+	//					Timer7 = TC2 channel 1 and pin 3 (crtBlankingPin): the blank timer drives pin 3
+	//					as TIOA7, so Timer7 cannot be used and pin 3 cannot be written with digitalWrite.
+	//
 	//	Returns:	Nothing.
 	//
 	//	20170405 Ver 0.0	E.Andrews	First cut
 	//	20170828 Ver 1.0	E.Andrews	Remove diag "print" statements and code/comment clean up
+	//	20261017 Ver 1.1				Blanking pin is set up as the blank timer output (xyHalBlankSetup)
 	//
 
 	float temp = getLibRev();	//Call revision routine to properly set the (global variables in case someone uses them)
 	temp=temp;
 
-	// Initialize the pin mode for BLANKING PIN and set default start up value=HIGH
-	pinMode(crtBlankingPin, OUTPUT);
-	digitalWrite(crtBlankingPin, HIGH);	//At the start, set CRT output to BLANKED
+	// Hand the BLANKING PIN to the blank timer; at the start, set CRT output to BLANKED
+	xyHalBlankSetup();
 
 	//Reset global PlotErr flag.  This flag is set inside the POINT PLOT routine
 	//whenever we run out of room in the XY_List array (ie: XYlistEnd > MaxBuffSize).
@@ -2440,7 +5402,7 @@ void XYscope::begin(uint32_t dmaFreqHz) {
 	tcSetup(dmaFreqHz);	//DO NOT DELETE - This 'redundant' call is needed to get the TC started!
 
 	// Perform Refresh Timer (Timer #3) Setup
-	Timer3.start(CrtMinRefresh_ms * 1000);
+	xyHalRefreshTimerStart(CrtMinRefresh_ms * 1000);
 
 	// Perform DAC setup
 	dacSetup();
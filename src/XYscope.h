@@ -2,15 +2,19 @@
 #ifndef XYs		//Include-Guard to prevent multiple includes...
 #define XYs
 
-#if (ARDUINO >=100)
-	#include "Arduino.h"
+#if defined(ARDUINO)
+	#if (ARDUINO >=100)
+		#include "Arduino.h"
+	#else
+		#include "WProgram.h"
+	#endif
+
+	//Make sure we are compiling for an Arduino DUE processor
+	#if not(__SAM3X8E__)
+		#error WRONG PROCESSOR SELECTED - XYscope Library is only usable with Arduino DUE Processor
+	#endif
 #else
-	#include "WProgram.h"
-#endif
-
-//Make sure we are compiling for an Arduino DUE processor
-#if not(__SAM3X8E__)
-	#error WRONG PROCESSOR SELECTED - XYscope Library is only usable with Arduino DUE Processor
+	#include "XYscopeHost.h"	//Host (Linux) build: Arduino core and DUE DAC/DMA/Timer hardware are emulated
 #endif
 
 
@@ -25,14 +29,16 @@
 
 class XYscope{
   public:
-	// Constructor
-	XYscope();
+	// Constructors
+	struct pointList;						//XY point (defined below)
+	XYscope();								//XY list uses the library's default buffer of MaxArraySize points
+	XYscope(pointList *list, uint32_t listSize);	//XY list uses a caller supplied buffer of listSize points (see also XYscopeSized<N>)
 	
 	//Methods
 
 	//Setup and Control Routines
 	float getLibRev(void);								//Retrieves the revision level of the active library
-	void begin(uint32_t dmaFreqHz=800000);				//Initializes and enables DAC, DAC Counter Timer, DMA controller, Refresh Counter Timer
+	void begin(uint32_t dmaFreqHz=800000);				//Initializes and enables DAC, DAC Counter Timer, DMA controller, Refresh Counter Timer, blank timer (Timer7 + pin 3)
 	void initiateDacDma(void);							//NOT A USER ROUTINE: Fires off a DacDMA transfer
 	void dacHandler(void);								//NOT A USER ROUTINE: This is link to DAC_TRANSFER_COMPLETED interrupt
 
@@ -42,19 +48,138 @@ class XYscope{
 	long getScreenSaveSecs(void);					//Retrieve current screen saver time. Zero=screen saver disabled.
 
 	void setDmaClockRate(uint32_t New_XfrRateHz);	//Allows user to change output Clk rate during run-time
+	void setFullWordMode(bool enable);				//true: PDC moves one 32 bit word (X+Y) per point instead of two half-words
+	bool getFullWordMode();							//Retrieve current DACC transfer mode (true=full-word)
 
 	void setRefreshPeriodUs(uint32_t refresh_us);	//Can be used to manually change the refresh period (us) during run-time.
 
 	void autoSetRefreshTime();						//Automatically sets the best refresh time based on the number points being plotted
 	long getRefreshPeriodUs(void);					//Retrieves the currently active refresh period (us).
+	void setEventRefresh(bool enable, uint32_t minFrame_us=CrtMinRefresh_ms*1000);	//true: each refresh starts when the last one has been painted, no sooner than minFrame_us
+	bool getEventRefresh();							//Retrieve refresh mode (true=event driven, false=fixed Timer3 period)
+	void setInterlace(uint8_t fields);				//Paint every 'fields'th point of the list per refresh (1=off, 2-MaxFields; 0=auto, see autoSetRefreshTime)
+	uint8_t getInterlace();							//Number of fields the list is currently split into (1=not interlaced)
+	static const uint8_t MaxFields=4;				//Most fields the list can be split into
 
 	//Buffer Management Routines
 	void plotStart();				//Reset current buffer pointer to zero, effectively erasing the existing XY_List array
 	void plotClear();				//Reset current buffer pointer to zero, effectively erasing the existing XY_List array and turning the display OFF
 	void plotEnd();					//Makes sure last points in XYlist are actually actually visualized
+	bool getListFull();				//true = points were dropped since plotStart() because the list (or packed store) was full
+
+	//Double Buffer Routines
+	void setDoubleBuffer(bool enable);	//Turn front/back buffer mode ON/OFF. When ON, XY_List is split into two banks of MaxArraySize/2 points
+	bool getDoubleBuffer();				//Retrieve current double buffer mode (true=ON)
+	void present();						//Queue the back buffer for display. Swap takes effect at the next DMA end-of-transfer
+
+	//Frame Pacing Routines
+	void setFrameCallback(void (*frameCallback)(uint32_t frameCount));	//Routine called (from the DACC ISR!) each time a frame has been painted. NULL=none
+	uint32_t getFrameCount();					//Number of frames painted since begin(). Rolls over after 2^32 frames.
+	uint32_t framesSince(uint32_t frameCount);	//Frames painted since getFrameCount() returned frameCount (roll over safe)
+	uint32_t waitForFrame(uint32_t frames=1);	//Wait until 'frames' more frames have been painted. Returns new frame count.
+
+	//Live List Edit Routines (see beginEdit() for the protocol)
+	void beginEdit();					//Open an edit window: waits for the DMA to go idle and holds off new refreshes
+	void commitEdit();					//Close the edit window: edits become visible at the next refresh
+	uint32_t getEditSequence();			//Edit sequence number. ODD while an edit window is open.
+	uint32_t getDeferredRefreshCount();	//Number of refreshes skipped because an edit window was open
+
+	//Segment Routines (re-render part of a list in place; see segmentOpen())
+	int segmentOpen(int capacity);		//Reserve 'capacity' points at the end of the list. Returns a segment handle (-1 = no room)
+	void segmentBegin(int handle);		//Start re-rendering a segment: following plot calls write into the segment
+	void segmentEnd();					//Finish re-rendering: pad unused slots and make the new content visible
+	int getSegmentPoints(int handle);	//Number of points currently drawn in a segment
+	bool segmentSetRepeat(int handle, uint8_t count);	//Paint a segment 'count' times per refresh (brighter), from the same points. false = no room in MaxRepeatBlocks
+	int getSegmentRepeat(int handle);	//Repeat count of a segment (-1 = bad handle)
+	static const uint8_t MaxSegments=16;	//Max number of segments per list
+	static const uint8_t MaxRepeatBlocks=16;	//DMA chain blocks available for segment repeats per refresh
+
+	//Object Pool Routines (objects kept in their own RAM, added/deleted/resized without touching other points; see setObjectPool())
+	void setObjectPool(pointList *pool, int points);	//Use 'pool' for objects; they are chained after the list every refresh. NULL = off
+	int objectNew(int capacity);		//Allocate room for 'capacity' points. Returns an object handle (-1 = no room)
+	void objectBegin(int handle);		//Start (re-)drawing an object: following plot calls write into the object
+	void objectEnd();					//Finish drawing: the new content becomes visible at the next refresh
+	void objectDelete(int handle);		//Remove an object and give its room back to the pool
+	bool objectResize(int handle, int capacity);	//Change capacity (points are kept). false = no room
+	int objectCompact();				//Move one object down to close a gap. Returns gaps left (0 = pool compact)
+	int getObjectPoints(int handle);	//Points drawn in an object (-1 = bad handle)
+	void objectSetDim(int handle, uint8_t divisor);	//Temporal dimming: paint the object on every 'divisor'th refresh only (1 = every refresh). Pool objects only
+	int getObjectDim(int handle);		//Temporal dimming divisor of an object (-1 = bad handle)
+	int getPoolFree();					//Largest object that objectNew() can allocate right now
+	static const uint8_t MaxObjects=16;	//Max number of objects in the pool
+
+	//Retained Scene Routines (objects are kept as nodes and only re-plotted when they change; see sceneAddLine())
+	int sceneAddLine(int x0, int y0, int x1, int y1, int capacity=0);		//Add a line node. Returns node handle (-1 = no room)
+	int sceneAddCircle(int xc, int yc, int r, int capacity=0);				//Add a circle node
+	int sceneAddEllipse(int xc, int yc, int xr, int yr, int capacity=0);	//Add an ellipse node
+	int sceneAddText(int textX, int textY, int textSize, const char *text, int capacity=0);	//Add a text node (text is copied, MaxSceneText chars max)
+	void sceneSetLine(int node, int x0, int y0, int x1, int y1);			//Change node; marks it dirty only if something changed
+	void sceneSetCircle(int node, int xc, int yc, int r);
+	void sceneSetEllipse(int node, int xc, int yc, int xr, int yr);
+	void sceneSetText(int node, const char *text);
+	void sceneSetTextXY(int node, int textX, int textY);
+	int sceneUpdate();					//Re-plot all dirty nodes in place. Returns number of nodes re-plotted.
+	static const uint8_t MaxSceneText=20;	//Max characters in a text node
+
+	//Layer Routines (static background + dynamic overlay, chained by the DMA; see setBackgroundLayer())
+	void setBackgroundLayer();			//Freeze the current list as the static background. plotStart() then starts an overlay list.
+	void clearBackgroundLayer();		//Drop the background (screen is cleared) and go back to a single list
+	int getBackgroundPoints();			//Number of points in the background (0 = no background)
+
+	//Static List Routines (const point arrays in FLASH, sent by the DMA without copying; see addStaticList())
+	int addStaticList(const pointList *list, int points);	//Paint list (after the dynamic list) every refresh. Returns handle (-1 = no room)
+	void removeStaticList(int handle);	//Stop painting a static list
+	static const uint8_t MaxStaticLists=6;	//Max number of static lists
+
+	//List Chunk Routines (let the list continue into extra, non-contiguous RAM; see addListChunk())
+	bool addListChunk(pointList *chunk, int points);	//Add RAM for 'points' more points. Returns false if chunk table is full.
+	void clearListChunks();				//Stop using all extra chunks (list is cut back to XY_List if needed)
+	static const uint8_t MaxListChunks=4;	//Max number of extra chunks
+
+	//Display Program Routines (figures generated by the DACC ISR while the DMA runs, not stored as points; see setDisplayProgram())
+	void setDisplayProgram(const uint16_t *program);	//Paint 'program' (XYP_... opcodes) after the lists every refresh. NULL = none
+	uint32_t getProgramPoints();		//Points the display program generated during the last refresh
+	static const uint16_t progHalt=0, progLine=1, progCircle=2, progEllipse=3, progPoint=4,	//Display program opcodes
+			progOrigin=5, progDensity=6, progJump=7, progCall=8, progRet=9;
+	static const uint16_t StagePoints=128;	//Points per staging buffer (the generator uses two)
+	static const uint8_t ProgramStackDepth=4;	//Max nesting of progCall
+	static const uint16_t MaxProgramOps=4096;	//Opcodes executed per refresh before the program is cut off (runaway jump loops)
+
+	//Packed List Routines (points stored delta/run encoded and expanded by the DACC ISR at refresh time; see setPackedList())
+	void setPackedList(uint8_t *store, int bytes);	//Plot routines encode points into 'store' (1-2 bytes per point along strokes). NULL = off
+	int getPackedBytes();				//Bytes used in the packed store
+	int getPackedPoints();				//Points in the packed store
+
+	//Stream Routines (continuous output from a ring buffer instead of a refreshed list; see streamBegin())
+	void streamBegin(pointList *ring, int points);	//Start draining 'ring' to the DACs; list refresh stops
+	void streamEnd();					//Stop streaming and go back to refreshing the list
+	bool streamPoint(int x0, int y0);	//Queue one point. false = ring full (point not queued)
+	int getStreamLevel();				//Points queued and not yet sent
+	int getStreamSpace();				//Points that can be queued right now
+	uint32_t getStreamUnderruns();		//Times the ring ran empty while streaming (beam was blanked)
+	void setStreamCallback(void (*streamCallback)(uint8_t event, int level), int lowMark, int highMark);	//Watermark/underrun events
+	static const uint8_t streamLowWater=0, streamHighWater=1, streamUnderrun=2;	//streamCallback events
+	static const uint16_t StreamBlockPoints=64;	//Max points per PDC block taken from the ring
+	static const uint16_t StreamFillerPoints=32;	//Points in the blanked filler block sent while the ring is empty
+
+	//Deferred Plot Routines (line/circle/ellipse calls are queued, then rasterized as one batch by flush(); see setCommandQueue())
+	struct plotCommand{
+		short p[4];							//Line: x0,y0,x1,y1; circle: xc,yc,r; ellipse: xc,yc,xr,yr
+		uint8_t op;							//Primitive (cmdLine, ...)
+		uint8_t arcSegment;					//Arc segments for circle/ellipse arcs
+		uint8_t density;					//Dot spacing in effect when the call was queued
+	};
+	void setCommandQueue(plotCommand *queue, int size, uint8_t options=cmdCull | cmdReorder);	//Queue plot calls in 'queue'. NULL = plot immediately
+	int flush();						//Rasterize all queued calls into the list. Returns points added
+	int getQueuedCommands();			//Number of plot calls waiting for flush()
+	int renderStep(uint32_t budget_us);	//Rasterize queued calls for about budget_us. Returns commands left (0 = frame done)
+	static const uint8_t cmdCull=1;		//flush() option: drop figures that are entirely off screen
+	static const uint8_t cmdReorder=2;	//flush() option: reorder (and reverse lines) to shorten beam travel between figures
 
 	//Graphics Plotting Routines
 
+	void plotPoints(const pointList *list, int points);	//Copy precomputed points (XY_POINT tables, XYscopeConst.h) into the list
+
 	void setGraphicsIntensity(short GraphBright=100);	//Set (Get) brightness of Lines, Circles, Ellipse, Rectangles (in percent)
 	short getGraphicsIntensity();							//Nominal setting is 100. Usable range is 50-200.
 
@@ -64,6 +189,10 @@ class XYscope{
 	short getTextIntensity();								//Nominal setting is 100. Usable range is 50-200.
 	short getTextDensity();								//OBSOLETE-DO NOT USE. Function returns dot-to-dot spacing value in use (driven by intensity setting)
 
+	void setLodControl(bool enable, uint32_t targetFrame_us=CrtMinRefresh_ms*1000);	//Level of detail: plotStart() thins out graphics/text so the scene fits targetFrame_us
+	uint8_t getLodLevel();									//Current level of detail in percent (100 = full detail, LodMinLevel = sparsest)
+	static const uint8_t LodMinLevel=25;					//Lowest level of detail the LOD controller goes down to
+
 	void plotPoint(int x0, int y0);											// Plots a POINT
 	void plotLine(int x0, int y0, int x1, int y1);							// Plots Lines (aka: a Vector)
 	void plotRectangle(int x0, int y0, int x1, int y1);						// Plots a rectangle	
@@ -106,6 +235,8 @@ class XYscope{
 
 
 	static const uint8_t crtBlankingPin=3;		//CRT_Blanking pin (1=CRT_OFF, 0=CRT_ON)
+												// begin() hands this pin to the blank timer: TC2 channel 1 (DueTimer's Timer7), output TIOA7.
+												// The sketch must NOT use Timer7, nor set up or write pin 3 (pinMode/digitalWrite) itself.
 	uint16_t frontPorchBlankCount=100;			//Calculated and set by setDmaClockRate(int dmaClkFreq); Used to define the duration before CRT unblanks & displays starts at START of DMA transfer
 	uint16_t backPorchBlankCount=100;			//Calculated and set by setDmaClockRate(int dmaClkFreq); Used to define the duration before CRT blanking starts and display ENDS after the completion of a DMA transfer
 	uint32_t DmaClkFreq_Hz;						//Currently Active DMA Clock FREQUENCY (Hz)
@@ -118,8 +249,11 @@ class XYscope{
 												// actually uses 15K X 4 = 60K bytes of RAM.  To leave room for other variables, MaxBufferSize should
 												// NEVER exceed MaxArraySize (about 20000).  Also note that a lots of XY points can require longer refresh times
 												// which will lead to display flicker!
+												// Changes to MaxBuffSize take effect at the next plotStart().
 
-	static const uint32_t MaxArraySize=17000;	//This sets the max Array size reserved for XY list.  MaxBufferSize must always be <= MaxArraySize!
+	static const uint32_t MaxArraySize=17000;	//Size (points) of the library's DEFAULT XY list buffer.  MaxBufferSize must always be <= the list capacity!
+												// The default buffer is only linked in when the default constructor is used.  To size the list at
+												// compile time use XYscopeSized<N> (or pass your own buffer to the constructor) instead.
 
 	int XYlistEnd;								//This value points to the last element loaded into XYlist[] array
 												//and is automatically maintained by Driver Routine "plotPoint"
@@ -136,6 +270,8 @@ class XYscope{
 												//	6. If the total number of points in the list gets too big, they may not all be displayed!
 												//     If this happens, either reduce the the number of points in the list, or increase the refresh period.
 												//	   You increase the the regresh period by changing the value of crtRefreshMs found else where in this file.						//
+												//  7. In double buffer mode (see setDoubleBuffer), XYlistEnd indexes the BACK buffer, which is NOT always
+												//     the start of XY_List[]. Only use plotPoint and the other plot routines to add points in that mode.
 
 
 	// Define Structure of XY Point List.  This is the actual data array that holds the points to be plotted to the CRT.
@@ -145,8 +281,9 @@ class XYscope{
 	struct pointList{
 		short X;	//X-coordinate value of a point. Valid range: 0-4095 (See also the "rules" in XYlistEnd comment above!)
 		short Y;	//Y-coordinate value of a point. Valid range: 0-4095 (See also the "rules" in XYlistEnd comment above!)
-	};
-	pointList XY_List[MaxArraySize];	//This reserves & defines the RAM allocated for the XY_List.  Actual value of usable space is set by variable MaxBuffSize
+	} __attribute__((aligned(4)));		//Word aligned: in full-word mode the PDC reads each point as one 32 bit word
+	pointList * const XY_List;			//Points at the RAM allocated for the XY_List (see constructors).  Actual value of usable space is set by variable MaxBuffSize
+	const uint32_t XY_ListCapacity;		//Number of points in the RAM allocated for XY_List
 
 	//Define Test Justification Flags
 	static const uint8_t LtJustify=0;	//Left Justified Text	(default)
@@ -166,6 +303,7 @@ class XYscope{
 	
 		
 	uint8_t plotErr;						//plotPoint routine sets this variable when ever we attempt to plot too many points
+											//  segmentOpen sets it when there is no room for a new segment
 
 
 
@@ -190,10 +328,207 @@ class XYscope{
 	void dacSetup (void);				//Called within begin(). Initializes and enables dac peripherals.
 	void tcSetup (uint32_t XfrRateHz);	//Called within begin().  Used to initialize Timer Counter TC0 (Drive DAC_DMA channel) at target transfer rate
 	uint32_t FreqToTimerTicks(uint32_t freqHz);	//Used within tcSetup to set DMA_Clock Rate
+	void setPorchCounts(void);			//Compute front/back porch blank counts from DmaClkPeriod_us and the transfer mode
+	uint8_t _dmaUnitsPerPoint;			//PDC count per XY point: 2 (half-word mode) or 1 (full-word mode)
+	void swapBuffers(void);				//Called from the ISRs between DMA transfers; performs a pending front/back swap
+	void waitForSwap(void);				//Wait until a presented back buffer has become the front buffer
 
 
 	//Private Variables
 
+	//Display list pointers.  In single buffer mode, _plotList and _dmaList both point at XY_List.
+	pointList *_plotList;				//List that the plot routines write into (BACK buffer in double buffer mode)
+	int _plotListSize;					//Capacity (points) of _plotList
+	pointList * volatile _dmaList;		//List the DMA transfers to the screen (FRONT buffer in double buffer mode)
+	volatile int _dmaListEnd;			//Number of points in the FRONT buffer (double buffer mode only)
+	pointList * volatile _swapList;		//Back buffer queued by present(), waiting for the next end-of-transfer
+	volatile int _swapListEnd;
+	volatile bool _swapPending;			//true while a presented back buffer is waiting to be swapped in
+	bool _doubleBuffer;					//true = front/back buffer mode
+	int _plotLimit;						//plotPoint stops adding points at this index (from MaxBuffSize and _plotListSize)
+
+	//Layers.  The dynamic list (single list, or both double buffer banks) lives in _dynList[0.._dynCapacity-1].
+	const pointList *_bgList;			//Static background list (NULL = none)
+	int _bgPoints;						//Points in background list
+	pointList *_dynList;				//Start of RAM used by the dynamic list(s); XY_List when there is no background
+	int _dynCapacity;					//Points available at _dynList
+
+	//DMA block chain.  initiateDacDma() builds the chain; the PDC current/next register pairs walk through it.
+	struct dmaBlock{
+		const pointList *list;
+		uint16_t points;
+	};
+	static const uint8_t MaxDmaBlocks=12+MaxObjects+MaxRepeatBlocks;	//Background + list + chunks + pool objects + static lists + segment repeats
+	dmaBlock _dmaBlock[MaxDmaBlocks];
+	volatile uint8_t _dmaBlockCount;	//Blocks in the chain for the current transfer
+	volatile uint8_t _dmaBlockNext;		//Next block to hand to the PDC
+	dmaBlock _staticList[MaxStaticLists];	//Static lists (points=0: slot unused)
+	int _staticPoints;					//Points in all static lists
+	dmaBlock _chunk[MaxListChunks];		//Extra list RAM, used in order after _plotList fills up (single buffer mode only)
+	uint8_t _chunkCount;
+	int _chunkPoints;					//Points in all chunks
+	pointList &listPoint(int ix) { return ix < _plotListSize ? _plotList[ix] : chunkPoint(ix); }	//Point ix of the list being plotted (may be in a chunk)
+	pointList &chunkPoint(int ix);		//listPoint() for indexes beyond _plotListSize
+	void chainAddList(const pointList *list, int listSize, int points);	//Add a list that may continue into the chunks
+	void chainAddRange(const pointList *list, int listSize, int from, int to);	//Add points from..to-1 of such a list
+	void chainAddSegments(const pointList *list, int listSize, int points);	//chainAddList, replaying repeated segments
+	void setPlotLimit(void);			//Recompute _plotLimit from MaxBuffSize, _plotListSize and the chunks
+	void chainAdd(const pointList *list, int points);	//Append a block to the chain (empty blocks are skipped)
+	void chainStart(void);				//Start the PDC on the first block(s) of the chain
+	bool chainAdvance(uint32_t status);	//Called by dacHandler; hand the next block to the PDC. false = chain is finished
+	bool chainNext(const pointList *&list, int &points);	//Next block for the PDC: chain blocks first, then generated staging buffers
+	bool chainPending(void);			//true while blocks remain to be handed to the PDC
+
+	//Staging buffers, filled from the DACC ISR after the chain blocks: display program, packed list, then interlaced list field.
+	pointList *_stage;					//Two staging buffers of StagePoints each
+	uint8_t _stageNext;					//Staging buffer to fill next (0/1)
+	volatile uint8_t _streamSource;		//Source filling the staging buffers this refresh (streamNone = finished)
+	static const uint8_t streamNone=0, streamProgram=1, streamPacked=2, streamField=3;
+	void streamReset(void);				//Select the first source at the start of a refresh
+	void streamNext(void);				//Current source has finished: move on to the next one with points to paint
+	int streamFill(pointList *buf, int maxPoints);	//Fill buf from the sources in turn. Returns points written
+
+	//Display program generator.  Expands _program into the staging buffers (see programFill).
+	const uint16_t *_program;			//Display program (NULL = none)
+	uint16_t _genPc;					//Program counter (index into _program)
+	uint8_t _genSp;						//progCall stack
+	uint16_t _genStack[ProgramStackDepth];
+	short _genStackOx[ProgramStackDepth], _genStackOy[ProgramStackDepth];
+	short _genOx, _genOy;				//Origin added to all coordinates (progOrigin)
+	short _genDensity;					//Dot-to-dot spacing (as _graphDensity)
+	uint16_t _genOps;					//Opcodes executed this refresh
+	uint8_t _genKind;					//Figure being expanded: genLine or genConic
+	static const uint8_t genLine=0, genConic=1;
+	int _genCount;						//Points left in the figure being expanded
+	int32_t _genX, _genY, _genDx, _genDy;	//Line: position and step (16.16 fixed point)
+	int32_t _genU, _genV, _genE;		//Conic: Minsky rotation of unit vector (U,V) by angle E (2.14 fixed point)
+	short _genXc, _genYc, _genXr, _genYr;
+	int32_t _genAng;					//Conic: angle from the start point (2.14), picks the arc segment
+	uint8_t _genArcs;					//Conic: arc segments to draw (as plotCircle's arcSegment)
+	uint32_t _genFramePoints;			//Points generated so far this refresh
+	volatile uint32_t _genLastPoints;	//Points generated by the last complete refresh
+	void programReset(void);			//Rewind the generator at the start of a refresh
+	int programFill(pointList *buf, int maxPoints);	//Expand the program into buf. Returns points written (< maxPoints: finished)
+	bool programStep(void);				//Decode one opcode. false = program finished
+
+	//Packed list.  plotPoint() encodes into _packStore; packedFill() decodes it from the DACC ISR.
+	uint8_t *_packStore;				//Packed store (NULL = packed list off)
+	int _packCapacity;					//Bytes at _packStore
+	volatile int _packBytes;			//Bytes used.  Only bumped once a whole record has been written.
+	int _packPoints;					//Points encoded
+	int _packRunIx;						//Index of the run record being extended (-1 = none)
+	short _packX, _packY, _packVx, _packVy;	//Encoder: last point and last step
+	int _unpPos, _unpEnd, _unpRun;		//Decoder: next byte, end of store for this refresh, run points left
+	short _unpX, _unpY, _unpVx, _unpVy;	//Decoder: last point and last step
+	void packReset(void);				//Empty the packed store (plotStart)
+
+	//Interlace.  The dynamic list is copied into the staging buffers one field (every _fields'th point) per refresh.
+	uint8_t _interlace;					//setInterlace() value (0 = auto)
+	volatile uint8_t _fields;			//Fields in use (1 = list goes straight to the DMA); set from loop()
+	uint8_t _fldCount;					//_fields latched by initiateDacDma() for the refresh being painted
+	uint8_t _field;						//Field painted next refresh
+	const pointList *_fldList;			//Field copy: list, its size (the rest is in the chunks), next point and end
+	int _fldListSize, _fldPos, _fldEnd;
+	int fieldFill(pointList *buf, int maxPoints);	//Copy the field into buf. Returns points written (< maxPoints: finished)
+	void packPoint(int x0, int y0);		//Encode one point
+	int packedFill(pointList *buf, int maxPoints);	//Decode into buf. Returns points written (< maxPoints: finished)
+
+	//Stream ring (see streamBegin).  loop() moves _ringHead, the DACC ISR moves _ringTail/_ringSend.
+	pointList * volatile _ringList;		//Ring buffer (NULL = not streaming; list is refreshed)
+	int _ringSize;						//Points in ring
+	volatile int _ringHead;				//Next point to be written by streamPoint()
+	volatile int _ringTail;				//First point not yet sent by the DMA (streamPoint() stops here)
+	int _ringSend;						//First point not yet handed to the PDC
+	int _ringInFlight[2];				//Blocks in the PDC current/next registers: data points, 0 = filler
+	pointList _ringLast;				//Last point handed to the PDC (the filler parks the beam there)
+	bool _ringBlanked;					//Blanking pin state while streaming
+	volatile bool _ringLowArmed, _ringHighArmed;	//Watermark events are re-armed once the level crosses back
+	int _ringLowMark, _ringHighMark;
+	void (* volatile _streamCallback)(uint8_t event, int level);
+	volatile uint32_t _ringUnderruns;
+	int streamTake(const pointList *&list);	//Next block for the PDC: ring data, or the filler. Returns data points (0 = filler)
+	void streamAdvance(uint32_t status);	//Called by dacHandler while streaming
+
+	//Deferred plot command queue (see setCommandQueue)
+	plotCommand *_cmdQueue;				//Queue (NULL = plot calls rasterize immediately)
+	int _cmdSize;						//Commands the queue can hold
+	int _cmdCount;						//Commands queued
+	int _cmdDone;						//Commands at the front of the queue already rasterized (by renderStep)
+	uint8_t _cmdOptions;				//cmdCull, cmdReorder
+	uint8_t _cmdSuspend;				//>0: queueing suspended (flush, segments, scene nodes rasterize directly)
+	static const uint8_t cmdLine=0, cmdCircle=1, cmdCircleArc=2, cmdEllipseArc=3;
+	bool cmdQueue(uint8_t op, int p0, int p1, int p2, int p3, uint8_t arcSegment);	//Queue a plot call. false = not deferred, plot it now
+	void cmdBounds(const plotCommand &cmd, int &x0, int &y0, int &x1, int &y1);	//Bounding box of a command
+	bool cmdRenderNext(void);			//Rasterize the next queued command. false = queue empty
+
+	struct segmentEntry{
+		int start;						//Index of first point of segment in _plotList
+		int capacity;					//Reserved points
+		int used;						//Points actually drawn; the rest are padding
+		uint8_t repeat;					//Times the segment is painted per refresh (see segmentSetRepeat)
+	};
+	segmentEntry _segment[MaxSegments];	//Segment table; reset by plotStart()
+	uint8_t _segmentCount;
+	int _activeSegment;					//Segment being re-rendered (-1 = none)
+	int _segSavedListEnd;				//XYlistEnd and _plotLimit saved by segmentBegin()
+	int _segSavedLimit;
+	void segmentPad(int handle);		//Fill unused segment slots
+	int segmentOpen(int capacity, int used);	//segmentOpen() for a segment whose first 'used' points are already plotted
+
+	//Object pool.  The pool is split into blocks, linked in address order; each block is free or holds one object.
+	struct poolBlock{
+		int start;						//Index of first point of block in _pool
+		int capacity;					//Points in block
+		int used;						//Points drawn (objects only)
+		int8_t prev, next;				//Neighbouring blocks in address order (-1 = none)
+		uint8_t state;					//blockUnused (entry not in use), blockFree, blockObject
+		uint8_t dim;					//Painted every dim'th refresh (objects only; see objectSetDim)
+	};
+	static const uint8_t blockUnused=0, blockFree=1, blockObject=2;
+	static const uint8_t MaxPoolBlocks=2*MaxObjects+3;	//Objects, the free gaps between them, and room for objectResize() to move one
+	pointList *_pool;					//Pool RAM (NULL = no pool)
+	int _poolSize;
+	poolBlock _poolBlock[MaxPoolBlocks];
+	int8_t _poolHead;					//First block in address order
+	int8_t _object[MaxObjects];			//Object handle -> block (-1 = handle not in use)
+	int _poolPoints;					//Points drawn in all objects
+	int _activeObject;					//Object being drawn (-1 = none)
+	pointList *_objSavedList;			//List state saved by objectBegin()
+	int _objSavedListSize, _objSavedListEnd, _objSavedLimit;
+	uint8_t *_objSavedPackStore;
+	int poolAlloc(int capacity);		//Allocate a block (first fit). Returns block index (-1 = no room)
+	void poolFree(int block);			//Return a block to the free space, merging it with free neighbours
+	void poolUnlink(int block);			//Take a block out of the address order list
+	int poolEntry(void);				//Unused block table entry (-1 = none)
+	void chainAddPool(void);			//Append the pool objects to the DMA chain
+
+	struct sceneNode{
+		uint8_t type;					//sceneLine, sceneCircle, sceneEllipse or sceneText
+		bool dirty;						//true = node changed since it was last plotted
+		int8_t segment;					//Segment holding the node's points
+		short p[4];						//Shape parameters (line: x0,y0,x1,y1; circle: xc,yc,r; ellipse: xc,yc,xr,yr; text: x,y,size)
+		char text[MaxSceneText + 1];
+	};
+	static const uint8_t sceneLine=0, sceneCircle=1, sceneEllipse=2, sceneText=3;
+	sceneNode _sceneNode[MaxSegments];	//One node per segment; reset by plotStart()
+	uint8_t _sceneCount;
+	int sceneAdd(sceneNode &node, int capacity);	//Plot a new node and wrap it in a segment
+	void scenePlot(const sceneNode &node);			//Plot a node at XYlistEnd
+	void sceneSet(int node, uint8_t type, int p0, int p1, int p2, int p3);	//Update node parameters, mark dirty on change
+	void init(void);					//Common constructor code
+	uint32_t refreshRetryUs(void);		//Event driven refresh: delay before retrying a refresh that had to be held off
+
+	volatile uint32_t _frameCount;		//Frames painted (bumped by dacHandler at end-of-transfer)
+	void (* volatile _frameCallback)(uint32_t frameCount);	//Optional user routine called at end of each frame
+	volatile bool _eventRefresh;		//Event driven refresh (see setEventRefresh)
+	volatile bool _refreshPending;		//Event driven refresh: minimum frame period is over, start as soon as the DMA is idle
+	volatile uint32_t _ringDrain_us;	//Event driven refresh: time the ring blocks left running by streamEnd() take (0 = none)
+	bool _backToBack;					//initiateDacDma() called from dacHandler() at end of the previous frame
+
+	volatile uint32_t _editSeq;			//Edit sequence number; ODD = edit window open (refreshes are held off)
+	uint8_t _editDepth;					//Nesting depth of beginEdit()/commitEdit() calls
+	volatile uint32_t _deferredRefreshes;	//Refresh interrupts skipped while an edit window was open
+
 	//int _density=5;		//This is the global "active_density" value
 	int _graphDensity;		//value calculated by/set by call to SetGraphicsIntensity(int brightness)
 	int _graphBrightness;	//value that is set by call to SetGraphicsIntensity(int graphbrightness)
@@ -201,6 +536,13 @@ class XYscope{
 	int _textDensity;		//value calculated by/set by call to SetTextIntensity(int brightness)
 	int _textBrightness;	//value that is set by call to SetGraphicsIntensity(int graphbrightness)
 
+	bool _lodEnable;		//Level of detail controller on (see setLodControl)
+	uint32_t _lodTarget_us;	//Frame time the controller aims for
+	uint8_t _lodLevel;		//Level of detail (percent); graphics and text densities are divided by it
+	bool _listFull;			//Points were dropped since plotStart() (list or packed store full)
+	int lodDensity(int density);	//Density at the current level of detail
+	void lodUpdate(void);	//Measure the list that is being replaced and pick the level of detail for the next one
+
 	unsigned long _crtOffTOD_ms;	//Screen save time in ms; Zero means screen saver disabled.
 	unsigned long _screenOnTime_ms;	//TOD (ms) when Screen should next be blanked;
 
@@ -217,6 +559,39 @@ class XYscope{
 	float _libRev=0.0;
 
 };
+
+//Define one entry of a static (FLASH) point list, with the X/Y DAC routing flags applied.  See XYscope::addStaticList().
+#define XY_POINT(x, y)	{ (short) (((x) & 0xfff) | XYscope::X_flag), (short) (((y) & 0xfff) | XYscope::Y_flag) }
+
+//Display program opcodes, for building the uint16_t array passed to XYscope::setDisplayProgram().
+//Coordinates are signed 16 bit values, relative to the current origin.  Addresses are word indexes into the program.
+//Circles and ellipses end with an arc segment mask, numbered as plotCircle(xc, yc, r, arcSegment) (0xff = whole figure).
+#define XYP_HALT					XYscope::progHalt
+#define XYP_LINE(x0, y0, x1, y1)	XYscope::progLine, (uint16_t) (x0), (uint16_t) (y0), (uint16_t) (x1), (uint16_t) (y1)
+#define XYP_CIRCLE(xc, yc, r)		XYP_ARC(xc, yc, r, 0xff)
+#define XYP_ARC(xc, yc, r, arcSegment)	XYscope::progCircle, (uint16_t) (xc), (uint16_t) (yc), (uint16_t) (r), (uint16_t) (arcSegment)
+#define XYP_ELLIPSE(xc, yc, xr, yr)	XYP_ELLIPSE_ARC(xc, yc, xr, yr, 0xff)
+#define XYP_ELLIPSE_ARC(xc, yc, xr, yr, arcSegment)	XYscope::progEllipse, (uint16_t) (xc), (uint16_t) (yc), (uint16_t) (xr), (uint16_t) (yr), (uint16_t) (arcSegment)
+#define XYP_POINT(x, y)				XYscope::progPoint, (uint16_t) (x), (uint16_t) (y)
+#define XYP_ORIGIN(x, y)			XYscope::progOrigin, (uint16_t) (x), (uint16_t) (y)
+#define XYP_DENSITY(d)				XYscope::progDensity, (uint16_t) (d)
+#define XYP_JUMP(addr)				XYscope::progJump, (uint16_t) (addr)
+#define XYP_CALL(addr)				XYscope::progCall, (uint16_t) (addr)
+#define XYP_RET						XYscope::progRet
+
+template <uint32_t N>
+class XYscopeSized : public XYscope {
+	//	XYscope with an XY list of exactly N points reserved inside the object, sized at compile time.
+	//	Use this in place of XYscope to give RAM back to the rest of the sketch (or to use more of it):
+	//
+	//		XYscopeSized<4000> XYscope;		//16K bytes of XY list instead of the default 68K bytes
+	//
+	//	Everything else (begin, plot routines, ISR hookup, etc.) is exactly the same as XYscope.
+  public:
+	XYscopeSized() : XYscope(_list, N) {}
+  private:
+	pointList _list[N];
+};
 #endif // XYscope
 
 
@@ -0,0 +1,184 @@
+/*
+ * XYscopeConst.h
+ *
+ *      Compile-time (constexpr) versions of the XYscope graphics primitives.
+ *
+ *      These generators produce CONSTANT point tables, with the X_flag/Y_flag DAC routing bits already
+ *      applied, while the sketch is being COMPILED.  At run time there is no Bresenham or trig work at all:
+ *      a table is either sent straight to the DACs by the DMA (XYscope::addStaticList) or copied into the
+ *      display list (XYscope::plotPoints).  Declared at file scope as 'const', a table lives in FLASH.
+ *
+ *		#include "XYscopeConst.h"
+ *
+ *		const auto frame = XYconst::rectangle<100, 100, 3995, 3995>();
+ *		const auto dial = XYconst::join(XYconst::circle<2047, 2047, 1500>(),
+ *								XYconst::line<2047, 600, 2047, 900>());
+ *		...
+ *		XYscope.addStaticList(frame.pts, frame.points);		//Zero copy; painted every refresh
+ *		XYscope.plotPoints(dial.pts, dial.points);			//Copy into the display list
+ *
+ *      Coordinates and the 'density' (dot-to-dot spacing, in DAC steps = density+1) are template
+ *      parameters because they decide the size of the table.  density=10 matches the run-time plot
+ *      routines at 100% graphics intensity.  Points are spaced evenly along each figure, so tables are
+ *      very close to, but not bit-for-bit the same as, the output of the run-time routines.
+ *
+ *      Text is not supported: the vector font is per-object data of class XYscope and is not available
+ *      to the compiler as a constant.
+ *
+ *      Requires C++11 (the DUE core compiles with -std=gnu++11).
+ */
+
+#ifndef XYSCOPECONST_H_
+#define XYSCOPECONST_H_
+
+#include "XYscope.h"
+
+namespace XYconst {
+
+//Table of N constant points
+template <int N>
+struct list {
+	XYscope::pointList pts[N];
+	enum { points = N };
+};
+
+//----------------------------------------------------
+//  Helpers (index sequences, rounding, sin/cos)
+//----------------------------------------------------
+template <int... I> struct seq {};
+
+template <class A, class B> struct catSeq;
+template <int... A, int... B> struct catSeq<seq<A...>, seq<B...> > {
+	typedef seq<A..., (int(sizeof...(A)) + B)...> type;
+};
+
+template <int N> struct makeSeq {	//seq<0..N-1>, built in log2(N) template levels
+	typedef typename catSeq<typename makeSeq<N / 2>::type, typename makeSeq<N - N / 2>::type>::type type;
+};
+template <> struct makeSeq<0> { typedef seq<> type; };
+template <> struct makeSeq<1> { typedef seq<0> type; };
+
+constexpr int absInt(int v) {
+	return v < 0 ? -v : v;
+}
+
+constexpr int maxInt(int a, int b) {
+	return a > b ? a : b;
+}
+
+constexpr int divRound(int a, int b) {	//a/b rounded to nearest, b > 0
+	return a >= 0 ? (a + b / 2) / b : -((-a + b / 2) / b);
+}
+
+constexpr int roundInt(double v) {
+	return int(v >= 0 ? v + 0.5 : v - 0.5);
+}
+
+constexpr double pi = 3.14159265358979323846;
+
+constexpr double sinSeries(double a2, double term, int k, int n) {
+	return n == 0 ? 0.0 : term + sinSeries(a2, -term * a2 / ((2 * k) * (2 * k + 1)), k + 1, n - 1);
+}
+
+constexpr double cosSeries(double a2, double term, int k, int n) {
+	return n == 0 ? 0.0 : term + cosSeries(a2, -term * a2 / ((2 * k - 1) * (2 * k)), k + 1, n - 1);
+}
+
+//sin/cos of 0 <= t < 2*pi; shifted to -pi..pi so 14 Taylor terms are plenty
+constexpr double sinT(double t) {
+	return -sinSeries((t - pi) * (t - pi), t - pi, 1, 14);
+}
+
+constexpr double cosT(double t) {
+	return -cosSeries((t - pi) * (t - pi), 1.0, 1, 14);
+}
+
+constexpr XYscope::pointList point(int x, int y) {
+	return { short((x & 0xfff) | XYscope::X_flag), short((y & 0xfff) | XYscope::Y_flag) };
+}
+
+//----------------------------------------------------
+//  LINE
+//----------------------------------------------------
+constexpr int lineSteps(int x0, int y0, int x1, int y1) {
+	return maxInt(absInt(x1 - x0), absInt(y1 - y0));
+}
+
+constexpr int linePoints(int x0, int y0, int x1, int y1, int density) {
+	//One point every density+1 steps along the major axis, plus the end point
+	return lineSteps(x0, y0, x1, y1) / (density + 1) + 1
+			+ (lineSteps(x0, y0, x1, y1) % (density + 1) != 0 ? 1 : 0);
+}
+
+constexpr int lineCoord(int c0, int c1, int s, int steps) {
+	return steps == 0 ? c0 : c0 + divRound((c1 - c0) * s, steps);
+}
+
+constexpr XYscope::pointList linePoint(int x0, int y0, int x1, int y1, int s, int steps) {
+	return point(lineCoord(x0, x1, s < steps ? s : steps, steps), lineCoord(y0, y1, s < steps ? s : steps, steps));
+}
+
+template <int N, int... I>
+constexpr list<N> lineTable(int x0, int y0, int x1, int y1, int density, seq<I...>) {
+	return { { linePoint(x0, y0, x1, y1, I * (density + 1), lineSteps(x0, y0, x1, y1))... } };
+}
+
+template <int x0, int y0, int x1, int y1, int density = 10>
+constexpr list<linePoints(x0, y0, x1, y1, density)> line() {
+	//	Constant version of XYscope::plotLine(x0, y0, x1, y1)
+	return lineTable<linePoints(x0, y0, x1, y1, density)>(x0, y0, x1, y1, density,
+			typename makeSeq<linePoints(x0, y0, x1, y1, density)>::type());
+}
+
+//----------------------------------------------------
+//  JOIN (concatenate two tables)
+//----------------------------------------------------
+template <int N, int M, int... I>
+constexpr list<N + M> joinTable(const list<N> &a, const list<M> &b, seq<I...>) {
+	return { { (I < N ? a.pts[I] : b.pts[I - N])... } };
+}
+
+template <int N, int M>
+constexpr list<N + M> join(const list<N> &a, const list<M> &b) {
+	//	Table holding the points of a, followed by the points of b
+	return joinTable<N, M>(a, b, typename makeSeq<N + M>::type());
+}
+
+//----------------------------------------------------
+//  RECTANGLE
+//----------------------------------------------------
+template <int x0, int y0, int x1, int y1, int density = 10>
+constexpr list<linePoints(x0, y0, x1, y0, density) + linePoints(x1, y0, x1, y1, density)
+		+ linePoints(x1, y1, x0, y1, density) + linePoints(x0, y1, x0, y0, density)> rectangle() {
+	//	Constant version of XYscope::plotRectangle(x0, y0, x1, y1); same side order
+	return join(join(line<x0, y0, x1, y0, density>(), line<x1, y0, x1, y1, density>()),
+			join(line<x1, y1, x0, y1, density>(), line<x0, y1, x0, y0, density>()));
+}
+
+//----------------------------------------------------
+//  CIRCLE
+//----------------------------------------------------
+constexpr int circlePoints(int r, int density) {
+	//One point every density+1 steps along the circumference (at least 8)
+	return maxInt(8, roundInt(2.0 * pi * r / (density + 1)));
+}
+
+constexpr XYscope::pointList circlePoint(int xc, int yc, int r, int i, int n) {
+	return point(xc - roundInt(r * cosT(2.0 * pi * i / n)), yc + roundInt(r * sinT(2.0 * pi * i / n)));
+}
+
+template <int N, int... I>
+constexpr list<N> circleTable(int xc, int yc, int r, seq<I...>) {
+	return { { circlePoint(xc, yc, r, I, N)... } };
+}
+
+template <int xc, int yc, int r, int density = 10>
+constexpr list<circlePoints(r, density)> circle() {
+	//	Constant version of XYscope::plotCircle(xc, yc, r).  Like plotCircle(xc, yc, r, arcSegment) (and the
+	//	XYscopeEmit.h circle), the table starts at the left hand side (xc-r, yc) and runs through the top.
+	return circleTable<circlePoints(r, density)>(xc, yc, r, typename makeSeq<circlePoints(r, density)>::type());
+}
+
+}	// namespace XYconst
+
+#endif /* XYSCOPECONST_H_ */
@@ -0,0 +1,286 @@
+/*
+ * XYscopeEmit.h
+ *
+ *      Policy-based (template) versions of the XYscope primitive emitters: line, rectangle, circle,
+ *      ellipse and vector font glyph.
+ *
+ *      The run-time plot routines make the same decisions for every point: a density skip counter in the
+ *      primitive, then the plotPoint() end-of-list check, screen saver millis() update, 12 bit mask and
+ *      DAC flag OR.  Here those choices are template parameters of an 'emitter', so the compiler builds a
+ *      separate inner loop for each combination and drops the code for features that are switched off:
+ *
+ *		Sink		Where points go:
+ *					  listSink	XYscope display list, in blocks of 64 points (one XYscope::plotPoints call per
+ *								block).  When a packed list is set (XYscope::setPackedList) the block is
+ *								encoded into the compressed store instead.
+ *					  ringSink	Streaming ring (XYscope::streamBegin); points that do not fit are dropped.
+ *					  traceSink	A plain RAM array, e.g. to trace or test figures on the host, or to build a
+ *								table for XYscope::addStaticList.
+ *		Clip		noClip		Coordinates are masked to 12 bits (out of range points fold over, as plotPoint).
+ *					clipScreen	Points outside 0-4095 are dropped.
+ *		Transform	identity	Nothing to do.
+ *					translate	Add a fixed offset.
+ *					scale		Multiply by a 16.16 factor (x and y), then add an offset.
+ *		Density		fixedDensity<D>	Dot-to-dot spacing of D+1 DAC steps, known at compile time.
+ *					runtimeDensity	Spacing set at run time (as XYscope::setGraphicsIntensity does).
+ *
+ *      Figures are stepped with fixed point adds (lines: a 16.16 DDA along the major axis; circles and
+ *      ellipses: an exact rotation, one sin/cos pair per 45 degree arc instead of one per point), so there
+ *      is no skip counter and no floating point in any inner loop.  Points are spaced evenly along each
+ *      figure; the result is within a DAC step or so of the run-time routines, not bit-for-bit the same.
+ *
+ *		#include "XYscopeEmit.h"
+ *
+ *		XYemit::listSink out(XYscope);
+ *		XYemit::emitter<XYemit::listSink, XYemit::noClip, XYemit::identity, XYemit::fixedDensity<10> > draw(out);
+ *		draw.rectangle(100, 100, 3995, 3995);
+ *		draw.circle(2047, 2047, 1500);
+ *		int x = 200, y = 3500, ht = 200;
+ *		draw.glyph(XYscope, 'A', x, y, ht);
+ *		out.flush();			//Send the last partial block (also done when 'out' goes out of scope)
+ *
+ *      Like the plot routines, emitters add to the list; they are not queued by setCommandQueue and do not
+ *      set plotErr.  See examples/EMIT_BENCHMARK for a points per second comparison.
+ *
+ *      Requires C++11 (the DUE core compiles with -std=gnu++11).
+ */
+
+#ifndef XYSCOPEEMIT_H_
+#define XYSCOPEEMIT_H_
+
+#include "XYscope.h"
+
+namespace XYemit {
+
+//----------------------------------------------------
+//  SINKS
+//----------------------------------------------------
+class listSink {
+	//Display list (or packed store) of an XYscope, in blocks
+  public:
+	enum { BlockPoints = 64 };
+	listSink(XYscope &scope) : _scope(scope), _n(0) {}
+	~listSink() { flush(); }
+	void put(int x, int y) {
+		_block[_n].X = short((x & 0xfff) | XYscope::X_flag);
+		_block[_n].Y = short((y & 0xfff) | XYscope::Y_flag);
+		if (++_n == BlockPoints)
+			flush();
+	}
+	void flush() {
+		if (_n > 0)
+			_scope.plotPoints(_block, _n);
+		_n = 0;
+	}
+  private:
+	XYscope &_scope;
+	XYscope::pointList _block[BlockPoints];
+	int _n;
+};
+
+class ringSink {
+	//Streaming ring of an XYscope (see XYscope::streamBegin)
+  public:
+	ringSink(XYscope &scope) : _scope(scope) {}
+	void put(int x, int y) { _scope.streamPoint(x & 0xfff, y & 0xfff); }
+	void flush() {}
+  private:
+	XYscope &_scope;
+};
+
+class traceSink {
+	//Plain RAM array of points (DAC flags applied); points beyond 'size' are counted but not stored
+  public:
+	traceSink(XYscope::pointList *pts, int size) : pts(pts), size(size), points(0) {}
+	void put(int x, int y) {
+		if (points < size) {
+			pts[points].X = short((x & 0xfff) | XYscope::X_flag);
+			pts[points].Y = short((y & 0xfff) | XYscope::Y_flag);
+		}
+		points++;
+	}
+	void flush() {}
+	XYscope::pointList *pts;
+	int size;
+	int points;			//Points emitted
+};
+
+//----------------------------------------------------
+//  CLIP, TRANSFORM AND DENSITY POLICIES
+//----------------------------------------------------
+struct noClip {
+	static bool inside(int, int) { return true; }
+};
+
+struct clipScreen {
+	static bool inside(int x, int y) { return unsigned(x) <= 4095 && unsigned(y) <= 4095; }
+};
+
+struct identity {
+	void apply(int &, int &) const {}
+};
+
+struct translate {
+	translate(int dx = 0, int dy = 0) : dx(dx), dy(dy) {}
+	void apply(int &x, int &y) const { x += dx; y += dy; }
+	int dx, dy;
+};
+
+struct scale {
+	//x' = x * sx / 65536 + dx (same for y)
+	scale(int32_t sx = 65536, int32_t sy = 65536, int dx = 0, int dy = 0) : sx(sx), sy(sy), dx(dx), dy(dy) {}
+	void apply(int &x, int &y) const {
+		x = int((int64_t(x) * sx) >> 16) + dx;
+		y = int((int64_t(y) * sy) >> 16) + dy;
+	}
+	int32_t sx, sy;
+	int dx, dy;
+};
+
+template <int D>
+struct fixedDensity {
+	fixedDensity(int = D) {}
+	static int get() { return D; }
+};
+
+struct runtimeDensity {
+	runtimeDensity(int d = 10) : d(d) {}
+	int get() const { return d; }
+	int d;
+};
+
+//----------------------------------------------------
+//  EMITTER
+//----------------------------------------------------
+template <class Sink, class Clip = noClip, class Transform = identity, class Density = runtimeDensity>
+class emitter {
+  public:
+	emitter(Sink &sink, Transform xf = Transform(), Density density = Density())
+			: sink(sink), xf(xf), density(density) {}
+
+	void point(int x, int y) {
+		xf.apply(x, y);
+		if (Clip::inside(x, y))
+			sink.put(x, y);
+	}
+
+	void line(int x0, int y0, int x1, int y1) {
+		//	Points every density+1 steps along the major axis, plus the end point.
+		//	The minor axis is stepped with a 16.16 DDA, so the loop has no branches besides its count.
+		int dx = x1 - x0, dy = y1 - y0;
+		int adx = dx < 0 ? -dx : dx, ady = dy < 0 ? -dy : dy;
+		int steps = adx > ady ? adx : ady;
+		int stride = density.get() + 1;
+		if (steps == 0) {
+			point(x0, y0);
+			return;
+		}
+		int n = steps / stride + 1;
+		int32_t x = x0 * 65536 + 32768, y = y0 * 65536 + 32768;		//+0.5 so >>16 rounds
+		int32_t sx = int32_t((int64_t(dx) * 65536 * stride) / steps);
+		int32_t sy = int32_t((int64_t(dy) * 65536 * stride) / steps);
+		for (int i = 0; i < n; i++) {
+			point(x >> 16, y >> 16);
+			x += sx;
+			y += sy;
+		}
+		if (steps % stride != 0)
+			point(x1, y1);
+	}
+
+	void rectangle(int x0, int y0, int x1, int y1) {
+		//	Same side order as XYscope::plotRectangle
+		line(x0, y0, x1, y0);
+		line(x1, y0, x1, y1);
+		line(x1, y1, x0, y1);
+		line(x0, y1, x0, y0);
+	}
+
+	void circle(int xc, int yc, int r, uint8_t arcSegment = 0xff) {
+		//	See XYscope::plotCircle(xc, yc, r, arcSegment)
+		ellipse(xc, yc, r, r, arcSegment);
+	}
+
+	void ellipse(int xc, int yc, int xr, int yr, uint8_t arcSegment = 0xff) {
+		//	See XYscope::plotEllipse.  Same start point (xc - xr, yc), direction and arc segment numbering.
+		//	Points are spaced about density+1 steps apart (at least 8 per figure).
+		const float pi = 3.14159265f;
+		float circumf = 2 * pi * sqrtf((float(xr) * xr + float(yr) * yr) / 2);
+		int n = int(circumf / (density.get() + 1));
+		if (n < 8)
+			n = 8;
+		//Unit vector (cos, sin) is rotated by the angle between points with 2.30 fixed point math
+		int32_t c = int32_t(cosf(2 * pi / n) * 1073741824.0f);
+		int32_t s = int32_t(sinf(2 * pi / n) * 1073741824.0f);
+		int i = 0;
+		for (int seg = 0; seg < 8; seg++) {
+			int end = seg == 7 ? n : int((int64_t(seg + 1) * n) / 8) + 1;	//First point past this 45 degree arc
+			if (end > n)
+				end = n;
+			if ((arcSegment & (1 << seg)) == 0 || i >= end) {
+				i = i > end ? i : end;
+				continue;
+			}
+			float a = 2 * pi * i / n;
+			int32_t u = int32_t(cosf(a) * 1073741824.0f), v = int32_t(sinf(a) * 1073741824.0f);
+			for (; i < end; i++) {
+				point(xc - int((int64_t(u) * xr + 536870912) >> 30), yc + int((int64_t(v) * yr + 536870912) >> 30));
+				int32_t t = int32_t((int64_t(u) * c - int64_t(v) * s) >> 30);
+				v = int32_t((int64_t(v) * c + int64_t(u) * s) >> 30);
+				u = t;
+			}
+		}
+	}
+
+	void glyph(XYscope &scope, char ch, int &charX, int &charY, int &charHt) {
+		//	Vector font character, as XYscope::plotChar (without the intensity change: the emitter's density
+		//	is used).  charX/charY are advanced to the next character position the same way.
+		const uint8_t PNT = 0x1, LIN = 0x2, REC = 0x3, CIR = 0x4, ELP = 0x5, EOC = 0x80;	//Font ROM opcodes (VectorFontROM.h)
+		int fontIx = int(scope.Ascii2Font[uint8_t(ch)] & 0x1ff);
+		int width = scope.getFontSpacing();
+		if (width == 0)
+			width = (scope.Ascii2Font[uint8_t(ch)] >> 9) & 0x0f;
+		for (int n = 0; n < 10; n++) {
+			const XYscope::FontROM &f = scope.DigitFont[fontIx + n];
+			int x0 = charX + (((f.P1 >> 4) * charHt) >> 4), y0 = charY + (((f.P1 & 0xf) * charHt) >> 4);
+			int x1 = charX + (((f.P2 >> 4) * charHt) >> 4), y1 = charY + (((f.P2 & 0xf) * charHt) >> 4);
+			switch (f.Opcode & 0x0f) {
+			case PNT:
+				point(x0, y0);
+				break;
+			case LIN:
+				line(x0, y0, x1, y1);
+				break;
+			case REC:
+				rectangle(x0, y0, x1, y1);
+				break;
+			case CIR:
+				circle(x0, y0, x1 - charX, f.P3);
+				break;
+			case ELP:
+				ellipse(x0, y0, x1 - charX, y1 - charY, f.P3);
+				break;
+			}
+			if ((f.Opcode & EOC) != 0)
+				break;
+		}
+		charX += (width * charHt) >> 4;
+		if (charX + charHt > 4095) {		//New line
+			charX = 0;
+			charY -= (15 * charHt) >> 4;
+		}
+	}
+
+	void text(XYscope &scope, const char *s, int &charX, int &charY, int charHt) {
+		while (*s != 0)
+			glyph(scope, *s++, charX, charY, charHt);
+	}
+
+	Sink &sink;
+	Transform xf;
+	Density density;
+};
+
+}	// namespace XYemit
+
+#endif /* XYSCOPEEMIT_H_ */
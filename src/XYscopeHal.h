@@ -0,0 +1,45 @@
+/*
+ * XYscopeHal.h
+ *
+ *      Hardware Abstraction Layer (HAL) for the XYscope library.
+ *
+ *      XYscope.cpp never touches the DUE peripheral registers directly.  Every access to the
+ *      DACC, its PDC (DMA) channel, Timer Counter TC0 (the DMA clock), the refresh timer
+ *      (Timer3) and the blank timer (CRT blanking pin) goes through the small set of routines declared below.  Two backends exist:
+ *
+ *        XYscopeHalSam3x.cpp	Arduino DUE (SAM3X8E) backend.  This is the real hardware driver.
+ *        XYscopeHalHost.cpp	Host (Linux) backend.  Emulates the DACC/PDC/TC0/Timer3 in virtual
+ *								time so plotting code can be profiled and regression tested off the board.
+ *
+ *      Exactly one backend is compiled; each .cpp file is guarded by the processor it serves.
+ */
+
+#ifndef XYSCOPEHAL_H_
+#define XYSCOPEHAL_H_
+
+#include <stdint.h>
+
+//Define DMA status/interrupt flags.  Bit positions match the DUE DACC_ISR/DACC_IER registers.
+const uint32_t XYHAL_ENDTX = 0x1u << 2;		//End of Transmit Buffer (PDC Transmit Counter Register reached zero)
+const uint32_t XYHAL_TXBUFE = 0x1u << 3;	//Transmit Buffer Empty (both current and next PDC counters are zero)
+
+void xyHalDacSetup(void);							//Power up DACC, select TAG mode, hook DACC interrupt into the NVIC
+void xyHalTcSetup(uint32_t tcTicks);				//Start TC0 (DMA clock) with a period of tcTicks (MCK/2 units)
+void xyHalDacWordMode(bool fullWord);				//false: PDC moves one half-word (sample) per transfer; true: one word (X and Y sample)
+void xyHalDmaStart(const void *list, uint16_t count);	//Point PDC at list, load count (half-words, or words in full-word mode) and enable transmitter. Clears the next registers.
+void xyHalDmaQueueNext(const void *list, uint16_t count);	//Load PDC next pointer/count; taken over when the current count runs out
+uint32_t xyHalDmaStatus(void);						//Read DACC interrupt status (XYHAL_ENDTX, XYHAL_TXBUFE)
+void xyHalDmaIrqEnable(uint32_t flags);				//Enable DACC interrupt source(s)
+void xyHalDmaIrqDisable(uint32_t flags);			//Disable DACC interrupt source(s)
+void xyHalRefreshTimerStart(uint32_t period_us);	//(Re)start the refresh timer (Timer3) at period_us
+void xyHalRefreshTimerStop(void);					//Stop the refresh timer
+void xyHalRefreshTimerOnce(uint32_t delay_us);		//Call the refresh timer ISR once, delay_us from now (replaces a running period)
+void xyHalBlankSetup(void);							//Hand the CRT blanking pin to the blank timer and BLANK the CRT
+void xyHalBlankNow(bool blanked);					//Set the blanking pin now (true = blanked); cancels a pending edge
+void xyHalUnblankAfter(uint16_t count);				//Blank now and unblank 'count' porch units (~60ns per count) later, without waiting
+void xyHalBlankAfter(uint16_t count);				//Blank 'count' porch units (~60ns per count) from now, without waiting
+void xyHalBlankPulse(uint16_t after, uint16_t count);	//Blank 'after' porch units from now, then unblank 'count' units later, without waiting
+void xyHalMemoryBarrier(void);						//Complete all prior memory accesses before any later ones (DUE: DMB instruction)
+void xyHalIdle(void);								//Called while foreground code waits on the ISRs (host backend advances virtual time)
+
+#endif /* XYSCOPEHAL_H_ */
@@ -0,0 +1,437 @@
+/*
+ * XYscopeHalHost.cpp
+ *
+ *      Host (Linux) backend of the XYscope Hardware Abstraction Layer.
+ *      Emulates the DUE DACC, its PDC channel, TC0 (DMA clock), Timer3 (refresh timer) and the
+ *      blank timer in virtual time.  See XYscopeHost.h for an overview and usage example.
+ */
+
+#if !defined(ARDUINO)
+
+#include <stdio.h>
+#include <atomic>
+#include "XYscopeHost.h"
+#include "XYscopeHal.h"
+
+//Blanking (Z-Axis) output used by the AGI hardware; see XYscope::crtBlankingPin
+static const uint8_t zAxisPin = 3;
+static const uint64_t psPerUs = 1000000ULL;
+
+//Emulator state
+static uint64_t s_now_ps;				//Virtual time (pico-seconds)
+static uint8_t s_pinLevel[80];			//Last value written to each digital pin
+
+static uint32_t s_tcTicks;				//TC0 period (MCK/2 ticks); zero = DMA clock stopped
+static uint64_t s_nextConv_ps;			//Time of the next DACC conversion
+
+static const uint16_t *s_tpr;			//PDC Transmit Pointer Register
+static uint16_t s_tcr;					//PDC Transmit Counter Register
+static const uint16_t *s_tnpr;			//PDC Transmit Next Pointer Register
+static uint16_t s_tncr;					//PDC Transmit Next Counter Register
+static bool s_txten;					//PDC transmitter enabled
+static bool s_wordMode;					//DACC full-word mode: PDC counts words (two half-words)
+static bool s_secondHalf;				//Full-word mode: the next half-word is the upper half of a word
+static bool s_endtx = true;				//ENDTX flag (latched when TCR reaches zero, cleared by loading TCR or TNCR)
+static uint32_t s_imr;					//DACC interrupt mask
+static uint16_t s_dac[2];				//DAC0 (X) and DAC1 (Y) output values
+
+static int s_blankPending;				//Blank timer: edges scheduled (0-2)
+static uint8_t s_blankLevel[2];			//Blank timer: level of each scheduled edge
+static uint64_t s_blankAt_ps[2];		//Blank timer: time of each scheduled edge
+
+static void (*s_refreshIsr)(void);		//Timer3 attached ISR
+static bool s_timerRunning;
+static bool s_timerOnce;				//Timer3 stops after the next interrupt (xyHalRefreshTimerOnce)
+static uint64_t s_timerPeriod_ps;
+static uint64_t s_nextTimer_ps;
+
+static bool s_inIsr;					//Interrupts do not nest in the emulator
+static xyHostSampleFn s_sink;
+static xyHostStats s_stats;
+
+XYhostSerial Serial;
+XYhostTimer Timer3;
+
+extern "C" __attribute__((weak)) void DACC_Handler(void) {
+	//Default DACC_Handler used when the host program does not link one in.
+}
+
+//----------------------------------------------------
+//  Emulator core
+//----------------------------------------------------
+static uint64_t dmaPeriod_ps(void) {
+	return (uint64_t(s_tcTicks) * 2ULL * 1000000000000ULL) / VARIANT_MCK;
+}
+
+static void blankTimerUpdate(void) {
+	//	Apply scheduled blank timer edges once virtual time has reached them.
+	while (s_blankPending > 0 && s_blankAt_ps[0] <= s_now_ps) {
+		s_pinLevel[zAxisPin] = s_blankLevel[0];
+		s_blankLevel[0] = s_blankLevel[1];
+		s_blankAt_ps[0] = s_blankAt_ps[1];
+		s_blankPending--;
+	}
+}
+
+static uint64_t blankTicks(uint16_t count) {
+	return (uint64_t(count) * 63) / 25;		//Same rounding as the DUE backend: one porch count = 2.52 MCK/2 ticks
+}
+
+static void blankSchedule(uint8_t level, uint64_t ticks) {
+	//	Add an edge 'ticks' (MCK/2) from now; edges are scheduled in time order.
+	s_blankLevel[s_blankPending] = level;
+	s_blankAt_ps[s_blankPending] = s_now_ps + (ticks * 2ULL * 1000000000000ULL) / VARIANT_MCK;
+	s_blankPending++;
+	s_stats.blankEdges++;
+}
+
+static bool dmaActive(void) {
+	return s_txten && s_tcr > 0 && s_tcTicks > 0;
+}
+
+static void checkDaccIrq(void) {
+	//	Call DACC_Handler while an enabled interrupt source is pending (level sensitive, like the NVIC).
+	if (s_inIsr)
+		return;
+	for (int n = 0; n < 100 && (xyHalDmaStatus() & s_imr) != 0; n++) {	//Limit: a handler that never clears its source would hang the host
+		s_inIsr = true;
+		s_stats.daccIrqs++;
+		DACC_Handler();
+		s_inIsr = false;
+	}
+}
+
+static void loadNext(void) {
+	//	PDC moves the next pointer/counter into the current registers.
+	s_tpr = s_tnpr;
+	s_tcr = s_tncr;
+	s_tncr = 0;
+	s_stats.blocks++;
+}
+
+static void convertOne(void) {
+	//	The DACC converts the next half-word supplied by the PDC.  In TAG mode bits 12-13 select the channel.
+	uint16_t v = *s_tpr++;
+	if (s_wordMode) {			//One PDC transfer (and count) per word, i.e. every second sample
+		s_secondHalf = !s_secondHalf;
+		if (!s_secondHalf)
+			s_tcr--;
+		else
+			s_stats.dmaTransfers++;
+	} else {
+		s_tcr--;
+		s_stats.dmaTransfers++;
+	}
+	uint8_t ch = (v >> 12) & 0x3;
+	if (ch < 2) {
+		s_dac[ch] = v & 0xfff;
+		s_stats.conversions++;
+		if (ch == 1) {
+			blankTimerUpdate();
+			bool blanked = s_pinLevel[zAxisPin] != LOW;
+			s_stats.points++;
+			if (!blanked)
+				s_stats.litPoints++;
+			if (s_sink)
+				s_sink(s_dac[0], s_dac[1], blanked, s_now_ps / 1000);
+		}
+	}
+	if (s_tcr == 0) {
+		s_endtx = true;
+		if (s_tncr > 0)
+			loadNext();
+	}
+}
+
+static void runUntil(uint64_t end_ps) {
+	//	Step through DMA conversions and timer interrupts, in time order, up to end_ps.
+	for (;;) {
+		bool conv = dmaActive() && s_nextConv_ps <= end_ps;
+		bool tick = s_timerRunning && s_refreshIsr && s_nextTimer_ps <= end_ps;
+		if (conv && tick) {		//Both due: take the earlier one (a conversion wins a tie)
+			if (s_nextTimer_ps < s_nextConv_ps)
+				conv = false;
+			else
+				tick = false;
+		}
+		if (!conv && !tick) {
+			s_now_ps = end_ps;
+			break;
+		}
+		if (conv) {
+			s_now_ps = s_nextConv_ps;
+			convertOne();
+			s_nextConv_ps += dmaPeriod_ps();
+		} else {
+			s_now_ps = s_nextTimer_ps;
+			s_nextTimer_ps += s_timerPeriod_ps;
+			if (s_timerOnce)
+				s_timerRunning = false;		//One-shot; the ISR may arm it again
+			if (!s_inIsr) {
+				s_inIsr = true;
+				s_stats.refreshIrqs++;
+				s_refreshIsr();
+				s_inIsr = false;
+			}
+		}
+		checkDaccIrq();
+	}
+}
+
+void xyHostReset(void) {
+	s_now_ps = 0;
+	memset(s_pinLevel, 0, sizeof(s_pinLevel));
+	s_tcTicks = 0;
+	s_tpr = NULL;
+	s_tcr = 0;
+	s_tncr = 0;
+	s_txten = false;
+	s_wordMode = false;
+	s_secondHalf = false;
+	s_endtx = true;
+	s_imr = 0;
+	s_blankPending = 0;
+	s_refreshIsr = NULL;
+	s_timerRunning = false;
+	s_timerOnce = false;
+	s_inIsr = false;
+	memset(&s_stats, 0, sizeof(s_stats));
+}
+
+void xyHostAdvanceUs(uint64_t us) {
+	runUntil(s_now_ps + us * psPerUs);
+}
+
+void xyHostSetSampleSink(xyHostSampleFn sink) {
+	s_sink = sink;
+}
+
+uint64_t xyHostNowNs(void) {
+	return s_now_ps / 1000;
+}
+
+uint32_t xyHostDmaClockHz(void) {
+	return s_tcTicks ? VARIANT_MCK / 2UL / s_tcTicks : 0;
+}
+
+const xyHostStats& xyHostGetStats(void) {
+	return s_stats;
+}
+
+//----------------------------------------------------
+//  HAL routines (see XYscopeHal.h)
+//----------------------------------------------------
+void xyHalDacSetup(void) {
+	s_tcr = 0;
+	s_tncr = 0;
+	s_txten = false;
+	s_endtx = true;
+	s_imr = 0;
+	s_dac[0] = s_dac[1] = 0;
+	s_wordMode = false;
+	s_secondHalf = false;
+}
+
+void xyHalDacWordMode(bool fullWord) {
+	s_wordMode = fullWord;
+	s_secondHalf = false;
+}
+
+void xyHalTcSetup(uint32_t tcTicks) {
+	s_tcTicks = tcTicks;
+	s_nextConv_ps = s_now_ps + dmaPeriod_ps();
+}
+
+void xyHalDmaStart(const void *list, uint16_t count) {
+	s_tpr = (const uint16_t *) list;
+	s_tcr = count;
+	s_tncr = 0;
+	s_secondHalf = false;
+	s_endtx = (count == 0);
+	s_txten = true;
+	s_nextConv_ps = s_now_ps + dmaPeriod_ps();
+	s_stats.transfers++;
+	s_stats.blocks++;
+}
+
+void xyHalDmaQueueNext(const void *list, uint16_t count) {
+	s_tnpr = (const uint16_t *) list;
+	s_tncr = count;
+	s_endtx = false;
+	if (s_tcr == 0 && s_tncr > 0 && s_txten) {	//PDC was idle: next buffer is taken over right away
+		loadNext();
+		s_nextConv_ps = s_now_ps + dmaPeriod_ps();
+	}
+}
+
+uint32_t xyHalDmaStatus(void) {
+	uint32_t status = 0;
+	if (s_endtx)
+		status |= XYHAL_ENDTX;
+	if (s_tcr == 0 && s_tncr == 0)
+		status |= XYHAL_TXBUFE;
+	return status;
+}
+
+void xyHalDmaIrqEnable(uint32_t flags) {
+	s_imr |= flags;
+	checkDaccIrq();
+}
+
+void xyHalDmaIrqDisable(uint32_t flags) {
+	s_imr &= ~flags;
+}
+
+void xyHalRefreshTimerStart(uint32_t period_us) {
+	Timer3.start(period_us);
+}
+
+void xyHalRefreshTimerStop(void) {
+	Timer3.stop();
+}
+
+void xyHalRefreshTimerOnce(uint32_t delay_us) {
+	uint64_t ticks = (uint64_t(delay_us) * 21) / 32;		//Same rounding as the DUE backend (MCK/128 ticks)
+	s_nextTimer_ps = s_now_ps + (ticks > 2 ? ticks : 2) * 128ULL * 1000000000000ULL / VARIANT_MCK;
+	s_timerOnce = true;
+	s_timerRunning = true;
+}
+
+void xyHalBlankSetup(void) {
+	xyHalBlankNow(true);
+}
+
+void xyHalBlankNow(bool blanked) {
+	s_blankPending = 0;
+	s_pinLevel[zAxisPin] = blanked ? HIGH : LOW;
+}
+
+void xyHalUnblankAfter(uint16_t count) {
+	xyHalBlankNow(true);
+	blankSchedule(LOW, blankTicks(count));
+}
+
+void xyHalBlankAfter(uint16_t count) {
+	s_blankPending = 0;
+	blankSchedule(HIGH, blankTicks(count));
+}
+
+void xyHalBlankPulse(uint16_t after, uint16_t count) {
+	s_blankPending = 0;
+	blankSchedule(HIGH, blankTicks(after) + 1);
+	blankSchedule(LOW, blankTicks(after) + 2 + blankTicks(count));
+}
+
+void xyHalMemoryBarrier(void) {
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void xyHalIdle(void) {
+	//	Foreground code is waiting on an ISR: run the emulation up to the next event.
+	uint64_t next_ps = s_now_ps + 1000 * psPerUs;	//Nothing scheduled: let 1ms go by
+	if (dmaActive() && s_nextConv_ps < next_ps)
+		next_ps = s_nextConv_ps;
+	if (s_timerRunning && s_refreshIsr && s_nextTimer_ps < next_ps)
+		next_ps = s_nextTimer_ps;
+	runUntil(next_ps);
+}
+
+//----------------------------------------------------
+//  Arduino core subset (see XYscopeHost.h)
+//----------------------------------------------------
+unsigned long millis(void) {
+	return s_now_ps / (1000 * psPerUs);
+}
+
+unsigned long micros(void) {
+	return s_now_ps / psPerUs;
+}
+
+void delay(unsigned long ms) {
+	xyHostAdvanceUs(uint64_t(ms) * 1000);
+}
+
+void pinMode(uint8_t, uint8_t) {
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+	if (pin < sizeof(s_pinLevel))
+		s_pinLevel[pin] = val;
+}
+
+int digitalRead(uint8_t pin) {
+	blankTimerUpdate();
+	return pin < sizeof(s_pinLevel) ? s_pinLevel[pin] : LOW;
+}
+
+XYhostTimer& XYhostTimer::attachInterrupt(void (*isr)(void)) {
+	s_refreshIsr = isr;
+	return *this;
+}
+
+XYhostTimer& XYhostTimer::start(long period_us) {
+	s_timerOnce = false;
+	if (period_us > 0)
+		s_timerPeriod_ps = uint64_t(period_us) * psPerUs;
+	if (s_timerPeriod_ps > 0) {
+		s_timerRunning = true;
+		s_nextTimer_ps = s_now_ps + s_timerPeriod_ps;
+	}
+	return *this;
+}
+
+XYhostTimer& XYhostTimer::stop(void) {
+	s_timerRunning = false;
+	return *this;
+}
+
+void XYhostSerial::begin(unsigned long) {
+	_enabled = true;
+}
+
+int XYhostSerial::available(void) {
+	return 0;
+}
+
+int XYhostSerial::read(void) {
+	return -1;
+}
+
+void XYhostSerial::print(const char *s) {
+	if (_enabled)
+		fputs(s, stdout);
+}
+
+void XYhostSerial::print(char c) {
+	if (_enabled)
+		fputc(c, stdout);
+}
+
+void XYhostSerial::print(int n, int base) {
+	print(long(n), base);
+}
+
+void XYhostSerial::print(unsigned int n, int base) {
+	print((unsigned long) n, base);
+}
+
+void XYhostSerial::print(long n, int base) {
+	if (_enabled)
+		printf(base == HEX ? "%lX" : "%ld", n);
+}
+
+void XYhostSerial::print(unsigned long n, int base) {
+	if (_enabled)
+		printf(base == HEX ? "%lX" : "%lu", n);
+}
+
+void XYhostSerial::print(double n, int digits) {
+	if (_enabled)
+		printf("%.*f", digits, n);
+}
+
+void XYhostSerial::println(void) {
+	print("\r\n");
+}
+
+#endif // !ARDUINO
@@ -0,0 +1,273 @@
+/*
+ * XYscopeHalSam3x.cpp
+ *
+ *      Arduino DUE (SAM3X8E) backend of the XYscope Hardware Abstraction Layer.
+ *      See XYscopeHal.h for an overview.
+ */
+
+#if defined(__SAM3X8E__)
+
+#include "Arduino.h"
+#include <DueTimer.h>
+#include "XYscopeHal.h"
+
+void xyHalDacSetup(void) {
+	//	Routine to setup DAC and Interrupt Controller for DMA transformers.
+	//
+	//	Calling parameters:	NONE
+	//
+	//	Returns:	Nothing.
+	//
+	//	20170407 Ver 0.0	E.Andrews	First cut (as XYscope::dacSetup)
+	//
+
+	//----------------------------------------------------
+	//  DAC SETUP
+	//----------------------------------------------------
+	pmc_enable_periph_clk (DACC_INTERFACE_ID); 	// start clocking DAC
+
+	dacc_reset (DACC);		//This returns DAC hardware to power-up conditions
+
+	dacc_set_transfer_mode(DACC, 0);//for this variable, 0=HALFWORD_MODE (16 bits integers) or 1=FULLWORD_MODE (32 bit integers)
+	dacc_set_power_save(DACC, 0, 0);	//Setup of DAC Power_Save option
+	// Set DACC Analog Current Register - Use typical recommended values of 0x01 for IBCTLDACCORE and 0x02 for IBCTLCH0/IBCTLCH1
+	// This may sets the slew rate of DACC register & IBCTLDACCH0/IBCTLDACCH1:
+	dacc_set_analog_control(DACC,
+			DACC_ACR_IBCTLCH0(0x02) | DACC_ACR_IBCTLCH1(0x02)
+					| DACC_ACR_IBCTLDACCORE(0x01));
+	dacc_set_trigger(DACC, 1);
+
+	dacc_enable_channel(DACC, 0);	//Enable DAC0
+	dacc_enable_channel(DACC, 1);	//Enable DAC1
+
+	// DACC_MR bit definitions
+	//
+	//	|	31	|	30	|	29	|	28	|	27	|	26	|	25	|	24	|
+	//	+-------+-------+-------+-------+-------+-------+-------+-------+	STARTUP TIME: Time till initial startup conversion
+	//	|		|		|<-------------- STARTUP TIME ----------------->|	0=0 periods of DACC CLOCK, 63=4032 periods of DACC CLOCK
+	//	+-------+-------+-------+-------+-------+-------+-------+-------+	Typical value = 3 to 8. (See table on pg 1366 of HW Data Sheet for more details)
+	//
+	//	|	23	|	22	|	21	|	20	|	19	|	18	|	17	|	16	|
+	//	+-------+-------+-------+-------+-------+-------+-------+-------+	MAXS: Startup after wake up; 0=Normal (No Sleep), 1=Fast Wake up Sleep Mode
+	//	|		|		| MAXS	|  TAG	|		|		|<--USER  SEL-->|	TAG: 0=DIS (Tag Selection Mode Disabled, using USER_SEL value to chan conversion
+	//	+-------+-------+-------+-------+-------+-------+-------+-------+	USER_SEL: 0=Chan 0 Selected, 1=Chan 1 Selected (Only meaningful when TAG=1)
+	//
+	//	|	15	|	14	|	13	|	12	|	11	|	10	|	 9	|	 8	|
+	//	+-------+-------+-------+-------+-------+-------+-------+-------+	DAC AUTO REFRESH PERIOD
+	//	|<----------------------   REFRESH   -------------------------->| 	0: No DAC Refresh, >0: DAC Refresh Period = 1024 * REFRESH_VALUE/DACC_CLOCK
+	//	+-------+-------+-------+-------+-------+-------+-------+-------+
+	//
+	//	|	7	|	6	|	5	|	4	|	3	|	2	|	 1	|	 0	|
+	//	+-------+-------+-------+-------+-------+-------+-------+-------+	FAST WKUP: 0=Sleep Mode defined by SLEEP bit, 1=Fast Wak up Sleep Mode (Vref ON Between Conversions but DAC core is OFF)
+	//	|		|FSTWKUP| SLEEP	|WRD MOD|<----- TRIG SEL ------>| TRGEN	|	SLEEP: 0=Normal (No Sleep), 1=Sleep Mode (Sleeps between conversions)
+	//	+-------+-------+-------+-------+-------+-------+-------+-------+	WORD/HALF-WORD MODE: 0=Half Word Mode (16 Bit), 1=Full Word Mode (32 Bit)
+	//																		TRIG SEL: 0=Ext, 1=TC0_CH0, 2=TC0_CH1, 3=TC0_CH2,4=PWM Event_0,5=PWM Event_1,6=RESRVD,7=RESERVD
+	//																		TRGEN (Trig Enable): 0=Disabled, DACC in Free Run Mode, 1=Ext Trig mode.
+	//
+	//
+
+	//	DACC_MR REGISTER SETTINGS...
+	//		STARTUP TIME
+	DACC->DACC_MR |= 8 << 24;		//8=512 DACC clock periods of startup time.
+	//		MAXS Mode bit
+	DACC->DACC_MR |= 0 << 16;		//No Bits Set, MAXS=0 meaning NO SLEEP
+	//		TAG MODE Bit
+	DACC->DACC_MR |= 1 << 20;//TAG=1 (Bits 12,13 of incomming data selects DAC0/DAC1 destination )
+	//		DAC REFRESH
+	DACC->DACC_MR |= 0 << 8;//No Bits Set.  REFRESH=0, meaning NO AUTO REFRESH DESIRED
+	//		FSTWKUP, SLEEP,WRD MODE, TRIG SEL, TRig ENABLE
+	DACC->DACC_MR |= 0;	//No Bits Set.  HALF_WORD MODE, EXT-TRIG, TRIG DISABLED
+
+	//----------------------------------------------------
+	//  Interrupt Controller SETUP
+	//----------------------------------------------------
+
+	NVIC_DisableIRQ (DACC_IRQn);//Disable DACC IRQ in the Nested Vectored Interrupt Controller (NVIC)
+	NVIC_ClearPendingIRQ(DACC_IRQn);//Clear any pending DACC IRQ in the Nested Vectored Interrupt Controller (NVIC)
+	NVIC_EnableIRQ(DACC_IRQn);//Now, ENABLE DACC IRQ in the Nested Vectored Interrupt Controller (NVIC)
+}
+
+void xyHalTcSetup(uint32_t tcTicks) {
+	//	Routine to setup Timer Counter 0.  TC0 is used to clock DMA transformers.
+	//
+	//	Calling parameters:
+	//
+	//	tcTicks		Period of the DMA clock in TIMER_CLOCK1 (MCK/2) ticks.
+	//
+	//	Returns:	Nothing.
+	//
+	//	20170405 Ver 0.0	E.Andrews	First cut (as part of XYscope::tcSetup)
+	//
+
+	// Send TC0 Clock signal to external pin so AGS hardware can se it to sync things up
+	int ulPin = 2; // just an example:   it's 2  for the Timer0 TIOAO
+	PIO_Configure(g_APinDescription[ulPin].pPort,
+			g_APinDescription[ulPin].ulPinType,
+			g_APinDescription[ulPin].ulPin,
+			g_APinDescription[ulPin].ulPinConfiguration);
+
+	// Enable TC0
+	pmc_enable_periph_clk (TC_INTERFACE_ID);
+
+	//Set Mode and Frequency of TC0
+	Tc * tc = TC0;
+	TcChannel * t = &tc->TC_CHANNEL[0];
+	t->TC_CCR = TC_CCR_CLKDIS;
+	t->TC_IDR = 0xFFFFFFFF;
+	t->TC_SR;
+	t->TC_RC = tcTicks;    		// Sets PERIOD of timer in "tcTicks" units
+	t->TC_RA = (tcTicks - tcTicks / 2);	// Use this value to alter clock signal symmetry...(tcTicks/2 = 50%)
+
+	//TC_CMR = Timer Counter Channel Mode Register, a four byte register used to set WAVEFORM MODE
+	//	Note: Since the DUE MCK = 84 MHz, the following master clock source settings are available
+	// 		TC-CMR_TCCLOCKS_TIMER_CLOCK1 sets the clock source to be =  MCK/2  (48.0   MHz)
+	// 		TC-CMR_TCCLOCKS_TIMER_CLOCK2 sets the clock source to be =  MCK/8  (10.5   MHz)
+	// 		TC-CMR_TCCLOCKS_TIMER_CLOCK3 sets the clock source to be =  MCK/32 ( 2.652 MHz)
+	// 		TC-CMR_TCCLOCKS_TIMER_CLOCK3 sets the clock source to be =  MCK/128( 0.65625 MHz or 656.25 KHz)
+	t->TC_CMR = TC_CMR_TCCLKS_TIMER_CLOCK1 | TC_CMR_WAVE
+			| TC_CMR_WAVSEL_UP_RC;
+	t->TC_CMR = (t->TC_CMR & 0xFFF0FFFF) | TC_CMR_ACPA_CLEAR
+			| TC_CMR_ACPC_SET;
+	t->TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
+}
+
+void xyHalDacWordMode(bool fullWord) {
+	//	Select the DACC transfer mode (DACC_MR WORD bit).  In full-word mode each 32 bit PDC transfer carries
+	//	two TAG mode samples: bits 0-15 are converted first, then bits 16-31.  A pointList entry (X then Y,
+	//	little endian) is exactly one such word, so the PDC needs half as many bus transfers per point.
+	//	Each TC0 trigger still converts ONE sample, so the point rate does not change.
+	//	Only change the mode while the PDC is idle.
+	//
+	//	20261017 Ver 0.0				First cut
+	//
+	dacc_set_transfer_mode(DACC, fullWord ? 1 : 0);	//0=HALFWORD_MODE, 1=FULLWORD_MODE
+}
+
+void xyHalDmaStart(const void *list, uint16_t count) {
+	//	Start a PDC transfer of 'count' half-words from 'list' into the DACC.
+	//
+	//	20170418 Ver 0.0	E.Andrews	First cut (as part of XYscope::initiateDacDma)
+	//
+	DACC->DACC_TPR = (uint32_t) list;	//(DACC_TPR) = Transmit (source data) Pointer Register
+	DACC->DACC_TCR = count;				//(DACC_TCR)= Transmit Count Register (TCR=How many Short-Integers to transfer).
+	DACC->DACC_TNCR = 0;				//(DACC_TNCR)= Transmit NEXT Counter Register is NOT USED; set to zero!
+
+	//This is how we START a transfer! (This will acttually start the DMA transfer
+	DACC->DACC_PTCR = DACC_PTCR_TXTEN;	//(DACC_PTCR) = Receiver Transfer Enable Register
+}
+
+void xyHalDmaQueueNext(const void *list, uint16_t count) {
+	//	Load the PDC "next" buffer.  When DACC_TCR reaches zero the PDC copies TNPR/TNCR into TPR/TCR
+	//	and keeps going without a gap.  Writing TNCR also clears ENDTX.
+	//
+	//	20261017 Ver 0.0				First cut
+	//
+	DACC->DACC_TNPR = (uint32_t) list;	//(DACC_TNPR) = Transmit Next Pointer Register
+	DACC->DACC_TNCR = count;			//(DACC_TNCR) = Transmit Next Counter Register
+}
+
+uint32_t xyHalDmaStatus(void) {
+	return dacc_get_interrupt_status(DACC);
+}
+
+void xyHalDmaIrqEnable(uint32_t flags) {
+	dacc_enable_interrupt(DACC, flags);
+}
+
+void xyHalDmaIrqDisable(uint32_t flags) {
+	dacc_disable_interrupt(DACC, flags);
+}
+
+void xyHalRefreshTimerStart(uint32_t period_us) {
+	Timer3.start(period_us);
+}
+
+void xyHalRefreshTimerStop(void) {
+	Timer3.stop();
+}
+
+void xyHalRefreshTimerOnce(uint32_t delay_us) {
+	//	One-shot of the Timer3 channel (TC1 channel 0), written straight to the registers: DueTimer::start()
+	//	picks a clock with floating point math, which is too slow to call from the DACC ISR every frame.
+	//	DueTimer's TC3_Handler still calls the ISR attached with Timer3.attachInterrupt().
+	//
+	//	20261017 Ver 0.0				First cut
+	//
+	TcChannel * t = &TC1->TC_CHANNEL[0];
+	uint32_t ticks = (uint64_t(delay_us) * 21) / 32;		//TIMER_CLOCK4 = MCK/128 = 656.25 kHz
+	t->TC_CCR = TC_CCR_CLKDIS;
+	t->TC_CMR = TC_CMR_TCCLKS_TIMER_CLOCK4 | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC | TC_CMR_CPCSTOP;
+	t->TC_RC = ticks > 2 ? ticks : 2;
+	t->TC_SR;
+	t->TC_IER = TC_IER_CPCS;
+	t->TC_IDR = ~TC_IER_CPCS;
+	NVIC_ClearPendingIRQ(TC3_IRQn);
+	NVIC_EnableIRQ(TC3_IRQn);
+	t->TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
+}
+
+//----------------------------------------------------
+//  BLANK TIMER
+//----------------------------------------------------
+//	The CRT blanking pin (DUE pin 3 = PC28) is also TIOA7, the A output of Timer Counter TC2 channel 1.
+//	That channel runs one-shot (stops at RC compare) from TIMER_CLOCK1 (MCK/2 = 42 MHz), and the porch
+//	edges are made by the TC output logic: a software trigger sets the level "now", the RC compare makes
+//	the delayed edge.  The ISRs only write three registers; nothing waits.
+//	NOTE: TC2 channel 1 is DueTimer's Timer7, which must not be used alongside XYscope.
+
+static TcChannel * const blankTc = &TC2->TC_CHANNEL[1];
+static const uint32_t blankCmr = TC_CMR_TCCLKS_TIMER_CLOCK1 | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC | TC_CMR_CPCSTOP;
+
+static inline uint32_t blankTicks(uint16_t count) {
+	return (uint32_t(count) * 63) / 25;		//One porch count (~60ns) = 2.52 MCK/2 ticks
+}
+
+void xyHalBlankSetup(void) {
+	//	Routine to setup the blank timer and switch the blanking pin over to it (TIOA7, peripheral B).
+	//	The CRT is left BLANKED.
+	//
+	//	20261017 Ver 0.0				First cut
+	//
+	pmc_enable_periph_clk(ID_TC7);
+	blankTc->TC_CCR = TC_CCR_CLKDIS;
+	blankTc->TC_IDR = 0xFFFFFFFF;
+	blankTc->TC_SR;
+	blankTc->TC_RC = 0;
+	blankTc->TC_CMR = blankCmr | TC_CMR_ASWTRG_SET;		//TIOA7 HIGH = BLANKED
+	blankTc->TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
+	PIO_Configure(PIOC, PIO_PERIPH_B, PIO_PC28B_TIOA7, PIO_DEFAULT);
+}
+
+void xyHalBlankNow(bool blanked) {
+	blankTc->TC_CMR = blankCmr | (blanked ? TC_CMR_ASWTRG_SET : TC_CMR_ASWTRG_CLEAR);	//No RC action: cancels a pending edge
+	blankTc->TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
+}
+
+void xyHalUnblankAfter(uint16_t count) {
+	blankTc->TC_RC = blankTicks(count);
+	blankTc->TC_CMR = blankCmr | TC_CMR_ASWTRG_SET | TC_CMR_ACPC_CLEAR;	//Blank on the trigger, unblank at RC
+	blankTc->TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
+}
+
+void xyHalBlankAfter(uint16_t count) {
+	blankTc->TC_RC = blankTicks(count);
+	blankTc->TC_CMR = blankCmr | TC_CMR_ACPC_SET;		//Level unchanged until RC, then blank
+	blankTc->TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
+}
+
+void xyHalBlankPulse(uint16_t after, uint16_t count) {
+	blankTc->TC_RA = blankTicks(after) + 1;
+	blankTc->TC_RC = blankTicks(after) + 2 + blankTicks(count);
+	blankTc->TC_CMR = blankCmr | TC_CMR_ACPA_SET | TC_CMR_ACPC_CLEAR;	//Blank at RA, unblank at RC
+	blankTc->TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
+}
+
+void xyHalMemoryBarrier(void) {
+	__DMB();
+}
+
+void xyHalIdle(void) {
+	//Nothing to do; the ISRs run on their own.
+}
+
+#endif // __SAM3X8E__
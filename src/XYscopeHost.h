@@ -0,0 +1,127 @@
+/*
+ * XYscopeHost.h
+ *
+ *      Host (Linux) build support for the XYscope library.
+ *
+ *      When XYscope.h is compiled outside of the Arduino IDE (ARDUINO not defined), this file
+ *      stands in for "Arduino.h" and <DueTimer.h>.  It provides the small part of the Arduino core
+ *      that the library uses (millis, digitalWrite, Serial, Timer3, ...) and the API of the
+ *      DACC/PDC/TC0/Timer3 emulator found in XYscopeHalHost.cpp.
+ *
+ *      The emulator runs in VIRTUAL time.  Nothing happens until the host program advances the
+ *      clock with xyHostAdvanceUs() (delay() does the same).  While time advances:
+ *        - Timer3 fires its attached ISR (normally paintCrt_ISR -> XYscope.initiateDacDma) every period.
+ *        - The PDC feeds one half-word of the active transfer into the DACC each DMA clock period
+ *          (the period TC0 was programmed for, i.e. DmaClkFreq_Hz).
+ *        - TAG mode routing is applied: bits 12-13 of each half-word select DAC0 (X_flag) or DAC1 (Y_flag).
+ *        - ENDTX/TXBUFE are raised when the PDC counters run out and DACC_Handler() is called while
+ *          the matching interrupt source is enabled, exactly as the DUE NVIC would.
+ *        - The blanking pin (XYscope::crtBlankingPin) changes when the blank timer edges fall due, so the
+ *          front porch (beam still blanked) is seen at the start of each refresh.
+ *
+ *      A minimal host program looks just like a sketch:
+ *
+ *		#include "XYscope.h"
+ *		XYscope XYscope;
+ *		void DACC_Handler(void) { XYscope.dacHandler(); }
+ *		void paintCrt_ISR(void) { XYscope.initiateDacDma(); }
+ *		int main() {
+ *			XYscope.begin(800000);
+ *			Timer3.attachInterrupt(paintCrt_ISR);
+ *			XYscope.plotCircle(2047, 2047, 1000);
+ *			xyHostSetSampleSink(mySink);	//Optional: receive every (X,Y,Z) sample the DACs produce
+ *			xyHostAdvanceUs(100000);		//Run 100ms of display refresh
+ *		}
+ *
+ *      Build with any C++11 compiler, for example:
+ *		g++ -std=gnu++11 -Isrc src/XYscope.cpp src/XYscopeHalHost.cpp myHostTest.cpp
+ */
+
+#ifndef XYSCOPEHOST_H_
+#define XYSCOPEHOST_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//----------------------------------------------------
+//  Arduino core subset
+//----------------------------------------------------
+typedef bool boolean;
+
+#define PROGMEM
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define DEC 10
+#define HEX 16
+#define PI 3.1415926535897932384626433832795
+
+#define VARIANT_MCK 84000000UL	//DUE master clock; used to convert TC0 ticks back into a DMA clock rate
+
+unsigned long millis(void);		//Virtual time (ms) since start of emulation
+unsigned long micros(void);		//Virtual time (us) since start of emulation
+void delay(unsigned long ms);	//Advances virtual time (and therefore runs the display emulation)
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+class XYhostSerial {
+	//Serial port stand-in.  Output goes to stdout once begin() has been called, otherwise it is discarded.
+  public:
+	void begin(unsigned long baud);
+	int available(void);
+	int read(void);
+	void print(const char *s);
+	void print(char c);
+	void print(int n, int base=DEC);
+	void print(unsigned int n, int base=DEC);
+	void print(long n, int base=DEC);
+	void print(unsigned long n, int base=DEC);
+	void print(double n, int digits=2);
+	void println(void);
+	template <typename T> void println(T v) { print(v); println(); }
+	template <typename T> void println(T v, int fmt) { print(v, fmt); println(); }
+  private:
+	bool _enabled=false;
+};
+extern XYhostSerial Serial;
+
+class XYhostTimer {
+	//Timer3 (DueTimer) stand-in.  Fires the attached ISR every period in virtual time.
+  public:
+	XYhostTimer& attachInterrupt(void (*isr)(void));
+	XYhostTimer& start(long period_us=-1);
+	XYhostTimer& stop(void);
+};
+extern XYhostTimer Timer3;
+
+extern "C" void DACC_Handler(void);	//Supplied by the host program exactly as in a DUE sketch (a do-nothing default is provided)
+
+//----------------------------------------------------
+//  DACC/PDC/TC0/Timer3 emulator
+//----------------------------------------------------
+typedef void (*xyHostSampleFn)(uint16_t x, uint16_t y, bool blanked, uint64_t time_ns);
+
+struct xyHostStats {
+	uint64_t conversions;	//Half-words converted by the DACC (DAC0 + DAC1)
+	uint64_t dmaTransfers;	//PDC bus transfers (half-words, or words in full-word mode)
+	uint64_t points;		//DAC1 (Y) conversions, i.e. completed X/Y points
+	uint64_t litPoints;		//Points converted while the CRT was unblanked
+	uint32_t transfers;		//PDC transfers started
+	uint32_t blocks;		//PDC buffers consumed (current registers loaded by software or from the next registers)
+	uint32_t refreshIrqs;	//Timer3 interrupts
+	uint32_t daccIrqs;		//DACC interrupts (calls to DACC_Handler)
+	uint32_t blankEdges;	//Delayed blanking pin edges scheduled on the blank timer (porches)
+};
+
+void xyHostReset(void);							//Return emulator (time, registers, timer, stats) to power-up state
+void xyHostAdvanceUs(uint64_t us);				//Run the emulation for 'us' microseconds of virtual time
+void xyHostSetSampleSink(xyHostSampleFn sink);	//Receive each X/Y point as DAC1 is updated (NULL = none)
+uint64_t xyHostNowNs(void);						//Current virtual time (ns)
+uint32_t xyHostDmaClockHz(void);				//DMA clock rate TC0 is currently programmed for
+const xyHostStats& xyHostGetStats(void);		//Statistics gathered since last xyHostReset()
+
+#endif /* XYSCOPEHOST_H_ */
@@ -0,0 +1,43 @@
+/*
+ * hostTest.h
+ *
+ *      Small helpers shared by the host (Linux) regression tests in this directory.
+ *
+ *      Every test is a separate program: the DACC/PDC/timer emulator of XYscopeHalHost.cpp keeps its state
+ *      in globals, exactly like the one set of peripherals on a DUE.  A test declares its XYscope object and
+ *      the DACC_Handler()/paintCrt_ISR() pair just like a sketch, checks results with CHECK(), and returns
+ *      hostTestEnd() from main().  See Makefile for how the tests are built and run.
+ */
+
+#ifndef HOSTTEST_H_
+#define HOSTTEST_H_
+
+#include <stdio.h>
+#include <unistd.h>
+
+static int hostTestChecks, hostTestFailures;
+
+//Report (but do not stop on) a failed check
+#define CHECK(cond) \
+	do { \
+		hostTestChecks++; \
+		if (!(cond)) { \
+			hostTestFailures++; \
+			printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+		} \
+	} while (0)
+
+static inline void hostTestBegin(void) {
+	//	Unbuffered output (so a hang shows how far the test got) and a watchdog: a test that waits forever
+	//	on the ISRs (waitForFrame, plotStart...) is killed instead of stalling the whole run.
+	setvbuf(stdout, NULL, _IONBF, 0);
+	alarm(60);
+}
+
+static inline int hostTestEnd(const char *name) {
+	//	Returns the exit status of the test program: 0 = all checks passed
+	printf("%s: %d checks, %d failed\n", name, hostTestChecks, hostTestFailures);
+	return hostTestFailures != 0;
+}
+
+#endif /* HOSTTEST_H_ */
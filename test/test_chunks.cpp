@@ -0,0 +1,60 @@
+/*
+ * test_chunks.cpp
+ *
+ *      Scatter-gather list (addListChunk): a list too long for XY_List continues into extra RAM chunks and
+ *      is painted whole in one chained DMA transfer; clearListChunks() cuts it back to XY_List.
+ */
+
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscopeSized<1000> XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static uint32_t samples;
+
+static void sink(uint16_t, uint16_t, bool, uint64_t) {
+	samples++;
+}
+
+static uint32_t oneFrame(void) {
+	//	Samples in one complete frame
+	XYscope.waitForFrame(1);
+	samples = 0;
+	XYscope.waitForFrame(1);
+	return samples;
+}
+
+XYscope::pointList chunk1[700], chunk2[500];
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	xyHostSetSampleSink(sink);
+
+	//List continues into two chunks
+	CHECK(XYscope.addListChunk(chunk1, 700));
+	CHECK(XYscope.addListChunk(chunk2, 500));
+	XYscope.plotStart();
+	for (int i = 0; i < 6; i++)
+		XYscope.plotCircle(2047, 2047, 300 + i * 100);
+	int points = XYscope.XYlistEnd;
+	CHECK(points > 1000 + 700 && points <= 1000 + 700 + 500);
+	CHECK(!XYscope.getListFull());
+	XYscope.autoSetRefreshTime();
+	CHECK(oneFrame() == uint32_t(points));
+
+	//Dropping the chunks cuts the list back to XY_List
+	XYscope.clearListChunks();
+	CHECK(XYscope.XYlistEnd <= 1000);
+	CHECK(oneFrame() == uint32_t(XYscope.XYlistEnd));
+	return hostTestEnd("test_chunks");
+}
@@ -0,0 +1,110 @@
+/*
+ * test_const.cpp
+ *
+ *      Compile-time tables (XYscopeConst.h): the line, rectangle, circle and join templates build with
+ *      -std=gnu++11, tables have the sizes the generators promise, and their points are within a DAC step
+ *      of what the run-time plot routines put in the list.
+ */
+
+#include <math.h>
+#include "XYscope.h"
+#include "XYscopeConst.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+//Tables built while compiling
+constexpr auto side = XYconst::line<100, 200, 3000, 200>();
+constexpr auto frame = XYconst::rectangle<100, 200, 3000, 2500>();
+constexpr auto ring = XYconst::circle<2047, 2047, 955, 9>();
+constexpr auto dial = XYconst::join(XYconst::circle<2047, 2047, 1500>(), XYconst::line<2047, 600, 2047, 900>());
+
+//One point every 11 steps plus the exact end point; a rectangle is its four sides; 2*pi*955/10 = 600.04
+static_assert(side.points == 2900 / 11 + 2, "line table size");
+static_assert(frame.points == 2 * (2900 / 11 + 2) + 2 * (2300 / 11 + 2), "rectangle table size");
+static_assert(ring.points == 600, "circle table size");
+static_assert(dial.points == XYconst::circle<2047, 2047, 1500>().points + 300 / 11 + 2, "join table size");
+static_assert(sizeof(frame) == frame.points * sizeof(XYscope::pointList), "tables are bare point arrays");
+static_assert(frame.pts[0].X == (100 | XYscope::X_flag) && frame.pts[0].Y == (200 | XYscope::Y_flag),
+		"DAC routing flags applied at compile time");
+
+static int coord(short v) {
+	return v & 0xfff;
+}
+
+static bool near(const XYscope::pointList &a, const XYscope::pointList &b) {
+	//	Same point within one DAC step in X and in Y
+	return abs(coord(a.X) - coord(b.X)) <= 1 && abs(coord(a.Y) - coord(b.Y)) <= 1;
+}
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+
+	//Rectangle, side by side: plotRectangle() stops short of each corner, the table ends every side on it
+	static const int corner[5][2] = { { 100, 200 }, { 3000, 200 }, { 3000, 2500 }, { 100, 2500 }, { 100, 200 } };
+	XYscope.plotStart();
+	int start = XYscope.XYlistEnd;
+	XYscope.plotRectangle(100, 200, 3000, 2500);
+	int runPoints = XYscope.XYlistEnd - start;
+	int runAt = start, tableAt = 0;
+	bool sidesNear = true, cornersExact = true;
+	for (int s = 0; s < 4; s++) {
+		int runSide = XYscope.XYlistEnd;
+		XYscope.plotLine(corner[s][0], corner[s][1], corner[s + 1][0], corner[s + 1][1]);
+		int n = XYscope.XYlistEnd - runSide;
+		XYscope.XYlistEnd = runSide;
+		for (int i = 0; i < n; i++)
+			if (!near(XYscope.XY_List[runAt + i], frame.pts[tableAt + i]))
+				sidesNear = false;
+		const XYscope::pointList &end = frame.pts[tableAt + n];		//One more point per side in the table
+		if (coord(end.X) != corner[s + 1][0] || coord(end.Y) != corner[s + 1][1])
+			cornersExact = false;
+		runAt += n;
+		tableAt += n + 1;
+	}
+	CHECK(runAt - start == runPoints);
+	CHECK(tableAt == frame.points && frame.points == runPoints + 4);
+	CHECK(sidesNear);
+	CHECK(cornersExact);
+
+	//Circle: plotCircle(..., arcSegment) at the same dot spacing starts at the same point, runs the same
+	//way and has the same points, plus one that closes the circle
+	XYscope.plotStart();
+	start = XYscope.XYlistEnd;
+	XYscope.plotCircle(2047, 2047, 955, 0xff);
+	runPoints = XYscope.XYlistEnd - start;
+	CHECK(runPoints == ring.points + 1);
+	bool circleNear = true;
+	for (int i = 0; i < ring.points; i++)
+		if (!near(XYscope.XY_List[start + i], ring.pts[i]))
+			circleNear = false;
+	CHECK(circleNear);
+	CHECK(coord(ring.pts[0].X) == 2047 - 955 && coord(ring.pts[0].Y) == 2047);
+	double worst = 0;
+	for (int i = 0; i < ring.points; i++) {
+		double error = fabs(hypot(coord(ring.pts[i].X) - 2047, coord(ring.pts[i].Y) - 2047) - 955);
+		if (error > worst)
+			worst = error;
+	}
+	CHECK(worst <= 1);
+
+	//A table is painted like the list it stands for
+	XYscope.plotStart();
+	XYscope.plotPoints(dial.pts, dial.points);
+	CHECK(XYscope.XYlistEnd == start + dial.points);
+	CHECK(XYscope.addStaticList(frame.pts, frame.points) >= 0);
+	uint64_t t0 = xyHostGetStats().points;
+	XYscope.waitForFrame(2);
+	CHECK(xyHostGetStats().points > t0);
+	return hostTestEnd("test_const");
+}
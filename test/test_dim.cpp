@@ -0,0 +1,73 @@
+/*
+ * test_dim.cpp
+ *
+ *      Temporal dimming (objectSetDim): a pool object at divisor n is painted on every n'th refresh only,
+ *      exactly, and keeps its divisor when it moves in the pool.
+ */
+
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static uint32_t lit;
+
+static void sink(uint16_t, uint16_t y, bool blanked, uint64_t) {
+	if (blanked || y == 0)		//y = 0: plotStart() sync pulse
+		return;
+	lit++;
+}
+
+static XYscope::pointList pool[4000];
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	XYscope.plotStart();
+	XYscope.setRefreshPeriodUs(20000);
+	XYscope.setObjectPool(pool, 4000);
+	xyHostSetSampleSink(sink);
+
+	//Objects at divisors 1, 2 and 3 are painted in 1, 1/2 and 1/3 of the frames
+	int dim[3];
+	for (int i = 0; i < 3; i++) {
+		dim[i] = XYscope.objectNew(1000);
+		XYscope.objectBegin(dim[i]);
+		XYscope.plotRectangle(100 + i * 300, 100, 3900 - i * 300, 3900);
+		XYscope.objectEnd();
+		CHECK(XYscope.getObjectDim(dim[i]) == 1);
+		XYscope.objectSetDim(dim[i], i + 1);
+		CHECK(XYscope.getObjectDim(dim[i]) == i + 1);
+	}
+	CHECK(XYscope.getObjectDim(-1) == -1);
+	XYscope.waitForFrame(1);
+	lit = 0;
+	XYscope.waitForFrame(12);
+	uint32_t expected = 12 * XYscope.getObjectPoints(dim[0]) + 6 * XYscope.getObjectPoints(dim[1])
+			+ 4 * XYscope.getObjectPoints(dim[2]);
+	CHECK(lit == expected);
+
+	//Kept when the object moves; divisor 0 means every refresh
+	XYscope.objectResize(dim[1], 2500);
+	CHECK(XYscope.getObjectDim(dim[1]) == 2);
+	XYscope.objectSetDim(dim[2], 0);
+	CHECK(XYscope.getObjectDim(dim[2]) == 1);
+	XYscope.waitForFrame(1);
+	lit = 0;
+	XYscope.waitForFrame(12);
+	expected = 12 * XYscope.getObjectPoints(dim[0]) + 6 * XYscope.getObjectPoints(dim[1])
+			+ 12 * XYscope.getObjectPoints(dim[2]);
+	CHECK(lit == expected);
+
+	XYscope.setObjectPool(NULL, 0);
+	return hostTestEnd("test_dim");
+}
@@ -0,0 +1,77 @@
+/*
+ * test_double_buffer.cpp
+ *
+ *      Double buffered list (setDoubleBuffer/present): every painted frame is one complete presented scene,
+ *      whatever the rate scenes are presented at.
+ */
+
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+//Each scene is one circle; a frame that mixes two scenes shows more than one radius
+static int minR, maxR;
+static uint32_t framePoints, mixedFrames, frames;
+
+static void sink(uint16_t x, uint16_t y, bool blanked, uint64_t) {
+	if (blanked || y == 0)		//y = 0: plotStart() sync pulse
+		return;
+	int dx = x - 2047, dy = y - 2047;
+	int r = int(sqrt(double(dx * dx + dy * dy)) + .5);
+	if (r < minR)
+		minR = r;
+	if (r > maxR)
+		maxR = r;
+	framePoints++;
+}
+
+static void frameDone(uint32_t) {
+	if (framePoints > 0 && maxR - minR > 8)
+		mixedFrames++;
+	frames++;
+	minR = 9999;
+	maxR = 0;
+	framePoints = 0;
+}
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	XYscope.setDoubleBuffer(true);
+	CHECK(XYscope.getDoubleBuffer());
+	XYscope.plotStart();
+	XYscope.plotCircle(2047, 2047, 200);
+	XYscope.present();
+	XYscope.waitForFrame(2);
+
+	//Scenes presented at a rate unrelated to the refresh period are never painted half and half
+	xyHostSetSampleSink(sink);
+	XYscope.setFrameCallback(frameDone);
+	frameDone(0);
+	frames = 0;
+	for (int i = 0; i < 50; i++) {
+		XYscope.plotStart();
+		XYscope.plotCircle(2047, 2047, 200 + i * 10);
+		XYscope.plotEnd();
+		XYscope.present();
+		xyHostAdvanceUs(7000);
+	}
+	CHECK(frames > 10);
+	CHECK(mixedFrames == 0);
+	xyHostSetSampleSink(NULL);
+	XYscope.setFrameCallback(NULL);
+
+	XYscope.setDoubleBuffer(false);
+	CHECK(!XYscope.getDoubleBuffer());
+	return hostTestEnd("test_double_buffer");
+}
@@ -0,0 +1,113 @@
+/*
+ * test_edit.cpp
+ *
+ *      Live list edits (beginEdit/commitEdit): a list rewritten in place slowly enough for refreshes to fall
+ *      inside the edit is never painted half edited, whatever point of the refresh cycle the edit starts at.
+ *      The refreshes that fall inside are skipped and counted.
+ */
+
+#include <math.h>
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+//Each version of the list is one circle; a frame that mixes two versions shows more than one radius
+static int minR, maxR;
+static uint32_t framePoints, mixedFrames, frames;
+
+static void sink(uint16_t x, uint16_t y, bool blanked, uint64_t) {
+	if (blanked || y == 0)		//y = 0: plotStart() sync pulse
+		return;
+	int dx = x - 2047, dy = y - 2047;
+	int r = int(sqrt(double(dx * dx + dy * dy)) + .5);
+	if (r < minR)
+		minR = r;
+	if (r > maxR)
+		maxR = r;
+	framePoints++;
+}
+
+static void frameDone(uint32_t) {
+	if (framePoints > 0 && maxR - minR > 8)
+		mixedFrames++;
+	frames++;
+	minR = 9999;
+	maxR = 0;
+	framePoints = 0;
+}
+
+static const int Points = 720;
+static int listStart;
+
+static void slowRewrite(int r) {
+	//	Rewrite the circle in place, point by point, taking about 11ms (refreshes run meanwhile).  The list
+	//	keeps its length throughout, so a refresh in the middle paints part old and part new circle.
+	for (int i = 0; i < Points; i++) {
+		double a = i * 2 * M_PI / Points;
+		XYscope.XYlistEnd = listStart + i;
+		XYscope.plotPoint(2047 + int(r * cos(a)), 2047 + int(r * sin(a)));
+		XYscope.XYlistEnd = listStart + Points;
+		if ((i & 63) == 63)
+			xyHostAdvanceUs(1000);
+	}
+}
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	XYscope.plotStart();
+	listStart = XYscope.XYlistEnd;
+	slowRewrite(500);
+	XYscope.setRefreshPeriodUs(20000);
+	XYscope.waitForFrame(2);
+	xyHostSetSampleSink(sink);
+	XYscope.setFrameCallback(frameDone);
+
+	//Unprotected: the same edits do tear (so the check below can see torn frames)
+	frameDone(0);
+	mixedFrames = 0;
+	for (int i = 0; i < 20; i++) {
+		xyHostAdvanceUs(i * 700);
+		slowRewrite(500 + (i & 1) * 400);
+	}
+	CHECK(mixedFrames > 0);
+
+	//Inside an edit window: never
+	XYscope.waitForFrame(1);
+	frameDone(0);
+	mixedFrames = frames = 0;
+	uint32_t deferred0 = XYscope.getDeferredRefreshCount();
+	for (int i = 0; i < 40; i++) {
+		xyHostAdvanceUs(i * 500);			//Edits start anywhere in the refresh cycle, also during a transfer
+		XYscope.beginEdit();
+		CHECK((XYscope.getEditSequence() & 1) == 1);
+		slowRewrite(500 + (i & 1) * 400);
+		XYscope.commitEdit();
+	}
+	CHECK(mixedFrames == 0);
+	CHECK(frames > 20);
+	CHECK(XYscope.getDeferredRefreshCount() > deferred0);
+	CHECK((XYscope.getEditSequence() & 1) == 0);
+
+	//Nested windows: only the outermost pair opens and closes
+	XYscope.beginEdit();
+	XYscope.beginEdit();
+	XYscope.commitEdit();
+	CHECK((XYscope.getEditSequence() & 1) == 1);
+	XYscope.commitEdit();
+	CHECK((XYscope.getEditSequence() & 1) == 0);
+	uint32_t f0 = XYscope.getFrameCount();
+	XYscope.waitForFrame(2);
+	CHECK(XYscope.getFrameCount() == f0 + 2);
+	return hostTestEnd("test_edit");
+}
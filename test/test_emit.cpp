@@ -0,0 +1,163 @@
+/*
+ * test_emit.cpp
+ *
+ *      Policy-based emitters (XYscopeEmit.h): lines end exactly on their end point, circle and ellipse arc
+ *      segments are numbered and start like plotCircle(..., arcSegment), clipScreen drops what noClip folds
+ *      over, and listSink goes through the packed store when one is set.
+ */
+
+#include <algorithm>
+#include <vector>
+#include "XYscope.h"
+#include "XYscopeEmit.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+using namespace XYemit;
+
+static XYscope::pointList pts[4000];
+static traceSink trace(pts, 4000);
+static emitter<traceSink, noClip, identity, fixedDensity<9> > draw(trace);	//Same dot spacing as the plot routines' circles
+
+static int coord(short v) {
+	return v & 0xfff;
+}
+
+static uint32_t packedPoint(const XYscope::pointList &p) {
+	return (uint32_t(coord(p.X)) << 16) | coord(p.Y);
+}
+
+static bool lineEnds(int x0, int y0, int x1, int y1) {
+	//	Traced line starts on (x0,y0) and ends on (x1,y1), with a point every 10 steps along the major axis
+	trace.points = 0;
+	draw.line(x0, y0, x1, y1);
+	int steps = std::max(abs(x1 - x0), abs(y1 - y0));
+	int n = trace.points;
+	return n == steps / 10 + 1 + (steps % 10 != 0) && coord(pts[0].X) == x0 && coord(pts[0].Y) == y0
+			&& coord(pts[n - 1].X) == x1 && coord(pts[n - 1].Y) == y1;
+}
+
+static std::vector<uint32_t> frame, current;
+
+static void sink(uint16_t x, uint16_t y, bool, uint64_t) {
+	current.push_back((uint32_t(x) << 16) | y);
+}
+
+static void frameDone(uint32_t) {
+	frame = current;
+	current.clear();
+}
+
+uint8_t packed[8000];
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+
+	//Lines: exact end points, whether or not the length is a multiple of the dot spacing
+	CHECK(lineEnds(100, 200, 3000, 200));
+	CHECK(lineEnds(100, 200, 3003, 1457));
+	CHECK(lineEnds(3000, 4000, 17, 3));
+	CHECK(lineEnds(500, 500, 505, 1000));
+	CHECK(lineEnds(2000, 2000, 2000, 2000 + 1000));
+
+	//Circles and ellipses: each arc segment starts where plotCircle/plotEllipse(..., arcSegment) start it
+	bool segmentsMatch = true;
+	for (int seg = 0; seg < 8; seg++) {
+		trace.points = 0;
+		draw.circle(2047, 2047, 1000, 1 << seg);
+		XYscope.plotStart();
+		int start = XYscope.XYlistEnd;
+		XYscope.plotCircle(2047, 2047, 1000, 1 << seg);
+		const XYscope::pointList &run = XYscope.XY_List[start];
+		if (abs(coord(pts[0].X) - coord(run.X)) > 10 || abs(coord(pts[0].Y) - coord(run.Y)) > 10)
+			segmentsMatch = false;
+		trace.points = 0;
+		draw.ellipse(2047, 2047, 1500, 700, 1 << seg);
+		XYscope.plotStart();
+		XYscope.plotEllipse(2047, 2047, 1500, 700, 1 << seg);	//First point lands in the same slot (run)
+		if (abs(coord(pts[0].X) - coord(run.X)) > 10 || abs(coord(pts[0].Y) - coord(run.Y)) > 10)
+			segmentsMatch = false;
+	}
+	CHECK(segmentsMatch);
+	trace.points = 0;
+	draw.circle(2047, 2047, 1000);
+	CHECK(coord(pts[0].X) == 2047 - 1000 && coord(pts[0].Y) == 2047);
+	CHECK(coord(pts[trace.points / 4].X) >= 2047 - 10 && coord(pts[trace.points / 4].Y) >= 3047 - 1);	//Through the top
+	trace.points = 0;
+	draw.ellipse(2047, 2047, 1500, 700);
+	CHECK(coord(pts[0].X) == 2047 - 1500 && coord(pts[0].Y) == 2047);
+
+	//clipScreen: the points noClip would fold over are dropped, the rest are the same
+	trace.points = 0;
+	draw.line(-500, 2000, 4500, 2100);
+	std::vector<uint32_t> inRange;
+	for (int i = 0; i < trace.points; i++) {
+		int x = -500 + ((i * 10 < 5000 ? i * 10 : 5000));
+		if (x >= 0 && x <= 4095)
+			inRange.push_back(packedPoint(pts[i]));
+	}
+	CHECK(int(inRange.size()) < trace.points);
+	emitter<traceSink, clipScreen, identity, fixedDensity<9> > clipped(trace);
+	trace.points = 0;
+	clipped.line(-500, 2000, 4500, 2100);
+	std::vector<uint32_t> kept;
+	for (int i = 0; i < trace.points; i++)
+		kept.push_back(packedPoint(pts[i]));
+	CHECK(kept == inRange);
+	trace.points = 0;
+	clipped.circle(0, 0, 500);
+	bool firstQuadrant = trace.points > 0;
+	for (int i = 0; i < trace.points; i++)
+		if (coord(pts[i].X) > 500 || coord(pts[i].Y) > 500)
+			firstQuadrant = false;
+	CHECK(firstQuadrant);
+
+	//listSink: into the list, or into the packed store when one is set; painted like the traced points
+	trace.points = 0;
+	draw.rectangle(300, 300, 3700, 3700);
+	draw.circle(2047, 2047, 1200);
+	std::vector<uint32_t> traced;
+	for (int i = 0; i < trace.points; i++)
+		traced.push_back(packedPoint(pts[i]));
+	for (int packedMode = 0; packedMode < 2; packedMode++) {
+		XYscope.setPackedList(packedMode ? packed : NULL, sizeof(packed));
+		XYscope.plotStart();
+		int listStart = XYscope.XYlistEnd;
+		{
+			listSink out(XYscope);
+			emitter<listSink, noClip, identity, fixedDensity<9> > toList(out);
+			toList.rectangle(300, 300, 3700, 3700);
+			toList.circle(2047, 2047, 1200);
+		}						//out flushes the last block here
+		if (packedMode) {
+			CHECK(XYscope.XYlistEnd == listStart);
+			CHECK(XYscope.getPackedPoints() == int(traced.size()));
+		} else {
+			std::vector<uint32_t> listed;
+			for (int i = listStart; i < XYscope.XYlistEnd; i++)
+				listed.push_back(packedPoint(XYscope.XY_List[i]));
+			CHECK(listed == traced);
+		}
+		XYscope.plotEnd();
+		XYscope.autoSetRefreshTime();
+		xyHostSetSampleSink(sink);
+		XYscope.setFrameCallback(frameDone);
+		XYscope.waitForFrame(3);
+		xyHostSetSampleSink(NULL);
+		XYscope.setFrameCallback(NULL);
+		CHECK(std::search(frame.begin(), frame.end(), traced.begin(), traced.end()) != frame.end());
+	}
+	XYscope.setPackedList(NULL, 0);
+	return hostTestEnd("test_emit");
+}
@@ -0,0 +1,112 @@
+/*
+ * test_event_refresh.cpp
+ *
+ *      Event driven refresh (setEventRefresh): a frame starts no sooner than the minimum period after the
+ *      last one, and right after the last one ends when painting takes longer, so a heavy scene is painted
+ *      back to back.  The refresh timer interrupts once or twice per frame, even with no minimum period.
+ *      The display keeps refreshing after streaming and after edit windows, whenever they end.
+ */
+
+#include "XYscope.h"
+#include "XYscopeHal.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static uint32_t framesIn(uint32_t us) {
+	uint32_t f0 = XYscope.getFrameCount();
+	xyHostAdvanceUs(us);
+	return XYscope.getFrameCount() - f0;
+}
+
+static uint64_t irqs;					//Refresh timer interrupts in the last irqsPerFrame() run
+
+static double irqsPerFrame(uint32_t us) {
+	uint64_t i0 = xyHostGetStats().refreshIrqs;
+	uint32_t frames = framesIn(us);
+	irqs = xyHostGetStats().refreshIrqs - i0;
+	return frames ? double(irqs) / frames : 1e9;
+}
+
+XYscope::pointList ring[4096];
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+
+	//Heavy scene (longer than the 20ms minimum period): fixed refresh loses frames, event refresh does not
+	for (int i = 0; i < 40; i++)
+		XYscope.plotCircle(2047, 2047, 200 + i * 40);
+	uint32_t frame_us = uint32_t(XYscope.XYlistEnd * 2 * XYscope.DmaClkPeriod_us);
+	CHECK(frame_us > 20000 && frame_us < 40000);
+	XYscope.setRefreshPeriodUs(20000);
+	uint32_t fixed = framesIn(1000000);
+	XYscope.setEventRefresh(true, 20000);
+	CHECK(XYscope.getEventRefresh());
+	uint32_t event = framesIn(1000000);
+	CHECK(event > fixed);
+	CHECK(event >= 1000000 / (frame_us + 1000) && event <= 1000000 / frame_us + 1);
+	CHECK(irqsPerFrame(1000000) <= 2);
+
+	//Light scene: one frame per minimum period
+	XYscope.plotStart();
+	XYscope.plotCircle(2047, 2047, 1000);
+	uint32_t light = framesIn(1000000);
+	CHECK(light >= 49 && light <= 51);
+	CHECK(irqsPerFrame(1000000) <= 2);
+
+	//No minimum period: frames back to back, and still no more than two timer interrupts per frame
+	XYscope.setEventRefresh(true, 0);
+	CHECK(framesIn(100000) > 2 * 5);
+	CHECK(irqsPerFrame(1000000) <= 2);
+	CHECK(irqs > 0);
+
+	//Edit window held open across several frame periods: no retry storm, and the frame follows commitEdit()
+	uint64_t i0 = xyHostGetStats().refreshIrqs;
+	XYscope.beginEdit();
+	uint32_t held = framesIn(100000);
+	XYscope.commitEdit();
+	CHECK(held <= 1);
+	CHECK(xyHostGetStats().refreshIrqs - i0 <= 100000 / (XYscope.CrtMinRefresh_ms * 1000) + 2);
+	CHECK(framesIn(2000) == 1);
+
+	//streamEnd() at any point of the refresh cycle, also while the last ring blocks are still being sent
+	int stalls = 0, runs = 0;
+	uint64_t streamIrqs = 0, streamFrames = 0;
+	for (int d = 0; d < 40000; d += 100) {
+		XYscope.setEventRefresh(true, d < 20000 ? 20000 : 0);
+		XYscope.waitForFrame(1);
+		XYscope.streamBegin(ring, 4096);
+		for (int i = 0; i < 3000; i++)
+			XYscope.streamPoint(i & 4095, 2000);
+		uint32_t t = micros();
+		while (micros() - t < uint32_t(d))
+			xyHalIdle();
+		i0 = xyHostGetStats().refreshIrqs;
+		XYscope.streamEnd();
+		uint32_t frames = framesIn(50000);
+		if (frames == 0)
+			stalls++;
+		streamIrqs += xyHostGetStats().refreshIrqs - i0;
+		streamFrames += frames;
+		runs++;
+	}
+	CHECK(stalls == 0);
+	CHECK(streamIrqs <= 2 * streamFrames + 2 * runs);	//Plus at most a drain retry per streamEnd()
+
+	//Back to the fixed refresh timer
+	XYscope.setEventRefresh(false);
+	CHECK(!XYscope.getEventRefresh());
+	XYscope.autoSetRefreshTime();
+	CHECK(framesIn(1000000) >= 49);
+	return hostTestEnd("test_event_refresh");
+}
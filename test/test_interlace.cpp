@@ -0,0 +1,98 @@
+/*
+ * test_interlace.cpp
+ *
+ *      Interlaced list (setInterlace): a list over the refresh budget is painted one field per refresh,
+ *      every point is painted once per cycle of fields, and the field count can follow the scene.
+ */
+
+#include <set>
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static std::set<uint32_t> seen;
+static uint32_t samples;
+
+static void sink(uint16_t x, uint16_t y, bool, uint64_t) {
+	samples++;
+	seen.insert((uint32_t(x) << 12) | y);
+}
+
+static uint32_t framesIn(uint32_t us) {
+	uint32_t f0 = XYscope.getFrameCount();
+	xyHostAdvanceUs(us);
+	return XYscope.getFrameCount() - f0;
+}
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	for (int i = 0; i < 40; i++)
+		XYscope.plotCircle(2047, 2047, 200 + i * 40);
+	int points = XYscope.XYlistEnd;
+	std::set<uint32_t> all;
+	for (int i = 0; i < points; i++)
+		all.insert((uint32_t(XYscope.XY_List[i].X & 0xfff) << 12) | (XYscope.XY_List[i].Y & 0xfff));
+	XYscope.autoSetRefreshTime();
+	CHECK(XYscope.getInterlace() == 1);
+	CHECK(XYscope.getRefreshPeriodUs() > XYscope.CrtMinRefresh_ms * 1000);	//Too many points for the minimum period
+
+	//Auto: the fewest fields that fit the minimum refresh period
+	XYscope.setInterlace(0);
+	CHECK(XYscope.getInterlace() == 2);
+	CHECK(XYscope.getRefreshPeriodUs() == XYscope.CrtMinRefresh_ms * 1000);
+	XYscope.waitForFrame(2);
+	xyHostSetSampleSink(sink);
+	XYscope.waitForFrame(1);
+	samples = 0;
+	seen.clear();
+	XYscope.waitForFrame(1);
+	CHECK(samples >= uint32_t(points / 2 - 10) && samples <= uint32_t(points / 2 + 10));
+	XYscope.waitForFrame(1);
+	bool covered = true;
+	for (std::set<uint32_t>::iterator p = all.begin(); p != all.end(); ++p)
+		if (seen.count(*p) == 0)
+			covered = false;
+	CHECK(covered);
+	xyHostSetSampleSink(NULL);
+	uint32_t fields = framesIn(1000000);
+	CHECK(fields >= 49 && fields <= 51);
+
+	//Fixed field count
+	XYscope.setInterlace(3);
+	CHECK(XYscope.getInterlace() == 3);
+	XYscope.autoSetRefreshTime();
+	xyHostSetSampleSink(sink);
+	XYscope.waitForFrame(2);
+	samples = 0;
+	XYscope.waitForFrame(1);
+	CHECK(samples >= uint32_t(points / 3 - 10) && samples <= uint32_t(points / 3 + 10));
+	xyHostSetSampleSink(NULL);
+
+	//The field count changing from loop() (autoSetRefreshTime) while refreshes run: no frame is lost
+	XYscope.setInterlace(0);
+	uint32_t f0 = XYscope.getFrameCount();
+	for (int i = 0; i < 200; i++) {
+		XYscope.plotStart();
+		for (int c = 0; c < (i & 1 ? 10 : 40); c++)
+			XYscope.plotCircle(2047, 2047, 200 + c * 40);
+		XYscope.autoSetRefreshTime();
+		xyHostAdvanceUs(7000);
+	}
+	CHECK(XYscope.getFrameCount() - f0 >= 200 * 7000 / 20000 - 2);
+
+	//Off again: the whole list every refresh
+	XYscope.setInterlace(1);
+	CHECK(XYscope.getInterlace() == 1);
+	return hostTestEnd("test_interlace");
+}
@@ -0,0 +1,71 @@
+/*
+ * test_layers.cpp
+ *
+ *      Background layer (setBackgroundLayer): the background and the overlay list are chained into one DMA
+ *      transfer, plotStart() only replaces the overlay, and clearBackgroundLayer() goes back to one list.
+ */
+
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static uint32_t samples, corner, centre;
+
+static void sink(uint16_t x, uint16_t y, bool, uint64_t) {
+	samples++;
+	if (x == 100 && y == 100)
+		corner++;			//Background rectangle
+	if (x == 2047 && y == 2347)
+		centre++;			//Overlay circle of radius 300, first point
+}
+
+static uint32_t oneFrame(void) {
+	//	Samples in one complete frame
+	XYscope.waitForFrame(1);
+	samples = corner = centre = 0;
+	XYscope.waitForFrame(1);
+	return samples;
+}
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	xyHostSetSampleSink(sink);
+
+	XYscope.plotRectangle(100, 100, 1000, 1000);
+	XYscope.setBackgroundLayer();
+	int bg = XYscope.getBackgroundPoints();
+	CHECK(bg > 0);
+	CHECK(oneFrame() == uint32_t(bg + XYscope.XYlistEnd));		//The overlay starts with a copy of the last background point
+	CHECK(corner > 0);
+
+	//Overlays replace each other, the background stays
+	for (int r = 200; r <= 300; r += 100) {
+		XYscope.plotStart();
+		XYscope.plotCircle(2047, 2047, r);
+		int overlay = XYscope.XYlistEnd;
+		CHECK(oneFrame() == uint32_t(bg + overlay));
+		CHECK(corner > 0);
+		CHECK((centre > 0) == (r == 300));
+	}
+	CHECK(XYscope.getBackgroundPoints() == bg);
+
+	//Without the background: one list again
+	XYscope.clearBackgroundLayer();
+	CHECK(XYscope.getBackgroundPoints() == 0);
+	XYscope.plotStart();
+	XYscope.plotCircle(2047, 2047, 300);
+	CHECK(oneFrame() == uint32_t(XYscope.XYlistEnd));
+	CHECK(corner == 0 && centre > 0);
+	return hostTestEnd("test_layers");
+}
@@ -0,0 +1,78 @@
+/*
+ * test_lod.cpp
+ *
+ *      Level of detail (setLodControl): plotStart() thins out the next scene when the last one took longer
+ *      than the target frame time, comes back to full detail when it is light again, and is not fooled by
+ *      figures clipped off screen (plotErr) -- only by the list running out of room.
+ */
+
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static int scene(int circles, bool offScreen) {
+	//	Redraw the scene; returns its size in points
+	XYscope.plotStart();
+	for (int i = 0; i < circles; i++)
+		XYscope.plotCircle(2047, 2047, 100 + (i * 37) % 1900);
+	XYscope.printSetup(100, 3700, 150, 100);
+	XYscope.print((char *)"HELLO WORLD", false);
+	if (offScreen)
+		XYscope.plotCircle(4000, 2047, 500);	//Partly clipped: sets plotErr
+	return XYscope.XYlistEnd;
+}
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	int budget = int(20000 / (XYscope.DmaClkPeriod_us * 2));
+	XYscope.setLodControl(true, 20000);
+	CHECK(XYscope.getLodLevel() == 100);
+
+	//Light scene: full detail
+	int light = 0;
+	for (int i = 0; i < 3; i++)
+		light = scene(8, false);
+	CHECK(light < budget);
+	CHECK(XYscope.getLodLevel() == 100);
+
+	//Heavy scene: detail goes down until it fits the target frame time
+	int heavy = 0;
+	for (int i = 0; i < 4; i++)
+		heavy = scene(30, false);
+	CHECK(XYscope.getLodLevel() < 100 && XYscope.getLodLevel() >= XYscope.LodMinLevel);
+	CHECK(heavy <= budget);
+
+	//Light again: back to full detail, same scene as before
+	scene(8, false);
+	CHECK(scene(8, false) == light);
+	CHECK(XYscope.getLodLevel() == 100);
+
+	//Clipping alone (plotErr) does not lower the level
+	for (int i = 0; i < 4; i++)
+		scene(24, true);
+	CHECK(XYscope.plotErr != 0);
+	CHECK(XYscope.getLodLevel() == 100);
+
+	//A scene that overflows the list is thinned out to the sparsest level
+	for (int i = 0; i < 4; i++)
+		heavy = scene(60, false);
+	CHECK(XYscope.getLodLevel() == XYscope.LodMinLevel);
+	CHECK(heavy < budget + budget / 10);		//Close to the target even at the sparsest level
+
+	//Off: full detail again
+	XYscope.setLodControl(false);
+	CHECK(XYscope.getLodLevel() == 100);
+	CHECK(scene(8, false) == light);
+	return hostTestEnd("test_lod");
+}
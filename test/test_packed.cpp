@@ -0,0 +1,80 @@
+/*
+ * test_packed.cpp
+ *
+ *      Packed list (setPackedList): a scene encoded into the delta/run store and decoded by the DACC ISR
+ *      paints exactly the same samples as the same scene in the plain list, in fewer bytes.
+ */
+
+#include <vector>
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscopeSized<20000> XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static std::vector<uint32_t> current, lastFrame;
+
+static void sink(uint16_t x, uint16_t y, bool, uint64_t) {
+	current.push_back((uint32_t(x) << 16) | y);
+}
+
+static void frameDone(uint32_t) {
+	lastFrame = current;
+	current.clear();
+}
+
+static void scene(void) {
+	XYscope.plotStart();
+	for (int i = 0; i < 8; i++)
+		XYscope.plotCircle(2047, 2047, 200 + i * 200);
+	XYscope.plotEllipse(2047, 2047, 1500, 700);
+	for (int i = 0; i < 30; i++)
+		XYscope.plotLine(100 + i * 100, 100, 4000 - i * 90, 3900);
+	XYscope.printSetup(200, 3500, 120);
+	XYscope.print((char *) "HELLO PACKED WORLD 0123456789", false);
+	XYscope.plotRectangle(50, 50, 4045, 4045);
+	XYscope.plotEnd();
+	XYscope.autoSetRefreshTime();
+}
+
+uint8_t packed[30000];
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	xyHostSetSampleSink(sink);
+	XYscope.setFrameCallback(frameDone);
+
+	scene();
+	int plainPoints = XYscope.XYlistEnd;
+	XYscope.waitForFrame(3);
+	std::vector<uint32_t> reference = lastFrame;
+	CHECK(reference.size() == size_t(plainPoints));
+
+	XYscope.setPackedList(packed, sizeof(packed));
+	scene();
+	CHECK(XYscope.getPackedPoints() + XYscope.XYlistEnd == plainPoints);	//plotStart() sync pulse stays in the list
+	CHECK(XYscope.getPackedBytes() < XYscope.getPackedPoints() * 2);
+	XYscope.waitForFrame(3);
+	CHECK(lastFrame == reference);
+
+	//Store too small: points are dropped, nothing is overwritten
+	XYscope.setPackedList(packed, 100);
+	scene();
+	CHECK(XYscope.getPackedBytes() <= 100);
+	CHECK(XYscope.getPackedPoints() + XYscope.XYlistEnd < plainPoints);
+
+	XYscope.setPackedList(NULL, 0);
+	scene();
+	XYscope.waitForFrame(3);
+	CHECK(lastFrame == reference);
+	return hostTestEnd("test_packed");
+}
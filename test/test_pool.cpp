@@ -0,0 +1,109 @@
+/*
+ * test_pool.cpp
+ *
+ *      Object pool (setObjectPool): objects are allocated, redrawn, resized, deleted and compacted without
+ *      changing what is painted, and the pool never leaks room.
+ */
+
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static uint64_t signature;
+static uint32_t lit;
+
+static void sink(uint16_t x, uint16_t y, bool blanked, uint64_t) {
+	if (blanked || y == 0)		//y = 0: plotStart() sync pulse
+		return;
+	signature += x * 7 + y;
+	lit++;
+}
+
+static uint64_t frameSignature(void) {
+	//	Sum over the lit samples of one complete frame (independent of the order objects are chained in)
+	XYscope.waitForFrame(1);
+	signature = 0;
+	lit = 0;
+	XYscope.waitForFrame(1);
+	return signature * 100000 + lit;
+}
+
+static XYscope::pointList pool[4000];
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	XYscope.plotStart();
+	XYscope.setRefreshPeriodUs(20000);
+	XYscope.setObjectPool(pool, 4000);
+	CHECK(XYscope.getPoolFree() == 4000);
+	xyHostSetSampleSink(sink);
+
+	//Fill the object table
+	int handle[XYscope::MaxObjects], capacity[XYscope::MaxObjects];
+	srand(3);
+	for (int i = 0; i < XYscope.MaxObjects; i++) {
+		capacity[i] = 100 + rand() % 100;
+		handle[i] = XYscope.objectNew(capacity[i]);
+		CHECK(handle[i] >= 0);
+		XYscope.objectBegin(handle[i]);
+		XYscope.plotLine(rand() % 4000, rand() % 4000, rand() % 4000, rand() % 4000);
+		XYscope.objectEnd();
+	}
+	CHECK(XYscope.objectNew(10) == -1);
+
+	//Deleting and compacting moves objects but does not change the picture
+	for (int i = 0; i < XYscope.MaxObjects; i += 2) {
+		XYscope.objectDelete(handle[i]);
+		handle[i] = -1;
+	}
+	uint64_t before = frameSignature();
+	int moves = 0;
+	while (XYscope.objectCompact() > 0)
+		moves++;
+	CHECK(moves > 0);
+	CHECK(frameSignature() == before);
+
+	//Random workout; after compacting, the free room is exactly what the live objects do not use
+	for (int it = 0; it < 3000; it++) {
+		int k = rand() % XYscope.MaxObjects;
+		int op = rand() % 4;
+		if (op == 0 && handle[k] < 0) {
+			capacity[k] = 1 + rand() % 400;
+			handle[k] = XYscope.objectNew(capacity[k]);
+			if (handle[k] >= 0) {
+				XYscope.objectBegin(handle[k]);
+				XYscope.plotLine(0, 0, rand() % 4000, rand() % 4000);
+				XYscope.objectEnd();
+			}
+		} else if (op == 1 && handle[k] >= 0) {
+			XYscope.objectDelete(handle[k]);
+			handle[k] = -1;
+		} else if (op == 2 && handle[k] >= 0) {
+			int newCapacity = 1 + rand() % 500;
+			if (XYscope.objectResize(handle[k], newCapacity))
+				capacity[k] = newCapacity;
+		} else
+			XYscope.objectCompact();
+	}
+	while (XYscope.objectCompact() > 0)
+		;
+	int used = 0;
+	for (int i = 0; i < XYscope.MaxObjects; i++)
+		if (handle[i] >= 0)
+			used += capacity[i];
+	CHECK(XYscope.getPoolFree() == 4000 - used);
+
+	XYscope.setObjectPool(NULL, 0);
+	return hostTestEnd("test_pool");
+}
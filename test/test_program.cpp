@@ -0,0 +1,88 @@
+/*
+ * test_program.cpp
+ *
+ *      Display programs (setDisplayProgram): figures generated into the staging buffers by the DACC ISR,
+ *      subroutine calls with a saved origin, and arc segment masks on circles and ellipses.
+ */
+
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscopeSized<2000> XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static uint32_t lit;
+static int minX, maxX, minY, maxY;
+
+static void sink(uint16_t x, uint16_t y, bool blanked, uint64_t) {
+	if (blanked || y == 0)		//y = 0: plotStart() sync pulse
+		return;
+	lit++;
+	if (x < minX)
+		minX = x;
+	if (x > maxX)
+		maxX = x;
+	if (y < minY)
+		minY = y;
+	if (y > maxY)
+		maxY = y;
+}
+
+static void paint(const uint16_t *program) {
+	//	Paint 'program' alone for one complete frame
+	XYscope.setDisplayProgram(program);
+	XYscope.waitForFrame(2);
+	lit = 0;
+	minX = minY = 9999;
+	maxX = maxY = 0;
+	XYscope.waitForFrame(1);
+}
+
+const uint16_t full[] = { XYP_CIRCLE(2047, 2047, 1000), XYP_HALT };
+const uint16_t top[] = { XYP_ARC(2047, 2047, 1000, 0x0f), XYP_HALT };
+const uint16_t left[] = { XYP_ARC(2047, 2047, 1000, 0x81), XYP_HALT };
+const uint16_t bottom[] = { XYP_ELLIPSE_ARC(2047, 2047, 1000, 500, 0xf0), XYP_HALT };
+const uint16_t crosses[] = {
+	XYP_JUMP(13),
+	XYP_LINE(-50, 0, 50, 0), XYP_LINE(0, -50, 0, 50), XYP_RET,	//Word 2: a small cross, relative to the origin
+	XYP_ORIGIN(500, 700), XYP_CALL(2),
+	XYP_ORIGIN(3500, 3000), XYP_CALL(2),
+	XYP_HALT };
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	xyHostSetSampleSink(sink);
+	XYscope.plotStart();
+
+	paint(full);
+	uint32_t fullPoints = XYscope.getProgramPoints();
+	CHECK(fullPoints > 500 && lit == fullPoints);
+	CHECK(minX >= 1040 && maxX <= 3056 && minY >= 1040 && maxY <= 3056);	//Minsky circle: within a few DAC steps
+
+	//Arc segments are numbered as plotCircle(xc, yc, r, arcSegment): 0-3 upper half, 0 and 7 next to (xc - r, yc)
+	paint(top);
+	CHECK(XYscope.getProgramPoints() >= fullPoints / 2 - 2 && XYscope.getProgramPoints() <= fullPoints / 2 + 2);
+	CHECK(minY >= 2046 && maxY >= 3040);
+	paint(left);
+	CHECK(maxX < 1400 && minY < 1400 && maxY > 2700);
+	paint(bottom);
+	CHECK(maxY <= 2050 && minY <= 1550);
+
+	//Subroutine drawn at two origins
+	paint(crosses);
+	CHECK(minX == 450 && maxX == 3550 && minY == 650 && maxY == 3050);
+	CHECK(XYscope.getProgramPoints() == 2 * (2 * (100 / 11 + 2)));
+
+	XYscope.setDisplayProgram(NULL);
+	CHECK(XYscope.getProgramPoints() == 0);
+	return hostTestEnd("test_program");
+}
@@ -0,0 +1,110 @@
+/*
+ * test_queue.cpp
+ *
+ *      Deferred plot commands (setCommandQueue): flush() without options gives the same list as plotting
+ *      right away, cmdCull drops figures that are entirely off screen, and cmdReorder picks the figure whose
+ *      first point is nearest to the beam.
+ */
+
+#include <vector>
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscopeSized<20000> XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static XYscope::plotCommand queue[64];
+
+static void scene(void) {
+	//	Random figures, some partly and two entirely off screen
+	srand(1);
+	for (int i = 0; i < 40; i++) {
+		int x = rand() % 3500 + 300, y = rand() % 3500 + 300;
+		XYscope.plotLine(x, y, x + rand() % 200, y + rand() % 200);
+	}
+	for (int i = 0; i < 60; i++) {
+		int k = rand() % 3;
+		if (k == 0)
+			XYscope.plotLine(rand() % 5000 - 500, rand() % 5000 - 500, rand() % 5000 - 500, rand() % 5000 - 500);
+		else if (k == 1)
+			XYscope.plotCircle(rand() % 4096, rand() % 4096, rand() % 600 + 10);
+		else
+			XYscope.plotEllipse(rand() % 4096, rand() % 4096, rand() % 600 + 10, rand() % 300 + 10, 0xff);
+	}
+	XYscope.plotCircle(-1000, 2000, 300);		//Entirely off screen
+	XYscope.plotLine(5000, 5000, 6000, 4500);
+	XYscope.printSetup(200, 3500, 100);
+	XYscope.print((char *) "QUEUE 123", false);
+	XYscope.plotRectangle(50, 50, 4045, 4045);
+}
+
+static std::vector<uint32_t> list(void) {
+	std::vector<uint32_t> points;
+	for (int i = 0; i < XYscope.XYlistEnd; i++)
+		points.push_back((uint32_t(uint16_t(XYscope.XY_List[i].X)) << 16) | uint16_t(XYscope.XY_List[i].Y));
+	return points;
+}
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+
+	XYscope.plotStart();
+	scene();
+	std::vector<uint32_t> direct = list();
+
+	//No options: same points, same order (the queue is smaller than the scene, so it is flushed as it fills)
+	XYscope.setCommandQueue(queue, 64, 0);
+	XYscope.plotStart();
+	scene();
+	CHECK(XYscope.getQueuedCommands() > 0);
+	XYscope.flush();
+	CHECK(XYscope.getQueuedCommands() == 0);
+	CHECK(list() == direct);
+
+	//cmdCull alone: the same list without the off-screen figures
+	XYscope.setCommandQueue(queue, 64, XYscope.cmdCull);
+	XYscope.plotStart();
+	scene();
+	XYscope.flush();
+	CHECK(XYscope.XYlistEnd < int(direct.size()));
+	CHECK(XYscope.XYlistEnd > int(direct.size()) * 9 / 10);
+
+	//cmdReorder goes to the figure that STARTS nearest: arc circles at their left hand side,
+	//plotCircle(xc, yc, r) at the top (the far side of each figure is nearer in both cases)
+	XYscope.setCommandQueue(queue, 64, XYscope.cmdReorder);
+	XYscope.plotStart();
+	XYscope.plotPoint(1000, 2047);						//Beam here when the queue is flushed
+	int start = XYscope.XYlistEnd;
+	XYscope.plotCircle(1500, 3500, 200, 0xff);			//Starts at (1300, 3500): 1753 away
+	XYscope.plotCircle(3000, 2047, 1000, 0xff);			//Starts at (2000, 2047): 1000 away
+	XYscope.flush();
+	CHECK((XYscope.XY_List[start].X & 0xfff) == 2000 && (XYscope.XY_List[start].Y & 0xfff) == 2047);
+	XYscope.plotStart();
+	XYscope.plotPoint(2047, 1600);
+	start = XYscope.XYlistEnd;
+	XYscope.plotCircle(2600, 1600, 300, 0xff);			//Starts at (2300, 1600): 253 away
+	XYscope.plotCircle(2047, 1000, 500);				//Starts at (2047, 1500): 100 away
+	XYscope.flush();
+	CHECK((XYscope.XY_List[start].X & 0xfff) == 2047 && (XYscope.XY_List[start].Y & 0xfff) == 1500);
+
+	//Points plotted between queued calls land before the queued figures
+	XYscope.plotStart();
+	XYscope.plotLine(100, 100, 200, 200);
+	start = XYscope.XYlistEnd;
+	XYscope.plotPoint(1234, 567);
+	CHECK(XYscope.XYlistEnd == start + 1);
+	XYscope.flush();
+	CHECK((XYscope.XY_List[start].X & 0xfff) == 1234 && (XYscope.XY_List[start].Y & 0xfff) == 567);
+
+	XYscope.setCommandQueue(NULL, 0);
+	return hostTestEnd("test_queue");
+}
@@ -0,0 +1,71 @@
+/*
+ * test_refresh.cpp
+ *
+ *      Basic refresh: a list is painted once per refresh period, behind the front porch, and the frame
+ *      counter, frame callback and waitForFrame() pacing follow it.
+ */
+
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static uint32_t samples, lit, callbacks;
+
+static void sink(uint16_t, uint16_t, bool blanked, uint64_t) {
+	samples++;
+	if (!blanked)
+		lit++;
+}
+
+static void frameDone(uint32_t) {
+	callbacks++;
+}
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	xyHostSetSampleSink(sink);
+	XYscope.setFrameCallback(frameDone);
+
+	XYscope.plotCircle(2047, 2047, 1000);
+	XYscope.printSetup(100, 100, 300);
+	XYscope.print((char *) "HELLO 123");
+	int points = XYscope.XYlistEnd;
+	CHECK(points > 500);
+	XYscope.autoSetRefreshTime();
+	CHECK(XYscope.getRefreshPeriodUs() == XYscope.CrtMinRefresh_ms * 1000);
+
+	//One frame: every point of the list is converted; all but the front porch ones are lit
+	XYscope.waitForFrame(2);
+	samples = lit = 0;
+	uint32_t f0 = XYscope.getFrameCount();
+	XYscope.waitForFrame(1);
+	CHECK(XYscope.getFrameCount() == f0 + 1);
+	CHECK(samples == uint32_t(points));
+	CHECK(lit < samples && lit > samples * 9 / 10);
+
+	//100ms at a 20ms refresh period: 5 frames, each with a back and a front porch
+	xyHostReset();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	XYscope.plotCircle(2047, 2047, 1000);
+	XYscope.autoSetRefreshTime();
+	callbacks = 0;
+	xyHostAdvanceUs(100000);
+	const xyHostStats &s = xyHostGetStats();
+	CHECK(s.refreshIrqs == 5);
+	CHECK(s.transfers == 5);
+	CHECK(callbacks >= 4);
+	CHECK(s.blankEdges >= 2 * callbacks);
+	return hostTestEnd("test_refresh");
+}
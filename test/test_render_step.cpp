@@ -0,0 +1,80 @@
+/*
+ * test_render_step.cpp
+ *
+ *      Time-sliced rendering (renderStep): the queue rendered one figure per call, with refreshes running in
+ *      between, gives the same list as flush().  (Plotting takes no virtual time on the host, so the time
+ *      budget itself is not tested here.)
+ */
+
+#include <vector>
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscopeSized<20000> XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static XYscope::plotCommand queue[128];
+
+static void scene(void) {
+	//	Random figures, some partly and two entirely off screen (no text: print() flushes the queue)
+	srand(1);
+	for (int i = 0; i < 40; i++) {
+		int x = rand() % 3500 + 300, y = rand() % 3500 + 300;
+		XYscope.plotLine(x, y, x + rand() % 200, y + rand() % 200);
+	}
+	for (int i = 0; i < 60; i++) {
+		int k = rand() % 3;
+		if (k == 0)
+			XYscope.plotLine(rand() % 5000 - 500, rand() % 5000 - 500, rand() % 5000 - 500, rand() % 5000 - 500);
+		else if (k == 1)
+			XYscope.plotCircle(rand() % 4096, rand() % 4096, rand() % 600 + 10);
+		else
+			XYscope.plotEllipse(rand() % 4096, rand() % 4096, rand() % 600 + 10, rand() % 300 + 10, 0xff);
+	}
+	XYscope.plotCircle(-1000, 2000, 300);		//Entirely off screen
+	XYscope.plotLine(5000, 5000, 6000, 4500);
+	XYscope.plotRectangle(50, 50, 4045, 4045);
+}
+
+static std::vector<uint32_t> list(void) {
+	std::vector<uint32_t> points;
+	for (int i = 0; i < XYscope.XYlistEnd; i++)
+		points.push_back((uint32_t(uint16_t(XYscope.XY_List[i].X)) << 16) | uint16_t(XYscope.XY_List[i].Y));
+	return points;
+}
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+
+	//renderStep() one figure at a time gives what flush() gives
+	XYscope.setCommandQueue(queue, 128);
+	XYscope.plotStart();
+	scene();
+	XYscope.flush();
+	std::vector<uint32_t> flushed = list();
+	XYscope.plotStart();
+	scene();
+	int queued = XYscope.getQueuedCommands();
+	uint32_t f0 = XYscope.getFrameCount();
+	int steps = 1;
+	while (XYscope.renderStep(0) > 0) {
+		steps++;
+		xyHostAdvanceUs(1000);
+	}
+	CHECK(queued > 100);
+	CHECK(steps == queued);			//A budget of 0 still renders one figure per call
+	CHECK(XYscope.getFrameCount() != f0);
+	CHECK(list() == flushed);
+
+	XYscope.setCommandQueue(NULL, 0);
+	return hostTestEnd("test_render_step");
+}
@@ -0,0 +1,153 @@
+/*
+ * test_repeat.cpp
+ *
+ *      Segment repeat (segmentSetRepeat): a repeated segment is sent again right after itself by the DMA
+ *      chain, also when the list continues into extra RAM chunks.  segmentSetRepeat() refuses repeats that
+ *      would not fit in the chain, and the fullest chain it allows is painted without dropping a block.
+ */
+
+#include <vector>
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscopeSized<1000> XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static std::vector<uint32_t> frame;
+
+static void sink(uint16_t x, uint16_t y, bool, uint64_t) {
+	frame.push_back((uint32_t(x) << 12) | y);
+}
+
+XYscope::pointList chunkA[500], chunkB[500], chunkC[500], chunkD[500];
+static XYscope::pointList pool[4000];
+static XYscope::pointList statics[XYscope::MaxStaticLists][20];
+
+static uint32_t listPoint(int i) {
+	//	Point i of the list, which continues into chunkA and chunkB
+	const XYscope::pointList &p = i < 1000 ? XYscope.XY_List[i] : (i < 1500 ? chunkA[i - 1000] : chunkB[i - 1500]);
+	return (uint32_t(p.X & 0xfff) << 12) | (p.Y & 0xfff);
+}
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	XYscope.addListChunk(chunkA, 500);
+	XYscope.addListChunk(chunkB, 500);
+	XYscope.addListChunk(chunkC, 500);
+	XYscope.addListChunk(chunkD, 500);
+	XYscope.plotStart();
+	for (int i = 0; i < 3; i++)
+		XYscope.plotLine(100, 100 + i * 300, 3900, 100 + i * 300);
+	int ballStart = XYscope.XYlistEnd;
+	CHECK(ballStart > 1000);		//Segments are in chunk A
+	int ball = XYscope.segmentOpen(200);
+	XYscope.segmentBegin(ball);
+	XYscope.plotCircle(2000, 2000, 200);
+	XYscope.segmentEnd();
+	int ringStart = XYscope.XYlistEnd;
+	int ring = XYscope.segmentOpen(300);
+	XYscope.segmentBegin(ring);
+	XYscope.plotCircle(1000, 1000, 300);
+	XYscope.segmentEnd();
+	int ringEnd = XYscope.XYlistEnd;
+	CHECK(ringEnd > 1500);			//Second segment straddles chunk A and chunk B
+	XYscope.plotLine(100, 3900, 3900, 3900);
+	int points = XYscope.XYlistEnd;
+
+	CHECK(XYscope.getSegmentRepeat(ball) == 1);
+	XYscope.segmentSetRepeat(ball, 3);
+	XYscope.segmentSetRepeat(ring, 2);
+	CHECK(XYscope.getSegmentRepeat(ball) == 3);
+	CHECK(XYscope.getSegmentRepeat(ring) == 2);
+	CHECK(XYscope.getSegmentRepeat(5) == -1);
+	XYscope.autoSetRefreshTime();
+	XYscope.waitForFrame(2);
+	xyHostSetSampleSink(sink);
+	XYscope.waitForFrame(1);
+	frame.clear();
+	XYscope.waitForFrame(1);
+
+	std::vector<uint32_t> expected;
+	for (int i = 0; i < ringStart; i++)
+		expected.push_back(listPoint(i));
+	for (int r = 1; r < 3; r++)
+		for (int i = ballStart; i < ringStart; i++)
+			expected.push_back(listPoint(i));
+	for (int r = 0; r < 2; r++)
+		for (int i = ringStart; i < ringEnd; i++)
+			expected.push_back(listPoint(i));
+	for (int i = ringEnd; i < points; i++)
+		expected.push_back(listPoint(i));
+	CHECK(frame == expected);
+
+	//Back to once per refresh
+	XYscope.segmentSetRepeat(ball, 1);
+	XYscope.segmentSetRepeat(ring, 1);
+	XYscope.waitForFrame(1);
+	frame.clear();
+	XYscope.waitForFrame(1);
+	CHECK(frame.size() == size_t(points));
+
+	//Fullest chain segmentSetRepeat() allows: background, list running through all four chunks, MaxObjects
+	//pool objects that are not chained together (each has room to spare), MaxStaticLists static lists, and
+	//all MaxRepeatBlocks on one segment that straddles chunks C and D, so every copy takes two blocks
+	XYscope.plotStart();
+	XYscope.plotLine(100, 50, 3900, 50);
+	XYscope.setBackgroundLayer();
+	int bgPoints = XYscope.getBackgroundPoints();
+	CHECK(bgPoints > 0);
+	XYscope.plotStart();
+	const int chunkD = 1000 + 3 * 500 - (bgPoints + 1);	//Overlay index of the first point in chunk D
+	for (int i = 0; XYscope.XYlistEnd < chunkD - 50; i++)
+		XYscope.plotPoint(100 + (i * 7) % 3800, 300);
+	int wide = XYscope.segmentOpen(150);
+	XYscope.segmentBegin(wide);
+	XYscope.plotCircle(2047, 2047, 150);
+	XYscope.segmentEnd();
+	CHECK(XYscope.XYlistEnd > chunkD);
+	int other = XYscope.segmentOpen(100);
+	XYscope.plotLine(100, 3900, 1000, 3900);
+	CHECK(!XYscope.getListFull());
+	XYscope.setObjectPool(pool, 4000);
+	int poolPoints = 0;
+	for (int i = 0; i < XYscope.MaxObjects; i++) {
+		int h = XYscope.objectNew(100);
+		CHECK(h >= 0);
+		XYscope.objectBegin(h);
+		XYscope.plotLine(100, 100 + i * 200, 1000, 100 + i * 200);
+		XYscope.objectEnd();
+		poolPoints += XYscope.getObjectPoints(h);
+	}
+	for (int i = 0; i < XYscope.MaxStaticLists; i++) {
+		for (int j = 0; j < 20; j++) {
+			statics[i][j].X = (3000 + j * 10) | XYscope.X_flag;
+			statics[i][j].Y = (100 + i * 500) | XYscope.Y_flag;
+		}
+		CHECK(XYscope.addStaticList(statics[i], 20) >= 0);
+	}
+
+	const int count = XYscope.MaxRepeatBlocks / 2;
+	CHECK(!XYscope.segmentSetRepeat(wide, count + 1));		//Refused: more than MaxRepeatBlocks
+	CHECK(XYscope.getSegmentRepeat(wide) == 1);
+	CHECK(XYscope.segmentSetRepeat(wide, count));
+	CHECK(!XYscope.segmentSetRepeat(other, 2));				//Budget used up
+	CHECK(XYscope.getSegmentRepeat(other) == 1);
+	CHECK(!XYscope.segmentSetRepeat(99, 2));
+
+	XYscope.autoSetRefreshTime();
+	XYscope.waitForFrame(1);
+	frame.clear();
+	XYscope.waitForFrame(1);
+	CHECK(frame.size() == size_t(bgPoints + XYscope.XYlistEnd + (count - 1) * 150 + poolPoints
+			+ XYscope.MaxStaticLists * 20));
+	return hostTestEnd("test_repeat");
+}
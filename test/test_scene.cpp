@@ -0,0 +1,102 @@
+/*
+ * test_scene.cpp
+ *
+ *      Retained scene nodes (sceneAdd.../sceneSet.../sceneUpdate): only nodes that really changed are re-plotted,
+ *      each one inside its own reserved points, and the rest of the list stays exactly as it was.
+ */
+
+#include <vector>
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static std::vector<uint32_t> list(int from, int to) {
+	std::vector<uint32_t> points;
+	for (int i = from; i < to; i++)
+		points.push_back((uint32_t(uint16_t(XYscope.XY_List[i].X)) << 16) | uint16_t(XYscope.XY_List[i].Y));
+	return points;
+}
+
+static std::vector<uint32_t> plotted(int xc, int yc, int r) {
+	//	Points plotCircle() adds for this circle
+	int start = XYscope.XYlistEnd;
+	XYscope.plotCircle(xc, yc, r);
+	std::vector<uint32_t> points = list(start, XYscope.XYlistEnd);
+	XYscope.XYlistEnd = start;
+	return points;
+}
+
+static bool sameOutside(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b, int from, int to) {
+	//	a and b are equal, except maybe for entries from..to-1
+	if (a.size() != b.size())
+		return false;
+	for (size_t i = 0; i < a.size(); i++)
+		if ((int(i) < from || int(i) >= to) && a[i] != b[i])
+			return false;
+	return true;
+}
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	XYscope.plotStart();
+	std::vector<uint32_t> circle700 = plotted(2047, 2047, 700);
+
+	//Ordinary plot output around three nodes; a node's points are at [start, start + capacity)
+	XYscope.plotRectangle(100, 100, 3900, 3900);
+	int lineAt = XYscope.XYlistEnd;
+	int line = XYscope.sceneAddLine(2047, 1000, 2047, 3000, 300);
+	int circleAt = XYscope.XYlistEnd;
+	int circle = XYscope.sceneAddCircle(2047, 2047, 500, 1200);
+	int textAt = XYscope.XYlistEnd;
+	int text = XYscope.sceneAddText(1500, 500, 200, "0.00V", 400);
+	int textEnd = XYscope.XYlistEnd;
+	XYscope.plotLine(100, 2047, 3900, 2047);
+	CHECK(line >= 0 && circle >= 0 && text >= 0);
+	CHECK(circleAt - lineAt == 300 && textAt - circleAt == 1200 && textEnd - textAt == 400);
+	XYscope.autoSetRefreshTime();
+	std::vector<uint32_t> before = list(0, XYscope.XYlistEnd);
+
+	//Setting a node to what it already is: nothing to do
+	XYscope.sceneSetCircle(circle, 2047, 2047, 500);
+	XYscope.sceneSetText(text, "0.00V");
+	CHECK(XYscope.sceneUpdate() == 0);
+	CHECK(list(0, XYscope.XYlistEnd) == before);
+
+	//One node changed: only its points are rewritten, and they are what plotCircle() gives
+	XYscope.sceneSetCircle(circle, 2047, 2047, 700);
+	CHECK(list(0, XYscope.XYlistEnd) == before);		//Nothing happens before sceneUpdate()
+	CHECK(XYscope.sceneUpdate() == 1);
+	std::vector<uint32_t> after = list(0, XYscope.XYlistEnd);
+	CHECK(after != before);
+	CHECK(sameOutside(after, before, circleAt, textAt));
+	CHECK(XYscope.getSegmentPoints(circle) == int(circle700.size()));	//Scene nodes are the only segments
+	CHECK(list(circleAt, circleAt + circle700.size()) == circle700);
+	CHECK(XYscope.sceneUpdate() == 0);
+
+	//Two nodes changed: both re-plotted, the third (and everything else) untouched
+	XYscope.sceneSetLine(line, 2047, 1000, 3000, 3000);
+	XYscope.sceneSetText(text, "9.99V");
+	CHECK(XYscope.sceneUpdate() == 2);
+	std::vector<uint32_t> again = list(0, XYscope.XYlistEnd);
+	CHECK(sameOutside(again, after, lineAt, textEnd));
+	CHECK(list(circleAt, textAt) == std::vector<uint32_t>(after.begin() + circleAt, after.begin() + textAt));
+	CHECK(list(lineAt, circleAt) != std::vector<uint32_t>(after.begin() + lineAt, after.begin() + circleAt));
+	CHECK(list(textAt, textEnd) != std::vector<uint32_t>(after.begin() + textAt, after.begin() + textEnd));
+
+	//The list keeps being painted throughout
+	uint32_t f0 = XYscope.getFrameCount();
+	XYscope.waitForFrame(2);
+	CHECK(XYscope.getFrameCount() == f0 + 2);
+	return hostTestEnd("test_scene");
+}
@@ -0,0 +1,95 @@
+/*
+ * test_sized.cpp
+ *
+ *      List size fixed at compile time (XYscopeSized<N>) or by a caller supplied buffer: the object holds
+ *      exactly N points, plotting past the end stops inside the buffer and is reported by getListFull(),
+ *      and a caller supplied buffer is painted like the default one.
+ */
+
+#include <string.h>
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscopeSized<500> sized;
+
+struct {
+	XYscope::pointList list[300];
+	XYscope::pointList guard[8];		//Must survive any amount of plotting into 'list'
+} buffer;
+XYscope own(buffer.list, 300);
+
+XYscope *scope = &sized;				//The scope the ISRs serve
+
+void DACC_Handler(void) {
+	scope->dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	scope->initiateDacDma();
+}
+
+static uint32_t samples, lit;
+
+static void sink(uint16_t, uint16_t, bool blanked, uint64_t) {
+	samples++;
+	if (!blanked)
+		lit++;
+}
+
+static uint32_t oneFrame(void) {
+	//	Samples in one complete frame
+	scope->waitForFrame(1);
+	samples = lit = 0;
+	scope->waitForFrame(1);
+	return samples;
+}
+
+int main() {
+	hostTestBegin();
+	CHECK(sizeof(XYscopeSized<500>) - sizeof(XYscope) == 500 * sizeof(XYscope::pointList));
+	CHECK(sized.MaxBuffSize == 500);
+	CHECK(own.MaxBuffSize == 300 && own.XY_List == buffer.list);
+
+	//XYscopeSized: painted like the default list, overflow stops at the end of the object's own buffer
+	sized.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	xyHostSetSampleSink(sink);
+	sized.plotStart();
+	sized.plotCircle(2047, 2047, 100);
+	CHECK(!sized.getListFull());
+	int points = sized.XYlistEnd;
+	CHECK(oneFrame() == uint32_t(points));
+	for (int i = 0; i < 10; i++)
+		sized.plotCircle(2047, 2047, 300 + i * 100);
+	CHECK(sized.getListFull());
+	CHECK(sized.XYlistEnd == 500 - 2);		//Room is left for plotEnd()'s copy of the last point
+	sized.plotEnd();
+	CHECK(oneFrame() == 500 - 2);
+	sized.plotStart();
+	CHECK(!sized.getListFull());
+
+	//Caller supplied buffer: nothing is written past it, and it is what the DMA paints
+	memset(buffer.guard, 0x5a, sizeof(buffer.guard));
+	xyHostReset();
+	scope = &own;
+	own.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	own.plotStart();
+	own.plotRectangle(1000, 1000, 3000, 3000);
+	points = own.XYlistEnd;
+	own.autoSetRefreshTime();
+	CHECK(oneFrame() == uint32_t(points));
+	CHECK(lit > 0);
+	for (int i = 0; i < 10; i++)
+		own.plotCircle(2047, 2047, 300 + i * 100);
+	own.plotEnd();
+	CHECK(own.getListFull());
+	CHECK(own.XYlistEnd == 300 - 2);
+	bool guardIntact = true;
+	for (size_t i = 0; i < sizeof(buffer.guard); i++)
+		if (((uint8_t *) buffer.guard)[i] != 0x5a)
+			guardIntact = false;
+	CHECK(guardIntact);
+	CHECK(oneFrame() == 300 - 2);
+	return hostTestEnd("test_sized");
+}
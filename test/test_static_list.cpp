@@ -0,0 +1,75 @@
+/*
+ * test_static_list.cpp
+ *
+ *      Static (FLASH) lists (addStaticList): each one is sent by the DMA straight from where it is, after the
+ *      list (and the background layer), as often as it is added, and is gone from the next refresh on when it
+ *      is removed.
+ */
+
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+const XYscope::pointList tri[] = { XY_POINT(1000, 1000), XY_POINT(1500, 2000), XY_POINT(2000, 1000), XY_POINT(1000, 1000) };
+const XYscope::pointList one[] = { XY_POINT(4000, 4000) };
+
+static uint32_t samples, apex, corner;
+
+static void sink(uint16_t x, uint16_t y, bool, uint64_t) {
+	samples++;
+	if (x == 1500 && y == 2000)
+		apex++;
+	if (x == 4000 && y == 4000)
+		corner++;
+}
+
+static uint32_t oneFrame(void) {
+	//	Samples in one complete frame
+	XYscope.waitForFrame(1);
+	samples = apex = corner = 0;
+	XYscope.waitForFrame(1);
+	return samples;
+}
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	xyHostSetSampleSink(sink);
+
+	XYscope.plotRectangle(100, 100, 1000, 1000);
+	XYscope.setBackgroundLayer();
+	int bg = XYscope.getBackgroundPoints();
+	XYscope.plotCircle(2047, 2047, 300);
+	int overlay = XYscope.XYlistEnd;
+	int a = XYscope.addStaticList(tri, 4);
+	int b = XYscope.addStaticList(one, 1);
+	int c = XYscope.addStaticList(tri, 4);
+	CHECK(a >= 0 && b >= 0 && c >= 0 && a != b && b != c);
+	CHECK(oneFrame() == uint32_t(bg + overlay + 4 + 1 + 4));
+	CHECK(apex == 2 && corner == 1);
+
+	//A new overlay keeps the static lists
+	XYscope.plotStart();
+	XYscope.plotCircle(2047, 2047, 200);
+	overlay = XYscope.XYlistEnd;
+	CHECK(oneFrame() == uint32_t(bg + overlay + 4 + 1 + 4));
+
+	XYscope.removeStaticList(b);
+	CHECK(oneFrame() == uint32_t(bg + overlay + 4 + 4));
+	CHECK(apex == 2 && corner == 0);
+	XYscope.removeStaticList(a);
+	XYscope.removeStaticList(c);
+	CHECK(oneFrame() == uint32_t(bg + overlay));
+	CHECK(apex == 0);
+	return hostTestEnd("test_static_list");
+}
@@ -0,0 +1,119 @@
+/*
+ * test_stream.cpp
+ *
+ *      Streaming (streamBegin/streamPoint/streamEnd): points reach the DACs once and in order, underruns
+ *      paint blanked filler and are reported, and the list is refreshed again after streamEnd(), also when
+ *      a double buffer swap was still pending when streaming started.
+ */
+
+#include "XYscope.h"
+#include "XYscopeHal.h"
+#include "hostTest.h"
+
+XYscopeSized<2000> XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static uint32_t lit, outOfOrder;
+static int expectX = -1;
+
+static void sink(uint16_t x, uint16_t y, bool blanked, uint64_t) {
+	if (blanked || y != 1000)
+		return;
+	lit++;
+	if (expectX >= 0 && x != expectX)
+		outOfOrder++;
+	expectX = (x + 1) & 0xfff;
+}
+
+static int lows, highs, underruns;
+
+static void streamEvent(uint8_t event, int) {
+	if (event == XYscope::streamLowWater)
+		lows++;
+	else if (event == XYscope::streamHighWater)
+		highs++;
+	else
+		underruns++;
+}
+
+XYscope::pointList ring[1024];
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	XYscope.plotStart();
+	XYscope.plotCircle(2047, 2047, 500);
+	XYscope.waitForFrame(2);
+	xyHostSetSampleSink(sink);
+	XYscope.setStreamCallback(streamEvent, 128, 900);
+	XYscope.streamBegin(ring, 1024);
+
+	//Producer that keeps the ring full: every point is painted once, in order
+	int x = 0;
+	uint32_t sent = 0;
+	while (sent < 100000) {
+		if (XYscope.streamPoint(x, 1000)) {
+			x = (x + 1) & 0xfff;
+			sent++;
+		} else
+			xyHalIdle();
+	}
+	delay(5);
+	CHECK(XYscope.getStreamLevel() == 0);
+	CHECK(lit == sent);
+	CHECK(outOfOrder == 0);
+	CHECK(highs >= 1);
+	uint32_t under0 = XYscope.getStreamUnderruns();
+	CHECK(under0 >= 1);		//The delay() above ran the ring dry
+
+	//Bursts with gaps: one underrun (and one low watermark event) per gap, no points lost
+	for (int burst = 0; burst < 5; burst++) {
+		for (int i = 0; i < 500; i++) {
+			XYscope.streamPoint(x, 1000);
+			x = (x + 1) & 0xfff;
+			sent++;
+		}
+		delay(3);
+	}
+	CHECK(lit == sent);
+	CHECK(outOfOrder == 0);
+	CHECK(XYscope.getStreamUnderruns() == under0 + 5);
+	CHECK(underruns == int(XYscope.getStreamUnderruns()));
+	CHECK(lows >= 5);
+
+	//Back to list refresh
+	uint32_t f0 = XYscope.getFrameCount();
+	XYscope.streamEnd();
+	CHECK(!XYscope.streamPoint(0, 1000));
+	XYscope.waitForFrame(2);
+	CHECK(XYscope.getFrameCount() == f0 + 2);
+	xyHostSetSampleSink(NULL);
+
+	//present() pending at streamBegin(): the swap is applied there, and plotStart() does not wait while streaming
+	XYscope.setDoubleBuffer(true);
+	XYscope.plotStart();
+	XYscope.plotCircle(2047, 2047, 500);
+	XYscope.present();
+	XYscope.streamBegin(ring, 1024);
+	XYscope.plotStart();
+	XYscope.plotCircle(2047, 2047, 400);
+	XYscope.present();
+	XYscope.plotStart();
+	XYscope.plotCircle(2047, 2047, 300);
+	XYscope.present();
+	XYscope.streamEnd();
+	f0 = XYscope.getFrameCount();
+	XYscope.waitForFrame(2);
+	CHECK(XYscope.getFrameCount() == f0 + 2);
+	XYscope.plotStart();
+	XYscope.setDoubleBuffer(false);
+	return hostTestEnd("test_stream");
+}
@@ -0,0 +1,79 @@
+/*
+ * test_word_mode.cpp
+ *
+ *      Full-word DACC transfers (setFullWordMode): the same samples reach the DACs with half the PDC bus
+ *      transfers, for the list, pool objects and streaming.
+ */
+
+#include "XYscope.h"
+#include "hostTest.h"
+
+XYscope XYscope;
+
+void DACC_Handler(void) {
+	XYscope.dacHandler();
+}
+
+void paintCrt_ISR(void) {
+	XYscope.initiateDacDma();
+}
+
+static uint64_t signature;
+static uint32_t lit;
+
+static void sink(uint16_t x, uint16_t y, bool blanked, uint64_t) {
+	if (blanked)
+		return;
+	signature = signature * 31 + x * 4096 + y;		//Order matters
+	lit++;
+}
+
+static XYscope::pointList pool[500], ring[512];
+
+int main() {
+	hostTestBegin();
+	XYscope.begin(800000);
+	Timer3.attachInterrupt(paintCrt_ISR);
+	XYscope.plotStart();
+	XYscope.plotRectangle(100, 100, 3900, 3900);
+	XYscope.plotCircle(2047, 2047, 1500);
+	XYscope.setObjectPool(pool, 500);
+	int object = XYscope.objectNew(300);
+	XYscope.objectBegin(object);
+	XYscope.plotLine(0, 4000, 4000, 0);
+	XYscope.objectEnd();
+	XYscope.autoSetRefreshTime();
+	xyHostSetSampleSink(sink);
+
+	uint64_t frameSignature[2], transfers[2], conversions[2];
+	for (int mode = 0; mode < 2; mode++) {
+		XYscope.setFullWordMode(mode);
+		CHECK(XYscope.getFullWordMode() == (mode == 1));
+		XYscope.waitForFrame(1);
+		uint64_t t0 = xyHostGetStats().dmaTransfers, c0 = xyHostGetStats().conversions;
+		signature = 0;
+		lit = 0;
+		XYscope.waitForFrame(1);
+		frameSignature[mode] = signature;
+		transfers[mode] = xyHostGetStats().dmaTransfers - t0;
+		conversions[mode] = xyHostGetStats().conversions - c0;
+	}
+	CHECK(frameSignature[0] == frameSignature[1]);
+	CHECK(conversions[0] == conversions[1]);
+	CHECK(transfers[1] * 2 == transfers[0]);
+
+	//Streaming in word mode
+	XYscope.streamBegin(ring, 512);
+	lit = 0;
+	for (int i = 0; i < 20000;) {
+		if (XYscope.streamPoint(i % 4096, 1 + (i * 7) % 4095))
+			i++;
+		else
+			xyHostAdvanceUs(50);
+	}
+	xyHostAdvanceUs(2000);
+	CHECK(lit == 20000);
+	XYscope.streamEnd();
+	XYscope.setFullWordMode(false);
+	return hostTestEnd("test_word_mode");
+}